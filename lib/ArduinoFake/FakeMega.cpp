@@ -2,6 +2,7 @@
 
 #include <SimpleArduinoFake.h>
 #include <fakeNative.h>
+#include "SoftwareTimer.h"
 
 using namespace fakeit;
 
@@ -178,6 +179,24 @@ static void fakeMegaWiring(fakeit::Mock<SimpleArduinoFake::details::FunctionFake
     When(Method(mock, digitalPinToBitMask)).AlwaysDo([](uint8_t pin) -> uint8_t { return digital_pin_to_bit_mask[pin]; });
 }
 
+#if defined(NATIVE_VIRTUAL_TIME)
+static void fakeVirtualTime(fakeit::Mock<SimpleArduinoFake::details::FunctionFake> &mock)
+{
+    // Arduino time wraps at 32 bits
+    When(Method(mock, micros)).AlwaysDo([]() -> unsigned long { return (uint32_t)virtualMicros(); });
+    When(Method(mock, millis)).AlwaysDo([]() -> unsigned long { return (uint32_t)(virtualMicros()/1000U); });
+    When(Method(mock, delay)).AlwaysDo([](unsigned long ms) { advanceVirtualTime((uint64_t)ms*1000U); });
+    When(Method(mock, delayMicroseconds)).AlwaysDo([](unsigned int us) { advanceVirtualTime(us); });
+}
+#endif
+
+void fakeAnalogSource(int (*source)(uint8_t pin))
+{
+    static int (*analogSource)(uint8_t pin) = nullptr;
+    analogSource = source;
+    When(Method(SimpleArduinoFake::getContext()._Function, analogRead)).AlwaysDo([](uint8_t pin) -> int { return analogSource(pin); });
+}
+
 void fakeMega(std::ostream &oStream, std::istream &iStream)
 {
     SimpleArduinoFake::getContext().Reset();
@@ -187,6 +206,9 @@ void fakeMega(std::ostream &oStream, std::istream &iStream)
     ArduinoNativeFake::setupStreamFake(SimpleArduinoFake::getContext()._Stream, oStream, iStream);
     ArduinoNativeFake::setupSerialFake(SimpleArduinoFake::getContext()._Serial, oStream, iStream);
     fakeMegaWiring(SimpleArduinoFake::getContext()._Function);
+#if defined(NATIVE_VIRTUAL_TIME)
+    fakeVirtualTime(SimpleArduinoFake::getContext()._Function);
+#endif
 }
 
 #endif // defined(NATIVE_BOARD)
\ No newline at end of file
@@ -5,6 +5,14 @@
 #pragma once
 
 #include <iostream>
+#include <stdint.h>
 
 /** @brief Fake a Mega2560 */
 void fakeMega(std::ostream &oStream, std::istream &iStream);
+
+/** 
+ * @brief Route analogRead() to a simulated source, until the next fakeMega() call
+ * 
+ * @param source Returns the 10-bit ADC value for a pin
+ */
+void fakeAnalogSource(int (*source)(uint8_t pin));
@@ -5,6 +5,8 @@
 #include <map>
 #include "SoftwareTimer.h"
 
+#if !defined(NATIVE_VIRTUAL_TIME)
+
 namespace {
 
 inline std::chrono::microseconds getCurMicros(void)
@@ -130,6 +132,140 @@ software_timer_t::~software_timer_t()
     getTicker().unregisterCallback(tickCallbackId);
 }
 
+#else
+
+/** @brief A discrete event time source: time jumps from one timer compare match to the next */
+class VirtualTimeSource
+{
+public:
+
+    // Simplifies the conversions below
+    static_assert(software_timer_t::TIMER_RESOLUTION==1U, "Virtual time ticks must be 1uS");
+
+    /** @brief External access to the current tick */
+    software_timer_t::counter_t currentTick(void) const {
+        return (software_timer_t::counter_t)now_;
+    }
+
+    /** @brief Microseconds since start up */
+    uint64_t now(void) const {
+        return now_;
+    }
+
+    /** @brief Register a timer
+     * 
+     * @return uint16_t Timer id that can be passed to unregisterTimer
+     */
+    uint16_t registerTimer(software_timer_t *pTimer) {
+        uint16_t id = nextId_;
+        timers_[id] = pTimer;
+        ++nextId_;
+        return id;
+    }
+
+    /** @brief Remove a previously registered timer */
+    void unregisterTimer(uint16_t id) {
+        (void)timers_.erase(id);
+    }
+
+    /** @brief Fire the next timer compare match, if it is no later than limit
+     * 
+     * Timers that match at the same time fire in registration order.
+     * 
+     * @return true if a timer fired
+     */
+    bool runNextEvent(uint64_t limit) {
+        software_timer_t *pNext = nullptr;
+        uint64_t nextTime = limit;
+        for (const auto &timer : timers_) {
+            uint64_t matchTime;
+            if (getMatchTime(*timer.second, matchTime) && (matchTime<=nextTime) && ((pNext==nullptr) || (matchTime<nextTime))) {
+                pNext = timer.second;
+                nextTime = matchTime;
+            }
+        }
+        if (pNext==nullptr) {
+            return false;
+        }
+        setNow(nextTime);
+        pNext->lastMatchTime = now_;
+        pNext->lastMatchCompare = pNext->compare;
+        pNext->callback();
+        return true;
+    }
+
+    /** @brief Move time forward, firing every timer compare match on the way */
+    void advance(uint64_t micros) {
+        const uint64_t target = now_ + micros;
+        while (runNextEvent(target)) {
+            // Keep going
+        }
+        setNow(target);
+    }
+
+private:
+
+    // When will the timer next match? Like a hardware output compare, a match happens 
+    // when the counter *reaches* the compare value. So a compare value that has already
+    // passed will match when the counter wraps around.
+    bool getMatchTime(const software_timer_t &timer, uint64_t &matchTime) const {
+        if (!timer.enabled.load() || (timer.callback==nullptr)) {
+            return false;
+        }
+        uint64_t delta = (software_timer_t::counter_t)(timer.compare.load() - currentTick());
+        if ((delta==0U) && (timer.lastMatchTime==now_) && (timer.lastMatchCompare==timer.compare.load())) {
+            // Already fired at this time: next match is after a full counter cycle
+            delta = (uint64_t)std::numeric_limits<software_timer_t::counter_t>::max() + 1U;
+        }
+        matchTime = now_ + delta;
+        return true;
+    }
+
+    void setNow(uint64_t now) {
+        now_ = now;
+        for (const auto &timer : timers_) {
+            timer.second->counter = currentTick();
+        }
+    }
+
+    std::map<uint16_t, software_timer_t*> timers_;
+    uint16_t nextId_ = 0;
+    uint64_t now_ = 0U;
+};
+
+/// @brief  Our global time source
+static VirtualTimeSource& getTicker(void) {
+    static VirtualTimeSource theTicker;
+    return theTicker;
+}
+
+software_timer_t::software_timer_t()
+: counter(getTicker().currentTick())
+{
+    tickCallbackId = getTicker().registerTimer(this);
+}
+software_timer_t::~software_timer_t()
+{
+    getTicker().unregisterTimer(tickCallbackId);
+}
+
+uint64_t virtualMicros(void)
+{
+    return getTicker().now();
+}
+
+void advanceVirtualTime(uint64_t micros)
+{
+    getTicker().advance(micros);
+}
+
+bool runNextTimerEvent(uint64_t maxTime)
+{
+    return getTicker().runNextEvent(maxTime);
+}
+
+#endif
+
 void software_timer_t::setCallback(const callback_t &cb)
 {
     callback = cb;
@@ -144,6 +280,7 @@ void software_timer_t::disableTimer(void)
     enabled = false;
 }
 
+#if !defined(NATIVE_VIRTUAL_TIME)
 void software_timer_t::onNextTick(counter_t nextTick)
 {
     counter = nextTick; 
@@ -163,5 +300,14 @@ TickEventGuard::~TickEventGuard() noexcept
         getTicker().start();
     }
 }
+#else
+// Timers only fire when time is advanced, so there is nothing to halt
+TickEventGuard::TickEventGuard(void) noexcept
+{
+}
+TickEventGuard::~TickEventGuard() noexcept
+{
+}
+#endif
 
 #endif
\ No newline at end of file
@@ -25,7 +25,11 @@ public:
     void disableTimer(void);
 
     /** @brief Microseconds per tick */
+#if defined(NATIVE_VIRTUAL_TIME)
+    static constexpr uint32_t TIMER_RESOLUTION = 1UL;
+#else
     static constexpr uint32_t TIMER_RESOLUTION = 100UL;
+#endif
 
     static constexpr counter_t microsToTicks(unsigned long micros)
     {
@@ -42,9 +46,44 @@ private:
     uint16_t tickCallbackId;
     std::atomic<bool> enabled = {false};
 
+#if !defined(NATIVE_VIRTUAL_TIME)
     void onNextTick(counter_t nextTick);
+#else
+    friend class VirtualTimeSource;
+    // The last compare match: a match fires once, not on every tick
+    uint64_t lastMatchTime = std::numeric_limits<uint64_t>::max();
+    counter_t lastMatchCompare = 0U;
+#endif
 };
 
+#if defined(NATIVE_VIRTUAL_TIME)
+/**
+ * @brief Virtual time
+ * 
+ * There is no ticker thread: time only moves when it is advanced. It then jumps
+ * straight to the next timer compare match, fires the timer callback & repeats.
+ * So simulations are deterministic, have 1µS resolution & run much faster than 
+ * real time.
+ * 
+ * micros(), millis(), delay() & delayMicroseconds() use virtual time (see fakeMega()).
+ * A busy wait for a timer driven condition must call runNextTimerEvent().
+ */
+
+/** @brief Microseconds since start up */
+uint64_t virtualMicros(void);
+
+/** @brief Move time forward, firing every timer compare match on the way in time order */
+void advanceVirtualTime(uint64_t micros);
+
+/** 
+ * @brief Move time forward to the next timer compare match & fire the timer
+ * 
+ * @param maxTime Only fire a match at or before this time (µS since start up)
+ * @return false if there is no such match: time does not move
+ */
+bool runNextTimerEvent(uint64_t maxTime = std::numeric_limits<uint64_t>::max());
+#endif
+
 /** @brief An RAII class to start/stop tick event generation */
 class TickEventGuard
 {
@@ -114,10 +114,10 @@ constexpr char header_95[] PROGMEM = "PW6";
 constexpr char header_96[] PROGMEM = "PW7";
 constexpr char header_97[] PROGMEM = "PW8";
 constexpr char header_98[] PROGMEM = "System Temp";
+constexpr char header_99[] PROGMEM = "Task Deadline Misses";
+constexpr char header_100[] PROGMEM = "Atomic Max Time";
+constexpr char header_101[] PROGMEM = "Atomic Max Site";
 /*
-constexpr char header_99[] PROGMEM = "";
-constexpr char header_100[] PROGMEM = "";
-constexpr char header_101[] PROGMEM = "";
 constexpr char header_102[] PROGMEM = "";
 constexpr char header_103[] PROGMEM = "";
 constexpr char header_104[] PROGMEM = "";
@@ -239,10 +239,10 @@ constexpr const char* header_table[] PROGMEM = {  header_0,\
                                               header_96,\
                                               header_97,\
                                               header_98,\
-                                              /*
                                               header_99,\
                                               header_100,\
                                               header_101,\
+                                              /*
                                               header_102,\
                                               header_103,\
                                               header_104,\
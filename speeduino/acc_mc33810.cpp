@@ -10,11 +10,15 @@ static uint8_t MC33810_BIT_IGN[_countof(pinNumbers_t::mc33810IgnBits)] = {};
 
 static constexpr uint8_t MC33810_ONOFF_CMD = 0x30; //48 in decimal
 
+//Nesting depth of beginBatch_MC33810() calls. While >0, output changes are deferred
+static volatile uint8_t batchDepth = 0U;
+
 struct mc33810_t
 {
     fastOutputPin_t pin;
-    volatile uint8_t requestedState; //Current binary state of the 2nd ICs IGN and INJ values
-    volatile uint8_t returnState; //Current binary state of the 1st ICs IGN and INJ values
+    volatile uint8_t requestedState; //Shadow register: the IGN and INJ values we want
+    volatile uint8_t returnState; //Current binary state of the ICs IGN and INJ values
+    volatile bool isDirty; //requestedState has changed since the last write to the IC
 
     void init(uint8_t pinNumber)
     {
@@ -23,20 +27,35 @@ struct mc33810_t
         //Set the output states to be off to fuel and ignition
         requestedState = 0;
         returnState = 0;
+        isDirty = false;
     }
 
     uint8_t sendCommand(uint16_t command);
+
+    //Write the shadow register to the IC
+    void flush(void)
+    {
+        isDirty = false;
+        returnState = sendCommand(word(MC33810_ONOFF_CMD, requestedState));
+    }
+
+    //Write the shadow register now, or mark it for writing at the end of the batch
+    void update(void)
+    {
+        if (batchDepth==0U) { flush(); }
+        else { isDirty = true; }
+    }
     
     void setBit(uint8_t bit)
     {
         BIT_SET(requestedState, bit); 
-        returnState = sendCommand(word(MC33810_ONOFF_CMD, requestedState));        
+        update();
     }
     
     void clearBit(uint8_t bit)
     {
         BIT_CLEAR(requestedState, bit); 
-        returnState = sendCommand(word(MC33810_ONOFF_CMD, requestedState));        
+        update();
     }
 };
 
@@ -166,4 +185,19 @@ void coilStopCharging_MC33810(uint8_t channel)
 {
     coilDischargingFn(channel);
 }
+
+void beginBatch_MC33810(void)
+{
+    ++batchDepth;
+}
+
+void endBatch_MC33810(void)
+{
+    if (batchDepth>0U) { --batchDepth; }
+    if (batchDepth==0U)
+    {
+        if (mc33810_1.isDirty) { mc33810_1.flush(); }
+        if (mc33810_2.isDirty) { mc33810_2.flush(); }
+    }
+}
 #endif
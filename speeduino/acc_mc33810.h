@@ -14,6 +14,35 @@ void closeInjector_MC33810(uint8_t channel);
 void coilCharging_MC33810(uint8_t channel);
 void coilStopCharging_MC33810(uint8_t channel);
 
+/**
+ * @brief Start coalescing MC33810 output changes.
+ *
+ * Until the matching endBatch_MC33810() call, output changes only update the shadow
+ * registers. Each IC with pending changes then gets a single SPI write. I.e. 2 coincident
+ * events (E.g. paired injection or wasted COP) cost 1 SPI transfer and switch together.
+ * Batches can be nested: only the outermost endBatch_MC33810() writes to the ICs.
+ */
+void beginBatch_MC33810(void);
+/** @brief End a batch started by beginBatch_MC33810(), writing any pending changes */
+void endBatch_MC33810(void);
+
+/** @brief RAII wrapper for beginBatch_MC33810()/endBatch_MC33810() */
+struct mc33810_batch_t
+{
+    mc33810_batch_t(void) { beginBatch_MC33810(); }
+    ~mc33810_batch_t(void) { endBatch_MC33810(); }
+    mc33810_batch_t(const mc33810_batch_t&) = delete;
+    mc33810_batch_t& operator=(const mc33810_batch_t&) = delete;
+};
+
+#else
+
+/** @brief No MC33810 support, so no batching required */
+struct mc33810_batch_t
+{
+    mc33810_batch_t(void) { }
+};
+
 #endif
 
 #endif
\ No newline at end of file
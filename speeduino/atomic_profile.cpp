@@ -0,0 +1,43 @@
+#include "atomic_profile.h"
+
+#if defined(ATOMIC_PROFILING)
+
+// Only written with interrupts disabled
+static atomicProfile_t atomicProfile;
+
+void recordAtomicSection(atomicSite_t site, uint32_t duration)
+{
+  if (duration > atomicProfile.maxDuration)
+  {
+    atomicProfile.maxDuration = (uint16_t)(duration > UINT16_MAX ? UINT16_MAX : duration);
+    atomicProfile.maxSite = site;
+  }
+}
+
+atomicProfile_t getAtomicProfile(void)
+{
+  ATOMIC() {
+    return atomicProfile;
+  }
+  return atomicProfile; // Never reached, just to avoid compiler warning
+}
+
+void resetAtomicProfile(void)
+{
+  ATOMIC() {
+    atomicProfile = atomicProfile_t{ 0U, ATOMIC_SITE_NONE };
+  }
+}
+
+#else
+
+atomicProfile_t getAtomicProfile(void)
+{
+  return atomicProfile_t{ 0U, ATOMIC_SITE_NONE };
+}
+
+void resetAtomicProfile(void)
+{
+}
+
+#endif
@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Opt-in profiling of the time spent with interrupts disabled.
+ *
+ * Define ATOMIC_PROFILING to enable. Each ATOMIC_PROFILED(site) block is timed & the longest
+ * block seen is recorded along with its call site. The result is sent as live data, so the
+ * worst case interrupt latency added by the firmware can be tracked down from a log.
+ *
+ * Without ATOMIC_PROFILING, ATOMIC_PROFILED(site) is exactly ATOMIC() & there is no overhead.
+ *
+ * @note The timing uses micros(), so the resolution is that of micros() on the board (4µS on AVR).
+ */
+
+#include <stdint.h>
+#include "atomic.h"
+
+/** @brief Identifies the code that disabled interrupts. Sent as live data, so only add to the end. */
+enum atomicSite_t : uint8_t {
+  ATOMIC_SITE_NONE = 0U,        ///< No section has been recorded
+  ATOMIC_SITE_SCHEDULE,         ///< Setting or adjusting a fuel or ignition schedule
+  ATOMIC_SITE_SCHEDULE_MODE,    ///< Switching the fuel or ignition schedules between sequential & paired modes
+  ATOMIC_SITE_OVERDWELL,        ///< Ignition overdwell protection
+  ATOMIC_SITE_TIMER_MASK,       ///< Reading the main loop timer bits
+  ATOMIC_SITE_DECODER,          ///< Reading the decoder state
+  ATOMIC_SITE_SENSORS,          ///< Reading sensor values written by interrupts
+  ATOMIC_SITE_STATUS,           ///< Updating currentStatus fields read by interrupts
+  ATOMIC_SITE_AUX_PWM,          ///< Software PWM channel updates
+  ATOMIC_SITE_AUX_OUTPUTS,      ///< Fan & air conditioning outputs
+};
+
+/** @brief The longest interrupts disabled section recorded */
+struct atomicProfile_t {
+  uint16_t maxDuration;   ///< µS, saturates at UINT16_MAX
+  atomicSite_t maxSite;   ///< Where the section was
+};
+
+#if defined(ATOMIC_PROFILING)
+
+/**
+ * @brief Record a completed interrupts disabled section.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param site The call site
+ * @param duration Time spent in the section, µS
+ */
+void recordAtomicSection(atomicSite_t site, uint32_t duration);
+
+/** @brief Times a section from construction to destruction. Used by ATOMIC_PROFILED() */
+class atomicSectionTimer_t {
+public:
+  explicit atomicSectionTimer_t(atomicSite_t site) noexcept
+  : _start(micros()), _site(site), _pending(true)
+  {
+  }
+  // Runs on any exit from the section (E.g. a return), before interrupts are re-enabled
+  ~atomicSectionTimer_t() noexcept
+  {
+    recordAtomicSection(_site, micros() - _start);
+  }
+  bool isPending(void) const noexcept { return _pending; }
+  void finish(void) noexcept { _pending = false; }
+
+private:
+  uint32_t _start;
+  atomicSite_t _site;
+  bool _pending;
+};
+
+/** @brief As ATOMIC(), but the time spent in the block is profiled against the call site */
+#define ATOMIC_PROFILED(site) \
+    ATOMIC() \
+    for (atomicSectionTimer_t atomicTimer(site); atomicTimer.isPending(); atomicTimer.finish())
+
+#else
+
+#define ATOMIC_PROFILED(site) ATOMIC()
+
+#endif
+
+/** @brief The longest interrupts disabled section since the last reset. Always zero without ATOMIC_PROFILING. */
+atomicProfile_t getAtomicProfile(void);
+
+/** @brief Clear the recorded profile */
+void resetAtomicProfile(void);
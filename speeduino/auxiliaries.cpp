@@ -58,7 +58,7 @@ static __attribute__((optimize("Os"))) void initialiseVvtPins(uint8_t pin1, uint
 static void setVvtPidTunings(integerPID &pid, const config10 &page10, bool isReverse)
 {
   int8_t multiplier = isReverse ? 1 : -1;
-  pid.setTunings(PidTuningParameters(page10.vvtCLKP, page10.vvtCLKI, page10.vvtCLKD) * multiplier, millis(), 33);
+  pid.setTunings(PidTuningParameters(page10.vvtCLKP, page10.vvtCLKI, page10.vvtCLKD) * multiplier, millis(), VVT_CONTROL_INTERVAL_MS);
 }
 
 static void initialiseVvtPid(integerPID &pid, const config10 &page10, bool isReverse, int16_t currentAngle)
@@ -68,6 +68,38 @@ static void initialiseVvtPid(integerPID &pid, const config10 &page10, bool isRev
   pid.activate(currentAngle); //Turn PID on
 }
 
+/** @brief true if vvtInterrupt() drives the VVT outputs low for the duty
+ * 
+ * On Teensy 4.1 the PIT timers count down & have the opposite effect on PWM. Hardware PWM uses the
+ * same polarity, so the output is the same whether or not the pin has hardware PWM. (The tune has no
+ * output polarity for VVT: vvtPWMdir & vvt2PWMdir only reverse the PID)
+ */
+TESTABLE_INLINE_STATIC bool isVvtPwmActiveLow(void)
+{
+#if defined(CORE_TEENSY41)
+  return true;
+#else
+  return false;
+#endif
+}
+
+#if defined(AUX_PWM_CHANNELS)
+static uint16_t getVvt1PwmDuty(void) { return (uint16_t)vvt1_pwm_value; }
+static uint16_t getVvt2PwmDuty(void) { return (uint16_t)vvt2_pwm_value; }
+
+static void configureVvtPwm(void)
+{
+  configureAuxPwm(AUX_PWM_VVT1, { vvt1On, vvt1Off, getVvt1PwmDuty }, vvt_pwm_max_count);
+  configureAuxPwm(AUX_PWM_VVT2, { vvt2On, vvt2Off, getVvt2PwmDuty }, vvt_pwm_max_count);
+#if defined(HW_AUX_PWM)
+  (void)setAuxPwmPin(AUX_PWM_VVT1, pinNumbers.pinVVT_1, isVvtPwmActiveLow());
+  (void)setAuxPwmPin(AUX_PWM_VVT2, pinNumbers.pinVVT_2, isVvtPwmActiveLow());
+#endif
+}
+#else
+static inline void configureVvtPwm(void) { }
+#endif
+
 void __attribute__((optimize("Os"))) initialiseAuxPWM(void)
 {
   initialiseVvtPins(pinNumbers.pinVVT_1, pinNumbers.pinVVT_2);
@@ -77,6 +109,7 @@ void __attribute__((optimize("Os"))) initialiseAuxPWM(void)
     currentStatus.vvt1Angle = 0;
     currentStatus.vvt2Angle = 0;
     vvt_pwm_max_count = pwmFreqToTicks(FREQUENCY.toUser(configPage6.vvtFreq));
+    configureVvtPwm();
 
     if(configPage6.vvtMode == VVT_MODE_CLOSED_LOOP)
     {
@@ -100,6 +133,7 @@ void __attribute__((optimize("Os"))) initialiseAuxPWM(void)
   {
     // config wmi pwm output to use vvt output
     vvt_pwm_max_count = pwmFreqToTicks(FREQUENCY.toUser(configPage6.vvtFreq));
+    configureVvtPwm();
     currentStatus.wmiTankEmpty = false;
     currentStatus.wmiPW = 0;
     vvt1_pwm_value = 0;
@@ -202,7 +236,7 @@ void vvtControl(void)
           //If not already at target angle, calculate new value from PID
           int32_t pidOutput = 0;
           vvtPID.setSetPoint(currentStatus.vvt1TargetAngle);
-          bool PID_compute = vvtPID.compute(millis(), currentStatus.vvt1Angle, &pidOutput);
+          bool PID_compute = vvtPID.compute(currentStatus.vvt1Angle, &pidOutput);
           if(PID_compute == true) 
           { 
             currentStatus.vvt1Duty = (uint8_t)pidOutput;
@@ -241,7 +275,7 @@ void vvtControl(void)
             vvt2PID.setSetPoint(currentStatus.vvt2TargetAngle);
             //If not already at target angle, calculate new value from PID
             int32_t pidOutput = 0;
-            bool PID_compute = vvt2PID.compute(millis(), currentStatus.vvt2Angle, &pidOutput);
+            bool PID_compute = vvt2PID.compute(currentStatus.vvt2Angle, &pidOutput);
             if(PID_compute == true) 
             { 
               currentStatus.vvt2Duty = (uint8_t)pidOutput;
@@ -403,6 +437,12 @@ void wmiControl(void)
   }
 }
 
+#if !defined(SOFT_PWM_ENGINE)
+static inline void vvt1DutyStart(void) { if (isVvtPwmActiveLow()) { vvt1Off(); } else { vvt1On(); } }
+static inline void vvt1DutyEnd(void) { if (isVvtPwmActiveLow()) { vvt1On(); } else { vvt1Off(); } }
+static inline void vvt2DutyStart(void) { if (isVvtPwmActiveLow()) { vvt2Off(); } else { vvt2On(); } }
+static inline void vvt2DutyEnd(void) { if (isVvtPwmActiveLow()) { vvt2On(); } else { vvt2Off(); } }
+
 //The interrupt to control the VVT PWM
 void vvtInterrupt(void)
 {
@@ -410,20 +450,12 @@ void vvtInterrupt(void)
   {
     if( (vvt1_pwm_value > 0) && (vvt1_max_pwm == false) ) //Don't toggle if at 0%
     {
-      #if defined(CORE_TEENSY41)
-      vvt1Off();
-      #else
-      vvt1On();
-      #endif
+      vvt1DutyStart();
       vvt1_pwm_state = true;
     }
     if( (vvt2_pwm_value > 0) && (vvt2_max_pwm == false) ) //Don't toggle if at 0%
     {
-      #if defined(CORE_TEENSY41)
-      vvt2Off();
-      #else
-      vvt2On();
-      #endif
+      vvt2DutyStart();
       vvt2_pwm_state = true;
     }
 
@@ -450,11 +482,7 @@ void vvtInterrupt(void)
     {
       if(vvt1_pwm_value < (long)vvt_pwm_max_count) //Don't toggle if at 100%
       {
-        #if defined(CORE_TEENSY41)
-        vvt1On();
-        #else
-        vvt1Off();
-        #endif
+        vvt1DutyEnd();
         vvt1_pwm_state = false;
         vvt1_max_pwm = false;
       }
@@ -471,11 +499,7 @@ void vvtInterrupt(void)
     {
       if(vvt2_pwm_value < (long)vvt_pwm_max_count) //Don't toggle if at 100%
       {
-        #if defined(CORE_TEENSY41)
-        vvt2On();
-        #else
-        vvt2Off();
-        #endif
+        vvt2DutyEnd();
         vvt2_pwm_state = false;
         vvt2_max_pwm = false;
       }
@@ -492,11 +516,7 @@ void vvtInterrupt(void)
     {
       if(vvt1_pwm_value < (long)vvt_pwm_max_count) //Don't toggle if at 100%
       {
-       #if defined(CORE_TEENSY41)
-        vvt1On();
-        #else
-        vvt1Off();
-        #endif
+        vvt1DutyEnd();
         vvt1_pwm_state = false;
         vvt1_max_pwm = false;
         SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + (vvt_pwm_max_count - vvt1_pwm_cur_value) );
@@ -504,11 +524,7 @@ void vvtInterrupt(void)
       else { vvt1_max_pwm = true; }
       if(vvt2_pwm_value < (long)vvt_pwm_max_count) //Don't toggle if at 100%
       {
-        #if defined(CORE_TEENSY41)
-        vvt2On();
-        #else
-        vvt2Off();
-        #endif
+        vvt2DutyEnd();
         vvt2_pwm_state = false;
         vvt2_max_pwm = false;
         SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + (vvt_pwm_max_count - vvt2_pwm_cur_value) );
@@ -516,4 +532,5 @@ void vvtInterrupt(void)
       else { vvt2_max_pwm = true; }
     }
   }
-}
\ No newline at end of file
+}
+#endif
@@ -1,6 +1,11 @@
 #ifndef AUX_H
 #define AUX_H
 
+#include <stdint.h>
+
+/** @brief vvtControl() must be run at this fixed interval (in milliseconds). It is the VVT PID sample period. */
+constexpr uint8_t VVT_CONTROL_INTERVAL_MS = 33U;
+
 void initialiseAuxPWM(void);
 void vvtControl(void);
 
@@ -116,10 +116,12 @@ IGNITION_INTERRUPT(7, TIMER3_COMPC_vect)
 IGNITION_INTERRUPT(8, TIMER3_COMPB_vect)
 #endif
 
+#if !defined(SOFT_PWM_ENGINE)
 ISR(TIMER1_COMPC_vect) //cppcheck-suppress misra-c2012-8.2
 {
   idleInterrupt();
 }
+#endif
 
 //Timer2 Overflow Interrupt Vector, called when the timer overflows.
 //Executes every ~1ms.
@@ -129,6 +131,13 @@ ISR(TIMER2_OVF_vect, ISR_NOBLOCK) //cppcheck-suppress misra-c2012-8.2
   oneMSInterval();
 }
 
+#if defined(SOFT_PWM_ENGINE)
+//The interrupt for all auxiliary PWM outputs
+ISR(TIMER1_COMPA_vect) //cppcheck-suppress misra-c2012-8.2
+{
+  auxPwmInterrupt();
+}
+#else
 //The interrupt to control the Boost PWM
 ISR(TIMER1_COMPA_vect) //cppcheck-suppress misra-c2012-8.2
 {
@@ -139,6 +148,7 @@ ISR(TIMER1_COMPB_vect) //cppcheck-suppress misra-c2012-8.2
 {
   vvtInterrupt();
 }
+#endif
 
 void initBoard(uint32_t baudRate)
 {
@@ -144,6 +144,15 @@ static inline void IGN8_TIMER_DISABLE(void) { TIMSK3 &= ~(1 << OCIE3B); } //Repl
 ***********************************************************************************************************
 * Auxiliaries
 */
+#if defined(SOFT_PWM_ENGINE)
+//All auxiliary PWM outputs (including the fan) are driven by the software PWM engine from Timer1 channel A.
+//Timer1 channels B & C are unused.
+#define ENABLE_SOFT_PWM_TIMER()  TIMSK1 |= (1 << OCIE1A)
+#define DISABLE_SOFT_PWM_TIMER() TIMSK1 &= ~(1 << OCIE1A)
+#define SOFT_PWM_TIMER_COMPARE   OCR1A
+#define SOFT_PWM_TIMER_COUNTER   TCNT1
+#define PWM_FAN_AVAILABLE
+#else
 #define ENABLE_BOOST_TIMER()  TIMSK1 |= (1 << OCIE1A)
 #define DISABLE_BOOST_TIMER() TIMSK1 &= ~(1 << OCIE1A)
 #define ENABLE_VVT_TIMER()    TIMSK1 |= (1 << OCIE1B)
@@ -163,6 +172,7 @@ static inline void IGN8_TIMER_DISABLE(void) { TIMSK3 &= ~(1 << OCIE3B); } //Repl
 
 #define IDLE_TIMER_ENABLE() TIMSK1 |= (1 << OCIE1C)
 #define IDLE_TIMER_DISABLE() TIMSK1 &= ~(1 << OCIE1C)
+#endif
 
 /*
 ***********************************************************************************************************
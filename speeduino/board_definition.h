@@ -85,6 +85,28 @@ void boardInitRTC(void);
 // The compare variables type can be wider than the timer overflow.
 #define SET_COMPARE(compare, value) (compare) = (COMPARE_TYPE)(value)
 
+#if defined(SOFT_PWM_ENGINE) && defined(HW_AUX_PWM)
+#error "SOFT_PWM_ENGINE and HW_AUX_PWM are mutually exclusive"
+#endif
+
+#if defined(SOFT_PWM_ENGINE) || defined(HW_AUX_PWM)
+// The auxiliary PWM outputs are driven as channels (see softPwm.h), either by the software
+// PWM engine from a single timer compare channel or by the board's hardware PWM.
+#define AUX_PWM_CHANNELS
+#if defined(SOFT_PWM_ENGINE) && !defined(SOFT_PWM_TIMER_COMPARE)
+#error "SOFT_PWM_ENGINE is not supported on this board"
+#endif
+#include "softPwm.h"
+#define ENABLE_BOOST_TIMER()  enableAuxPwm(AUX_PWM_BIT(AUX_PWM_BOOST))
+#define DISABLE_BOOST_TIMER() disableAuxPwm(AUX_PWM_BIT(AUX_PWM_BOOST))
+#define ENABLE_VVT_TIMER()    enableAuxPwm(AUX_PWM_BIT(AUX_PWM_VVT1) | AUX_PWM_BIT(AUX_PWM_VVT2))
+#define DISABLE_VVT_TIMER()   disableAuxPwm(AUX_PWM_BIT(AUX_PWM_VVT1) | AUX_PWM_BIT(AUX_PWM_VVT2))
+#define IDLE_TIMER_ENABLE()   enableAuxPwm(AUX_PWM_BIT(AUX_PWM_IDLE))
+#define IDLE_TIMER_DISABLE()  disableAuxPwm(AUX_PWM_BIT(AUX_PWM_IDLE))
+#define ENABLE_FAN_TIMER()    enableAuxPwm(AUX_PWM_BIT(AUX_PWM_FAN))
+#define DISABLE_FAN_TIMER()   disableAuxPwm(AUX_PWM_BIT(AUX_PWM_FAN))
+#endif
+
 /** @brief The longest period of time (in uS) that the timer can permit */
 constexpr uint32_t MAX_TIMER_PERIOD = ticksToMicros((numeric_limits<COMPARE_TYPE>::max)());
 
@@ -66,17 +66,25 @@ IGNITION_INTERRUPT(8)
 
 std::array<software_timer_t, INJ_CHANNELS> fuelTimers;
 std::array<software_timer_t, IGN_CHANNELS> ignitionTimers;
+#if defined(SOFT_PWM_ENGINE)
+software_timer_t softPwmTimer;
+#else
 software_timer_t boostTimer;
 software_timer_t vvtTimer;
 software_timer_t fanTimer;
 software_timer_t idleTimer;
+#endif
 software_timer_t oneMSTimer;
 
 void initBoard(uint32_t /*baudRate*/) {
+#if defined(SOFT_PWM_ENGINE)
+    softPwmTimer.setCallback(auxPwmInterrupt);
+#else
     idleTimer.setCallback(idleInterrupt);
     fanTimer.setCallback(fanInterrupt);
     boostTimer.setCallback(boostInterrupt);
     vvtTimer.setCallback(vvtInterrupt);
+#endif
     oneMSTimer.setCallback(oneMSInterval);
 
     fuelTimers[0].setCallback(FUEL_INTERRUPT_NAME(1));
@@ -109,6 +109,13 @@ DEFINE_TIMER_VARS(IGN, 8, ignitionTimers)
 * Auxiliaries
 */
 
+#if defined(SOFT_PWM_ENGINE)
+extern software_timer_t softPwmTimer;
+#define ENABLE_SOFT_PWM_TIMER()  softPwmTimer.enableTimer()
+#define DISABLE_SOFT_PWM_TIMER() softPwmTimer.disableTimer()
+#define SOFT_PWM_TIMER_COMPARE   softPwmTimer.compare
+#define SOFT_PWM_TIMER_COUNTER   softPwmTimer.counter
+#else
 extern software_timer_t boostTimer;
 #define ENABLE_BOOST_TIMER()  boostTimer.enableTimer()
 #define DISABLE_BOOST_TIMER() boostTimer.disableTimer()
@@ -136,6 +143,7 @@ extern software_timer_t idleTimer;
 #define IDLE_TIMER_DISABLE() idleTimer.disableTimer()
 #define IDLE_COUNTER   idleTimer.counter
 #define IDLE_COMPARE   idleTimer.compare
+#endif
 
 #define ATOMIC() \
     for ( \
@@ -69,10 +69,63 @@ extern "C" void SystemClock_Config(void)
       SPIClass SPI_for_flash(PB15, PB14, PB13);
     #endif
  
+  #if defined(SPI_FLASH_LOG)
+    // winbond W25Q16 SPI flash as a wear levelled log. 16 regions of 3 x 4K sectors, starting at 1MB.
+    // The 8K image leaves room for A/B page slots (see storage.cpp)
+    #include "src/FlashLog/FlashLog.h"
+    static winbondFlashSPI logFlash;
+    static bool isLogFlashAvailable = false;
+
+    static bool startLogFlash(void)
+    {
+      if (!isLogFlashAvailable)
+      {
+        SPISettings settings(22500000, MSBFIRST, SPI_MODE0);
+        SPI_for_flash.beginTransaction(settings);
+        pinMode(USE_SPI_EEPROM, OUTPUT);
+        isLogFlashAvailable = logFlash.begin(winbondFlashClass::partNumber::autoDetect, SPI_for_flash, USE_SPI_EEPROM);
+      }
+      return isLogFlashAvailable;
+    }
+    static bool readLogFlash(uint32_t address, uint8_t *pBuffer, uint16_t length)
+    {
+      if (!startLogFlash()) { return false; }
+      while(logFlash.busy()) { }
+      (void)logFlash.read(address, pBuffer, length);
+      return true;
+    }
+    static bool programLogFlash(uint32_t address, const uint8_t *pBuffer, uint16_t length)
+    {
+      if (!startLogFlash()) { return false; }
+      // A page program cannot cross a 256 byte flash page boundary
+      while (length>0U)
+      {
+        uint16_t chunk = (uint16_t)min((uint32_t)length, 256UL - (address % 256UL));
+        logFlash.setWriteEnable(true);
+        logFlash.writePage(address, (uint8_t*)pBuffer, chunk);
+        while(logFlash.busy()) { }
+        address = address + chunk;
+        pBuffer = pBuffer + chunk;
+        length = length - chunk;
+      }
+      return true;
+    }
+    static bool eraseLogFlash(uint32_t address)
+    {
+      if (!startLogFlash()) { return false; }
+      logFlash.setWriteEnable(true);
+      logFlash.eraseSector(address);
+      while(logFlash.busy()) { }
+      return true;
+    }
+    static const flash_log_device_t logFlashDevice = { readLogFlash, programLogFlash, eraseLogFlash, 0x00100000UL, 4096UL, 3U, 16U };
+    FlashLogAsEEPROM<8192U> EEPROM(logFlashDevice);
+  #else
     //winbond W25Q16 SPI flash EEPROM emulation
     EEPROM_Emulation_Config EmulatedEEPROMMconfig{255UL, 4096UL, 31, 0x00100000UL};
     Flash_SPI_Config SPIconfig{USE_SPI_EEPROM, SPI_for_flash};
     SPI_EEPROM_Class EEPROM(EmulatedEEPROMMconfig, SPIconfig);
+  #endif
 #elif defined(FRAM_AS_EEPROM) // Use FRAM like FM25xxx, MB85RSxxx or any SPI compatible
   #include "src/FRAM/Fram.h"
   #if defined(STM32F407xx)
@@ -288,13 +341,24 @@ STM32RTC& rtc = STM32RTC::getInstance();
     ***********************************************************************************************************
     * Schedules
     */
-    Timer1.setOverflow((numeric_limits<COMPARE_TYPE>::max)(), TICK_FORMAT);
+    Timer1.setOverflow((numeric_limits<uint16_t>::max)(), TICK_FORMAT);
+    Timer1.setPrescaleFactor(((Timer1.getTimerClkFreq()/1000000) * TIMER_RESOLUTION)-1);   //4us resolution
+
+    #if defined(SCHEDULE_TIMERS_32BIT)
+    HardwareTimer &fuelTimer1to4 = Timer5;
+    //Free running over the full 32 bits, so no overflow handling is needed
+    Timer2.setPrescaleFactor(((Timer2.getTimerClkFreq()/1000000) / SCHEDULE_TICKS_PER_US)-1);   //0.25us resolution
+    Timer5.setPrescaleFactor(((Timer5.getTimerClkFreq()/1000000) / SCHEDULE_TICKS_PER_US)-1);   //0.25us resolution
+    LL_TIM_SetAutoReload(TIM2, (numeric_limits<COMPARE_TYPE>::max)());
+    LL_TIM_SetAutoReload(TIM5, (numeric_limits<COMPARE_TYPE>::max)());
+    #else
+    HardwareTimer &fuelTimer1to4 = Timer3;
     Timer2.setOverflow((numeric_limits<COMPARE_TYPE>::max)(), TICK_FORMAT);
     Timer3.setOverflow((numeric_limits<COMPARE_TYPE>::max)(), TICK_FORMAT);
 
-    Timer1.setPrescaleFactor(((Timer1.getTimerClkFreq()/1000000) * TIMER_RESOLUTION)-1);   //4us resolution
     Timer2.setPrescaleFactor(((Timer2.getTimerClkFreq()/1000000) * TIMER_RESOLUTION)-1);   //4us resolution
     Timer3.setPrescaleFactor(((Timer3.getTimerClkFreq()/1000000) * TIMER_RESOLUTION)-1);   //4us resolution
+    #endif
 
     #if ( STM32_CORE_VERSION_MAJOR < 2 )
     Timer2.setMode(1, TIMER_OUTPUT_COMPARE);
@@ -302,32 +366,32 @@ STM32RTC& rtc = STM32RTC::getInstance();
     Timer2.setMode(3, TIMER_OUTPUT_COMPARE);
     Timer2.setMode(4, TIMER_OUTPUT_COMPARE);
 
-    Timer3.setMode(1, TIMER_OUTPUT_COMPARE);
-    Timer3.setMode(2, TIMER_OUTPUT_COMPARE);
-    Timer3.setMode(3, TIMER_OUTPUT_COMPARE);
-    Timer3.setMode(4, TIMER_OUTPUT_COMPARE);
+    fuelTimer1to4.setMode(1, TIMER_OUTPUT_COMPARE);
+    fuelTimer1to4.setMode(2, TIMER_OUTPUT_COMPARE);
+    fuelTimer1to4.setMode(3, TIMER_OUTPUT_COMPARE);
+    fuelTimer1to4.setMode(4, TIMER_OUTPUT_COMPARE);
     #else //2.0 forward
     Timer2.setMode(1, TIMER_OUTPUT_COMPARE_TOGGLE);
     Timer2.setMode(2, TIMER_OUTPUT_COMPARE_TOGGLE);
     Timer2.setMode(3, TIMER_OUTPUT_COMPARE_TOGGLE);
     Timer2.setMode(4, TIMER_OUTPUT_COMPARE_TOGGLE);
 
-    Timer3.setMode(1, TIMER_OUTPUT_COMPARE_TOGGLE);
-    Timer3.setMode(2, TIMER_OUTPUT_COMPARE_TOGGLE);
-    Timer3.setMode(3, TIMER_OUTPUT_COMPARE_TOGGLE);
-    Timer3.setMode(4, TIMER_OUTPUT_COMPARE_TOGGLE);
+    fuelTimer1to4.setMode(1, TIMER_OUTPUT_COMPARE_TOGGLE);
+    fuelTimer1to4.setMode(2, TIMER_OUTPUT_COMPARE_TOGGLE);
+    fuelTimer1to4.setMode(3, TIMER_OUTPUT_COMPARE_TOGGLE);
+    fuelTimer1to4.setMode(4, TIMER_OUTPUT_COMPARE_TOGGLE);
     #endif
     //Attach interrupt functions
     //Injection
-    Timer3.attachInterrupt(1, FUEL_INTERRUPT_NAME(1));
+    fuelTimer1to4.attachInterrupt(1, FUEL_INTERRUPT_NAME(1));
     #if (INJ_CHANNELS >= 2)
-    Timer3.attachInterrupt(2, FUEL_INTERRUPT_NAME(2));
+    fuelTimer1to4.attachInterrupt(2, FUEL_INTERRUPT_NAME(2));
     #endif
     #if (INJ_CHANNELS >= 3)
-    Timer3.attachInterrupt(3, FUEL_INTERRUPT_NAME(3));
+    fuelTimer1to4.attachInterrupt(3, FUEL_INTERRUPT_NAME(3));
     #endif
     #if (INJ_CHANNELS >= 4)
-    Timer3.attachInterrupt(4, FUEL_INTERRUPT_NAME(4));
+    fuelTimer1to4.attachInterrupt(4, FUEL_INTERRUPT_NAME(4));
     #endif
     #if (INJ_CHANNELS >= 5)
     Timer5.setOverflow((numeric_limits<COMPARE_TYPE>::max)(), TICK_FORMAT);
@@ -487,7 +551,10 @@ void boardInitPins(uint8_t, pinNumbers_t &)
 
 static uint16_t getEepromWriteBlockSize(const statuses &current)
 {
-#if defined(USE_SPI_EEPROM)
+#if defined(USE_SPI_EEPROM) && defined(SPI_FLASH_LOG)
+  // Writes only update the RAM image, the flash is written once per page by commitFlashLog()
+  uint16_t maxWrite = 512;
+#elif defined(USE_SPI_EEPROM)
   //For use with common Winbond SPI EEPROMs Eg W25Q16JV
   uint16_t maxWrite = 20; //This needs tuning
 #else
@@ -503,10 +570,21 @@ static uint16_t getEepromWriteBlockSize(const statuses &current)
   return maxWrite;
 }
 
+#if defined(USE_SPI_EEPROM) && defined(SPI_FLASH_LOG)
+static void commitFlashLog(void)
+{
+  (void)EEPROM.commit();
+}
+#endif
+
 /** @brief Get the EEPROM storage API for the board */
 storage_api_t getBoardStorageApi(void)
 {
-  return getEEPROMStorageApi(getEepromWriteBlockSize);
+  storage_api_t api = getEEPROMStorageApi(getEepromWriteBlockSize);
+#if defined(USE_SPI_EEPROM) && defined(SPI_FLASH_LOG)
+  api.commit = commitFlashLog;
+#endif
+  return api;
 }
 
 /** @brief Get the PWM timer resolution in uS */
@@ -37,14 +37,44 @@
 * General
 */
 
+/** @brief The tick length in µS of the 16-bit timers (the auxiliary outputs & by default, the schedules) */
+constexpr uint32_t TIMER_RESOLUTION = 4U;
+
+#if defined(SCHEDULE_TIMERS_32BIT)
+/*
+ * The schedules run on the 32-bit TIM2 & TIM5 only, at a sub-µS tick. They overflow
+ * after ~18 minutes, so there is no practical limit on a schedule delay.
+ */
+#if !defined(STM32F4)
+  #error "SCHEDULE_TIMERS_32BIT needs the 32-bit TIM2 & TIM5 of an STM32F4"
+#endif
+
 /** @brief The timer overflow type
  * 
  * On some boards timers can overflow at less than the timer register width
  */
-using COMPARE_TYPE = uint16_t;
+using COMPARE_TYPE = uint32_t;
 
-/** @brief The timer tick length in µS */
-constexpr uint32_t TIMER_RESOLUTION = 4U;
+/** @brief Schedule timer ticks per µS. I.e. 0.25µS per tick */
+#define SCHEDULE_TICKS_PER_US 4U
+
+/** @brief Converts a given number of uS into the required number of timer ticks until that time has passed */
+static constexpr COMPARE_TYPE uS_TO_TIMER_COMPARE(uint32_t micros)
+{
+  return (COMPARE_TYPE)(micros * SCHEDULE_TICKS_PER_US);
+}
+
+/** @brief Convert timer ticks to µS */
+static constexpr uint32_t ticksToMicros(COMPARE_TYPE ticks)
+{
+  return ticks / SCHEDULE_TICKS_PER_US;
+}
+#else
+/** @brief The timer overflow type
+ * 
+ * On some boards timers can overflow at less than the timer register width
+ */
+using COMPARE_TYPE = uint16_t;
 
 /** @brief Converts a given number of uS into the required number of timer ticks until that time has passed */
 static constexpr COMPARE_TYPE uS_TO_TIMER_COMPARE(uint32_t micros)
@@ -59,6 +89,7 @@ static constexpr uint32_t ticksToMicros(COMPARE_TYPE ticks)
 {
   return ticks * TIMER_RESOLUTION;
 }
+#endif
 
 #define TS_SERIAL_BUFFER_SIZE 517 //Size of the serial buffer used by new comms protocol. For SD transfers this must be at least 512 + 1 (flag) + 4 (sector)
 #define FPU_MAX_SIZE 32 //Size of the FPU buffer. 0 means no FPU.
@@ -222,8 +253,26 @@ extern STM32RTC& rtc;
 * 2 - BOOST |2 - IGN2  |2 - INJ2  |2 - IGN6  |2 - INJ6  |
 * 3 - VVT   |3 - IGN3  |3 - INJ3  |3 - IGN7  |3 - INJ7  |
 * 4 - IDLE  |4 - IGN4  |4 - INJ4  |4 - IGN8  |4 - INJ8  | 
+*
+* Timers Table for STM32F4 with SCHEDULE_TIMERS_32BIT
+*   TIMER1  |  TIMER2  |  TIMER5  |  TIMER11
+* 1 - FAN   |1 - IGN1  |1 - INJ1  |1 - oneMSInterval
+* 2 - BOOST |2 - IGN2  |2 - INJ2  |
+* 3 - VVT   |3 - IGN3  |3 - INJ3  |
+* 4 - IDLE  |4 - IGN4  |4 - INJ4  |
 */
-#if defined(STM32F407xx) //F407 can do 8x8 STM32F401/STM32F411 don't
+#if defined(SCHEDULE_TIMERS_32BIT)
+  #ifndef INJ_CHANNELS
+    #define INJ_CHANNELS 4
+  #endif
+  #ifndef IGN_CHANNELS
+    #define IGN_CHANNELS 4
+  #endif
+  #if (INJ_CHANNELS > 4) || (IGN_CHANNELS > 4)
+    #error "SCHEDULE_TIMERS_32BIT supports at most 4 fuel & 4 ignition channels"
+  #endif
+  #define FUEL_TIMER_1_4 TIM5
+#elif defined(STM32F407xx) //F407 can do 8x8 STM32F401/STM32F411 don't
   #ifndef INJ_CHANNELS
     #define INJ_CHANNELS 8
   #endif
@@ -238,15 +287,18 @@ extern STM32RTC& rtc;
     #define IGN_CHANNELS 5
   #endif
 #endif
-#define FUEL1_COUNTER (TIM3)->CNT
-#define FUEL2_COUNTER (TIM3)->CNT
-#define FUEL3_COUNTER (TIM3)->CNT
-#define FUEL4_COUNTER (TIM3)->CNT
+#ifndef FUEL_TIMER_1_4
+  #define FUEL_TIMER_1_4 TIM3
+#endif
+#define FUEL1_COUNTER (FUEL_TIMER_1_4)->CNT
+#define FUEL2_COUNTER (FUEL_TIMER_1_4)->CNT
+#define FUEL3_COUNTER (FUEL_TIMER_1_4)->CNT
+#define FUEL4_COUNTER (FUEL_TIMER_1_4)->CNT
 
-#define FUEL1_COMPARE (TIM3)->CCR1
-#define FUEL2_COMPARE (TIM3)->CCR2
-#define FUEL3_COMPARE (TIM3)->CCR3
-#define FUEL4_COMPARE (TIM3)->CCR4
+#define FUEL1_COMPARE (FUEL_TIMER_1_4)->CCR1
+#define FUEL2_COMPARE (FUEL_TIMER_1_4)->CCR2
+#define FUEL3_COMPARE (FUEL_TIMER_1_4)->CCR3
+#define FUEL4_COMPARE (FUEL_TIMER_1_4)->CCR4
 
 #define IGN1_COUNTER  (TIM2)->CNT
 #define IGN2_COUNTER  (TIM2)->CNT
@@ -279,15 +331,15 @@ extern STM32RTC& rtc;
 #define IGN8_COMPARE (TIM4)->CCR4
 
   
-static inline void FUEL1_TIMER_ENABLE(void) {(TIM3)->CR1 |= TIM_CR1_CEN; (TIM3)->SR = ~TIM_FLAG_CC1; (TIM3)->DIER |= TIM_DIER_CC1IE;}
-static inline void FUEL2_TIMER_ENABLE(void) {(TIM3)->CR1 |= TIM_CR1_CEN; (TIM3)->SR = ~TIM_FLAG_CC2; (TIM3)->DIER |= TIM_DIER_CC2IE;}
-static inline void FUEL3_TIMER_ENABLE(void) {(TIM3)->CR1 |= TIM_CR1_CEN; (TIM3)->SR = ~TIM_FLAG_CC3; (TIM3)->DIER |= TIM_DIER_CC3IE;}
-static inline void FUEL4_TIMER_ENABLE(void) {(TIM3)->CR1 |= TIM_CR1_CEN; (TIM3)->SR = ~TIM_FLAG_CC4; (TIM3)->DIER |= TIM_DIER_CC4IE;}
-
-static inline void FUEL1_TIMER_DISABLE(void) {(TIM3)->DIER &= ~TIM_DIER_CC1IE;}
-static inline void FUEL2_TIMER_DISABLE(void) {(TIM3)->DIER &= ~TIM_DIER_CC2IE;}
-static inline void FUEL3_TIMER_DISABLE(void) {(TIM3)->DIER &= ~TIM_DIER_CC3IE;}
-static inline void FUEL4_TIMER_DISABLE(void) {(TIM3)->DIER &= ~TIM_DIER_CC4IE;}
+static inline void FUEL1_TIMER_ENABLE(void) {(FUEL_TIMER_1_4)->CR1 |= TIM_CR1_CEN; (FUEL_TIMER_1_4)->SR = ~TIM_FLAG_CC1; (FUEL_TIMER_1_4)->DIER |= TIM_DIER_CC1IE;}
+static inline void FUEL2_TIMER_ENABLE(void) {(FUEL_TIMER_1_4)->CR1 |= TIM_CR1_CEN; (FUEL_TIMER_1_4)->SR = ~TIM_FLAG_CC2; (FUEL_TIMER_1_4)->DIER |= TIM_DIER_CC2IE;}
+static inline void FUEL3_TIMER_ENABLE(void) {(FUEL_TIMER_1_4)->CR1 |= TIM_CR1_CEN; (FUEL_TIMER_1_4)->SR = ~TIM_FLAG_CC3; (FUEL_TIMER_1_4)->DIER |= TIM_DIER_CC3IE;}
+static inline void FUEL4_TIMER_ENABLE(void) {(FUEL_TIMER_1_4)->CR1 |= TIM_CR1_CEN; (FUEL_TIMER_1_4)->SR = ~TIM_FLAG_CC4; (FUEL_TIMER_1_4)->DIER |= TIM_DIER_CC4IE;}
+
+static inline void FUEL1_TIMER_DISABLE(void) {(FUEL_TIMER_1_4)->DIER &= ~TIM_DIER_CC1IE;}
+static inline void FUEL2_TIMER_DISABLE(void) {(FUEL_TIMER_1_4)->DIER &= ~TIM_DIER_CC2IE;}
+static inline void FUEL3_TIMER_DISABLE(void) {(FUEL_TIMER_1_4)->DIER &= ~TIM_DIER_CC3IE;}
+static inline void FUEL4_TIMER_DISABLE(void) {(FUEL_TIMER_1_4)->DIER &= ~TIM_DIER_CC4IE;}
 
 static inline void IGN1_TIMER_ENABLE(void)  {(TIM2)->CR1 |= TIM_CR1_CEN; (TIM2)->SR = ~TIM_FLAG_CC1; (TIM2)->DIER |= TIM_DIER_CC1IE;}
 static inline void IGN2_TIMER_ENABLE(void)  {(TIM2)->CR1 |= TIM_CR1_CEN; (TIM2)->SR = ~TIM_FLAG_CC2; (TIM2)->DIER |= TIM_DIER_CC2IE;}
@@ -15,6 +15,7 @@
 #include "board_eeprom_adapter.hpp"
 #include "scheduler_ignition_controller.h"
 #include "scheduler_fuel_controller.h"
+#include "acc_mc33810.h"
 #include "src/controllers/fan/fanController.h"
 #include "src/controllers/boost/boostController.h"
 #include "globals.h"
@@ -338,6 +339,8 @@ void ftm0_isr(void)
 }
 void ftm3_isr(void)
 {
+  //Several channels can be serviced in one pass, so coalesce any MC33810 output changes into one SPI write
+  mc33810_batch_t batch;
 
 #if (INJ_CHANNELS >= 5)
   bool interrupt1 = (FTM3_C0SC & FTM_CSC_CHF);
@@ -15,6 +15,13 @@
 #include "src/controllers/boost/boostController.h"
 #include "globals.h"
 
+#if defined(HW_AUX_PWM)
+//The aux PIT channels are only started (by enableAuxPwm()) for outputs that can't use hardware PWM
+static constexpr uint32_t AUX_PIT_START = 0U;
+#else
+static constexpr uint32_t AUX_PIT_START = PIT_TCTRL_TEN;
+#endif
+
 static void PIT_isr();
 static void TMR1_isr(void);
 static void TMR2_isr(void);
@@ -69,7 +76,7 @@ void initBoard(uint32_t /*baudRate*/)
     {
       PIT_TCTRL0 = 0;
       PIT_TCTRL0 |= PIT_TCTRL_TIE; // enable Timer 1 interrupts
-      PIT_TCTRL0 |= PIT_TCTRL_TEN; // start Timer 1
+      PIT_TCTRL0 |= AUX_PIT_START; // start Timer 1
       PIT_LDVAL0 = 1; //1 * 2uS = 2uS
     }
 
@@ -93,18 +100,20 @@ void initBoard(uint32_t /*baudRate*/)
     {
       PIT_TCTRL1 = 0;
       PIT_TCTRL1 |= PIT_TCTRL_TIE; // enable Timer 2 interrupts
-      PIT_TCTRL1 |= PIT_TCTRL_TEN; // start Timer 2
+      PIT_TCTRL1 |= AUX_PIT_START; // start Timer 2
       PIT_LDVAL1 = 1; //1 * 2uS = 2uS
     }
     if (configPage6.vvtEnabled == 1)
     {
       PIT_TCTRL2 = 0;
       PIT_TCTRL2 |= PIT_TCTRL_TIE; // enable Timer 3 interrupts
-      PIT_TCTRL2 |= PIT_TCTRL_TEN; // start Timer 3
+      PIT_TCTRL2 |= AUX_PIT_START; // start Timer 3
       PIT_LDVAL2 = 1; //1 * 2uS = 2uS
     }
 
-    //TODO: Configure timers here
+#if defined(HW_AUX_PWM)
+    analogWriteResolution(HW_AUX_PWM_RESOLUTION);
+#endif
 
     /*
     ***********************************************************************************************************
@@ -425,4 +434,168 @@ uint8_t getPwmTimerResolution(void)
   return 2;
 }
 
+#if defined(HW_AUX_PWM)
+/*
+***********************************************************************************************************
+* Hardware auxiliary PWM
+*
+* Outputs on FlexPWM pins are driven by their FlexPWM submodule. Once started, the only CPU work is writing
+* a new duty when a controller changes it: the FlexPWM buffers the new duty until the end of the current
+* period, so there are no runt pulses. The QuadTimer PWM pins can't be used, as all 4 QuadTimers run the
+* fuel & ignition schedules.
+*/
+
+/** @brief A FlexPWM pin. Pins on the same submodule share the PWM frequency */
+struct flexPwmPin_t {
+  uint8_t pin;
+  uint8_t submodule; ///< (FlexPWM module - 1) * 4 + submodule
+};
+
+static constexpr flexPwmPin_t FLEXPWM_PINS[] = {
+  { 0, 1 }, { 1, 0 }, { 2, 14 }, { 3, 14 }, { 4, 4 }, { 5, 5 }, { 6, 6 }, { 7, 3 }, { 8, 3 }, { 9, 6 },
+  { 22, 12 }, { 23, 13 }, { 24, 2 }, { 25, 3 }, { 28, 9 }, { 29, 9 }, { 33, 4 }, { 36, 7 }, { 37, 7 },
+  { 42, 1 }, { 43, 1 }, { 44, 0 }, { 45, 0 }, { 46, 2 }, { 47, 2 }, { 51, 11 }, { 54, 8 },
+};
+static constexpr uint8_t NOT_FLEXPWM = UINT8_MAX;
+
+struct hwAuxPwmChannel_t {
+  softPwmOutput_t output;
+  uint16_t periodTicks;
+  uint16_t dutyTicks;   ///< The duty last written to the hardware
+  uint8_t pin;
+  uint8_t submodule;
+  bool isActiveLow;
+  bool isHardware;      ///< false if the channel is driven by its PIT channel & interrupt
+  bool isEnabled;
+};
+
+static hwAuxPwmChannel_t auxPwm[AUX_PWM_CHANNEL_COUNT];
+/** @brief Enabled channels that are driven by their PIT interrupt */
+static uint8_t pitAuxPwmMask;
+
+static uint8_t getFlexPwmSubmodule(uint8_t pin)
+{
+  for (const flexPwmPin_t &flexPin : FLEXPWM_PINS)
+  {
+    if (flexPin.pin == pin) { return flexPin.submodule; }
+  }
+  return NOT_FLEXPWM;
+}
+
+//Another hardware channel already runs this submodule at a different frequency
+static bool isSubmoduleInUse(uint8_t channel, uint8_t submodule)
+{
+  for (uint8_t other=0U; other<AUX_PWM_CHANNEL_COUNT; ++other)
+  {
+    if ( (other!=channel) && auxPwm[other].isHardware && (auxPwm[other].submodule==submodule)
+      && (auxPwm[other].periodTicks!=auxPwm[channel].periodTicks) )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static inline void setPitEnabled(volatile uint32_t &tctrl, bool enable)
+{
+  if (enable) { tctrl |= PIT_TCTRL_TEN; }
+  else { tctrl &= ~PIT_TCTRL_TEN; }
+}
+
+static void updateAuxPitChannels(void)
+{
+  setPitEnabled(PIT_TCTRL0, (pitAuxPwmMask & AUX_PWM_BIT(AUX_PWM_IDLE)) != 0U);
+  setPitEnabled(PIT_TCTRL1, (pitAuxPwmMask & AUX_PWM_BIT(AUX_PWM_BOOST)) != 0U);
+  setPitEnabled(PIT_TCTRL2, (pitAuxPwmMask & (AUX_PWM_BIT(AUX_PWM_VVT1) | AUX_PWM_BIT(AUX_PWM_VVT2))) != 0U);
+}
+
+static void writeHardwareDuty(const hwAuxPwmChannel_t &pwm)
+{
+  uint32_t value = getAuxPwmHardwareDuty(pwm.dutyTicks, pwm.periodTicks, HW_AUX_PWM_RESOLUTION, pwm.isActiveLow);
+  analogWrite(pwm.pin, (int)value); //Also switches the pin to the FlexPWM output
+}
+
+static void startHardwarePwm(hwAuxPwmChannel_t &pwm)
+{
+  analogWriteFrequency(pwm.pin, 1000000.0f / ((float)pwm.periodTicks * (float)getPwmTimerResolution()));
+  pwm.dutyTicks = pwm.output.pGetDuty();
+  writeHardwareDuty(pwm);
+}
+
+void configureAuxPwm(uint8_t channel, const softPwmOutput_t &output, uint16_t periodTicks)
+{
+  hwAuxPwmChannel_t &pwm = auxPwm[channel];
+  pwm.output = output;
+  pwm.periodTicks = periodTicks==0U ? 1U : periodTicks;
+  if (pwm.isEnabled && pwm.isHardware) { startHardwarePwm(pwm); }
+}
+
+bool setAuxPwmPin(uint8_t channel, uint8_t pin, bool isActiveLow)
+{
+  hwAuxPwmChannel_t &pwm = auxPwm[channel];
+  bool wasEnabled = pwm.isEnabled;
+  disableAuxPwm(AUX_PWM_BIT(channel));
+
+  pwm.isHardware = false;
+  pwm.pin = pin;
+  pwm.isActiveLow = isActiveLow;
+  pwm.submodule = getFlexPwmSubmodule(pin);
+  pwm.isHardware = (pwm.submodule != NOT_FLEXPWM) && !isSubmoduleInUse(channel, pwm.submodule);
+
+  if (wasEnabled) { enableAuxPwm(AUX_PWM_BIT(channel)); }
+  return pwm.isHardware;
+}
+
+void enableAuxPwm(uint8_t channelMask)
+{
+  for (uint8_t channel=0U; channel<AUX_PWM_CHANNEL_COUNT; ++channel)
+  {
+    hwAuxPwmChannel_t &pwm = auxPwm[channel];
+    if ( ((channelMask & AUX_PWM_BIT(channel))!=0U) && !pwm.isEnabled && (pwm.output.pGetDuty!=nullptr) )
+    {
+      pwm.isEnabled = true;
+      if (pwm.isHardware) { startHardwarePwm(pwm); }
+      else { pitAuxPwmMask |= AUX_PWM_BIT(channel); }
+    }
+  }
+  updateAuxPitChannels();
+}
+
+void disableAuxPwm(uint8_t channelMask)
+{
+  for (uint8_t channel=0U; channel<AUX_PWM_CHANNEL_COUNT; ++channel)
+  {
+    hwAuxPwmChannel_t &pwm = auxPwm[channel];
+    if ( ((channelMask & AUX_PWM_BIT(channel))!=0U) && pwm.isEnabled )
+    {
+      pwm.isEnabled = false;
+      if (pwm.isHardware)
+      {
+        //Hand the pin back to the GPIO, in the inactive state. The caller then sets the level it needs.
+        pinMode(pwm.pin, OUTPUT);
+        digitalWriteFast(pwm.pin, pwm.isActiveLow ? HIGH : LOW);
+      }
+      else { pitAuxPwmMask &= ~AUX_PWM_BIT(channel); }
+    }
+  }
+  updateAuxPitChannels();
+}
+
+void refreshAuxPwm(void)
+{
+  for (hwAuxPwmChannel_t &pwm : auxPwm)
+  {
+    if (pwm.isEnabled && pwm.isHardware)
+    {
+      uint16_t duty = pwm.output.pGetDuty();
+      if (duty != pwm.dutyTicks)
+      {
+        pwm.dutyTicks = duty;
+        writeHardwareDuty(pwm);
+      }
+    }
+  }
+}
+#endif
+
 #endif
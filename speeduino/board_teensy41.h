@@ -179,6 +179,12 @@ static inline void IGN8_TIMER_DISABLE(void)  {TMR4_CSCTRL3 &= ~TMR_CSCTRL_TCF1EN
 ***********************************************************************************************************
 * Auxiliaries
 */
+#if !defined(DISABLE_HW_AUX_PWM) && !defined(SOFT_PWM_ENGINE)
+//Idle, boost & VVT outputs on FlexPWM pins are driven by hardware PWM, which only needs writing when the duty changes.
+//Outputs on other pins fall back to the PIT timer interrupts below. See board_teensy41.cpp
+#define HW_AUX_PWM
+#define HW_AUX_PWM_RESOLUTION 15U //Duty resolution of the hardware PWM outputs, in bits
+#else
 #define ENABLE_BOOST_TIMER()  PIT_TCTRL1 |= PIT_TCTRL_TEN
 #define DISABLE_BOOST_TIMER() PIT_TCTRL1 &= ~PIT_TCTRL_TEN
 
@@ -188,6 +194,7 @@ static inline void IGN8_TIMER_DISABLE(void)  {TMR4_CSCTRL3 &= ~TMR_CSCTRL_TCF1EN
 //Ran out of timers, this most likely won't work. This should be possible to implement with the GPT timer. 
 #define ENABLE_FAN_TIMER()    TMR3_CSCTRL1 |= TMR_CSCTRL_TCF2EN
 #define DISABLE_FAN_TIMER()   TMR3_CSCTRL1 &= ~TMR_CSCTRL_TCF2EN
+#endif
 
 #define BOOST_TIMER_COMPARE   PIT_LDVAL1
 #define BOOST_TIMER_COUNTER   0
@@ -205,8 +212,10 @@ static inline void IGN8_TIMER_DISABLE(void)  {TMR4_CSCTRL3 &= ~TMR_CSCTRL_TCF1EN
 #define IDLE_COUNTER 0
 #define IDLE_COMPARE PIT_LDVAL0
 
+#if !defined(HW_AUX_PWM)
 #define IDLE_TIMER_ENABLE() PIT_TCTRL0 |= PIT_TCTRL_TEN
 #define IDLE_TIMER_DISABLE() PIT_TCTRL0 &= ~PIT_TCTRL_TEN
+#endif
 
 /*
 ***********************************************************************************************************
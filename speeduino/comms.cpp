@@ -29,6 +29,7 @@ A full copy of the license may be found in the projects root directory
 #include "units.h"
 #include "sensors.h"
 #include "resetControl.h"
+#include "programmableIOControl.h"
 
 /** @defgroup group-serial-comms-impl Serial comms implementation
  * @{
@@ -342,10 +343,8 @@ static bool updatePageValues(uint8_t pageNum, uint16_t offset, const byte *buffe
 {
   if ( addWithoutOverflow(offset, length) <= getPageSize(pageNum) )
   {
-    for(uint16_t i = 0; i < length; i++)
-    {
-      setPageValue(pageNum, (offset + i), buffer[i]);
-    }
+    (void)writePage(pageNum, offset, buffer, length);
+    if (pageNum == progOutsPage) { compileProgrammableIO(configPage13); }
     setStorageWriteTimeout(EEPROM_DEFER_DELAY);
     return true;
   }
@@ -363,10 +362,7 @@ static bool updatePageValues(uint8_t pageNum, uint16_t offset, const byte *buffe
  */
 static void loadPageValuesToBuffer(uint8_t pageNum, uint16_t offset, byte *buffer, uint16_t length)
 {
-  for(uint16_t i = 0; i < length; i++)
-  {
-    buffer[i] = getPageValue(pageNum, offset + i);
-  }
+  readPage(pageNum, offset, buffer, length);
 }
 
 /** @brief Send a status record back to tuning/logging SW.
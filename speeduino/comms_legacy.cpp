@@ -26,6 +26,7 @@ A full copy of the license may be found in the projects root directory
 #include "units.h"
 #include "sensors.h"
 #include "resetControl.h"
+#include "programmableIOControl.h"
 
 static byte currentPage = 1;//Not the same as the speeduino config page numbers
 bool firstCommsRequest = true; /**< The number of times the A command has been issued. This is used to track whether a reset has recently been performed on the controller */
@@ -609,7 +610,12 @@ void legacySerialHandler(byte cmd, Stream &targetPort, SerialStatus &targetStatu
           setPageValue(currentPage, (valueOffset + chunkComplete), targetPort.read());
           chunkComplete++;
         }
-        if(chunkComplete >= chunkSize) { targetStatusFlag = SERIAL_INACTIVE; chunkPending = false; }
+        if(chunkComplete >= chunkSize) 
+        { 
+          targetStatusFlag = SERIAL_INACTIVE; 
+          chunkPending = false; 
+          if (currentPage == progOutsPage) { compileProgrammableIO(configPage13); }
+        }
       }
       break;
 
@@ -31,6 +31,7 @@ There are 2 top level functions that call more detailed corrections for Fuel and
 #include "sensors.h"
 #include "unit_testing.h"
 #include "preprocessor.h"
+#include "static_for.hpp"
 #include "src/PID/PID.h"
 #include "units.h"
 #include "fuel_calcs.h"
@@ -50,6 +51,9 @@ static uint8_t knockLastRecoveryStep;
 //static int16_t knockWindowMin; //The current minimum crank angle for a knock pulse to be valid
 //static int16_t knockWindowMax;//The current maximum crank angle for a knock pulse to be valid
 static uint8_t dfcoTaper;
+// Cached combination of the sensor rate corrections. See correctionsSensorRate()
+static uint32_t sensorCorrectionsProduct;
+static bool sensorCorrectionsStale;
 
 TESTABLE_CONSTEXPR table2D_u8_u8_4 taeTable(&configPage4.taeBins, &configPage4.taeValues);
 TESTABLE_CONSTEXPR table2D_u8_u8_4 maeTable(&configPage4.maeBins, &configPage4.maeRates);
@@ -95,6 +99,10 @@ void initialiseCorrections(void)
   currentStatus.iatCorrection = NO_FUEL_CORRECTION;
   currentStatus.baroCorrection = NO_FUEL_CORRECTION;
   currentStatus.batCorrection = NO_FUEL_CORRECTION;
+  currentStatus.flexCorrection = NO_FUEL_CORRECTION;
+  currentStatus.fuelTempCorrection = NO_FUEL_CORRECTION;
+  sensorCorrectionsProduct = NO_FUEL_CORRECTION;
+  sensorCorrectionsStale = true;
   AFRnextCycle = 0;
   currentStatus.knockRetardActive = false;
   currentStatus.knockPulseDetected = false;
@@ -111,21 +119,18 @@ Uses a 2D enrichment table (WUETable) where the X axis is engine temp and the Y
 */
 TESTABLE_INLINE_STATIC uint8_t correctionWUE(void)
 {
-  uint8_t WUEValue = currentStatus.wueCorrection;
+  uint8_t WUEValue;
 
-  // Only update as fast as the sensor is read
-  if( BIT_CHECK(currentStatus.LOOP_TIMER, CLT_READ_TIMER_BIT) ) { 
-    if (currentStatus.coolant >= temperatureRemoveOffset(WUETable.axis[WUETable.size()-1U]))
-    {
-      //This prevents us doing the 2D lookup if we're already up to temp
-      currentStatus.wueIsActive = false;
-      WUEValue = WUETable.values[WUETable.size()-1U];
-    }
-    else
-    {
-      currentStatus.wueIsActive = true;
-      WUEValue = table2D_getValue(&WUETable, temperatureAddOffset(currentStatus.coolant));
-    }
+  if (currentStatus.coolant >= temperatureRemoveOffset(WUETable.axis[WUETable.size()-1U]))
+  {
+    //This prevents us doing the 2D lookup if we're already up to temp
+    currentStatus.wueIsActive = false;
+    WUEValue = WUETable.values[WUETable.size()-1U];
+  }
+  else
+  {
+    currentStatus.wueIsActive = true;
+    WUEValue = table2D_getValue(&WUETable, temperatureAddOffset(currentStatus.coolant));
   }
 
   return WUEValue;
@@ -540,11 +545,7 @@ This corrects for changes in air density from movement of the temperature.
 */
 TESTABLE_INLINE_STATIC uint8_t correctionIATDensity(void)
 {
-  // Performance: only update as fast as the sensor is read
-  if( BIT_CHECK(currentStatus.LOOP_TIMER, IAT_READ_TIMER_BIT) ) { 
-    return table2D_getValue(&IATDensityCorrectionTable, temperatureAddOffset(currentStatus.IAT)); //currentStatus.IAT is the actual temperature, values in IATDensityCorrectionTable.axisX are temp+offset
-  }
-  return currentStatus.iatCorrection;
+  return table2D_getValue(&IATDensityCorrectionTable, temperatureAddOffset(currentStatus.IAT)); //currentStatus.IAT is the actual temperature, values in IATDensityCorrectionTable.axisX are temp+offset
 }
 
 // ============================= Baro pressure correction =============================
@@ -554,11 +555,7 @@ TESTABLE_INLINE_STATIC uint8_t correctionIATDensity(void)
  */
 TESTABLE_INLINE_STATIC uint8_t correctionBaro(void)
 {
-  // No point in updating more often than the sensor is read
-  if( BIT_CHECK(currentStatus.LOOP_TIMER, BARO_READ_TIMER_BIT) ) { 
-    return (uint8_t)table2D_getValue(&baroFuelTable, currentStatus.baro);
-  }
-  return currentStatus.baroCorrection;
+  return (uint8_t)table2D_getValue(&baroFuelTable, currentStatus.baro);
 }
 
 // ============================= Launch control correction =============================
@@ -806,6 +803,62 @@ static inline uint32_t combineCorrections(uint32_t sumCorrections, uint16_t corr
   return percentageApprox(correction, sumCorrections);
 }
 
+// ============================= Sensor rate corrections =============================
+
+/** @brief A fuel correction whose inputs only change when a sensor is read.
+ * 
+ * The correction is recomputed only when its timer bit is set in LOOP_TIMER, otherwise
+ * the cached value is reused. 
+ */
+struct sensorCorrection_t {
+  uint8_t timerBit;           ///< The LOOP_TIMER bit that signals the inputs have been sampled. E.g. IAT_READ_TIMER_BIT
+  uint8_t (*pCompute)(void);  ///< The correction function
+  uint8_t *pValue;            ///< The cached correction value (which is also the live data field). E.g. &currentStatus.iatCorrection
+};
+
+static constexpr sensorCorrection_t sensorCorrections[] = {
+  { CLT_READ_TIMER_BIT, correctionWUE, &currentStatus.wueCorrection },
+  { IAT_READ_TIMER_BIT, correctionIATDensity, &currentStatus.iatCorrection },
+  { BARO_READ_TIMER_BIT, correctionBaro, &currentStatus.baroCorrection },
+  { FLEX_READ_TIMER_BIT, correctionFlex, &currentStatus.flexCorrection },
+  { FLEX_READ_TIMER_BIT, correctionFuelTemp, &currentStatus.fuelTempCorrection },
+};
+
+static inline void updateSensorCorrection(uint8_t index, const sensorCorrection_t *pCorrections, byte loopTimer, bool *pChanged) {
+  const sensorCorrection_t &correction = pCorrections[index];
+  if (BIT_CHECK(loopTimer, correction.timerBit)) {
+    const uint8_t value = correction.pCompute();
+    *pChanged = *pChanged || (value != *correction.pValue);
+    *correction.pValue = value;
+  }
+}
+
+static inline void combineSensorCorrection(uint8_t index, const sensorCorrection_t *pCorrections, uint32_t *pProduct) {
+  *pProduct = combineCorrections(*pProduct, *pCorrections[index].pValue);
+}
+
+/** @brief Combine all the corrections that only change at sensor read rates (or slower)
+ * 
+ * Since these corrections change at 4Hz or less, the combined value is cached & only
+ * recomputed when one of the corrections changes.
+ */
+static inline uint32_t correctionsSensorRate(void) {
+  // Recompute everything on the 1st call after initialiseCorrections()
+  const byte loopTimer = sensorCorrectionsStale ? UINT8_MAX : currentStatus.LOOP_TIMER;
+  sensorCorrectionsStale = false;
+
+  bool changed = false;
+  static_for<0, _countof(sensorCorrections)>::repeat_n(updateSensorCorrection, sensorCorrections, loopTimer, &changed);
+
+  if (changed) {
+    uint32_t product = BASELINE_FUEL_CORRECTION;
+    static_for<0, _countof(sensorCorrections)>::repeat_n(combineSensorCorrection, sensorCorrections, &product);
+    sensorCorrectionsProduct = product;
+  }
+
+  return sensorCorrectionsProduct;
+}
+
 /** Dispatch calculations for all fuel related corrections.
 Calls all the other corrections functions and combines their results.
 This is the only function that should be called from anywhere outside the file
@@ -813,8 +866,7 @@ This is the only function that should be called from anywhere outside the file
 uint16_t correctionsFuel(void)
 {
   //The values returned by each of the correction functions are multiplied together and then divided back to give a single 0-255 value.
-  currentStatus.wueCorrection = correctionWUE();
-  uint32_t sumCorrections = currentStatus.wueCorrection;
+  uint32_t sumCorrections = correctionsSensorRate();
 
   currentStatus.ASEValue = correctionASE();
   sumCorrections = combineCorrections(sumCorrections, currentStatus.ASEValue);
@@ -834,18 +886,6 @@ uint16_t correctionsFuel(void)
 
   //Voltage correction is applied to the injector opening time
   currentStatus.batCorrection = correctionBatVoltage();
-  
-  currentStatus.iatCorrection = correctionIATDensity();
-  sumCorrections = combineCorrections(sumCorrections, currentStatus.iatCorrection);
-
-  currentStatus.baroCorrection = correctionBaro();
-  sumCorrections = combineCorrections(sumCorrections, currentStatus.baroCorrection);
-
-  currentStatus.flexCorrection = correctionFlex();
-  sumCorrections = combineCorrections(sumCorrections, currentStatus.flexCorrection);
-
-  currentStatus.fuelTempCorrection = correctionFuelTemp();
-  sumCorrections = combineCorrections(sumCorrections, currentStatus.fuelTempCorrection);
 
   currentStatus.launchCorrection = correctionLaunch();
   sumCorrections = combineCorrections(sumCorrections, currentStatus.launchCorrection);
@@ -2,6 +2,7 @@
 #include "globals.h"
 #include "crankMaths.h"
 #include "preprocessor.h"
+#include "atomic_profile.h"
 
 #define SECOND_DERIV_ENABLED                0          
 
@@ -18,7 +19,7 @@ typedef uint32_t UQ24X8_t;
 static constexpr uint8_t UQ24X8_Shift = 8U;
 
 /** @brief uS per degree at current RPM in UQ24.8 fixed point */
-static  UQ24X8_t microsPerDegree;
+TESTABLE_STATIC UQ24X8_t microsPerDegree;
 static constexpr uint8_t microsPerDegree_Shift = UQ24X8_Shift;
 
 typedef uint16_t UQ1X15_t;
@@ -28,24 +29,51 @@ static constexpr uint8_t UQ1X15_Shift = 15U;
  * 
  * Ranges from 8 (0.000246) at MIN_RPM to 3542 (0.108) at MAX_RPM
  */
-static UQ1X15_t degreesPerMicro;
+TESTABLE_STATIC UQ1X15_t degreesPerMicro;
 static constexpr uint8_t degreesPerMicro_Shift = UQ1X15_Shift;
 
 void setAngleConverterRevolutionTime(uint32_t revolutionTime) noexcept {
-  microsPerDegree = div360(lshift<microsPerDegree_Shift>(revolutionTime));
+  // The divisions are slow, so only the stores are protected from the ISRs (which convert angles during per tooth timing)
+  UQ24X8_t newMicrosPerDegree = div360(lshift<microsPerDegree_Shift>(revolutionTime));
   constexpr uint32_t UQ1X15_360 = UINT32_C(360) << degreesPerMicro_Shift;
-  degreesPerMicro = (uint16_t)fast_div_closest(UQ1X15_360, revolutionTime);
+  UQ1X15_t newDegreesPerMicro = (UQ1X15_t)fast_div_closest(UQ1X15_360, revolutionTime);
+  ATOMIC_PROFILED(ATOMIC_SITE_DECODER) {
+    microsPerDegree = newMicrosPerDegree;
+    degreesPerMicro = newDegreesPerMicro;
+  }
+}
+
+/** @brief The time the angle takes at current RPM, in µS as UQ24.8 fixed point */
+TESTABLE_INLINE_STATIC UQ24X8_t angleToFixedTime(uint16_t angle) noexcept {
+  return (uint32_t)angle * (uint32_t)microsPerDegree;
+}
+
+/** @brief The largest angleToFixedTime(): 720° at MIN_RPM (~7.5x10^8) */
+static constexpr UQ24X8_t MAX_FIXED_ANGLE_TIME = 720UL * ((MAX_REVOLUTION_TIME << microsPerDegree_Shift) / 360UL);
+
+/**
+ * @brief Convert a UQ24.8 time to timer ticks, keeping the fraction of a µS.
+ * 
+ * @warning Overflows if fixedTime*ticksPerUs exceeds 32 bits: up to 5 ticks per µS is safe
+ */
+TESTABLE_INLINE_STATIC uint32_t fixedTimeToTicks(UQ24X8_t fixedTime, uint8_t ticksPerUs) noexcept {
+  return rshift_round<microsPerDegree_Shift>(fixedTime * ticksPerUs);
 }
 
 BEGIN_LTO_ALWAYS_INLINE(uint32_t) angleToTime(uint16_t angle) noexcept {
-  UQ24X8_t micros = (uint32_t)angle * (uint32_t)microsPerDegree;
-  return rshift_round<microsPerDegree_Shift>(micros);
+  return rshift_round<microsPerDegree_Shift>(angleToFixedTime(angle));
 }
 END_LTO_INLINE()
 
 BEGIN_LTO_ALWAYS_INLINE(COMPARE_TYPE) angleToTimerTicks(uint16_t angle) noexcept {
+#if defined(SCHEDULE_TICKS_PER_US)
+    // Sub-µS ticks: convert straight from the fixed point time, not the rounded µS
+    static_assert(((uint64_t)MAX_FIXED_ANGLE_TIME * SCHEDULE_TICKS_PER_US) <= UINT32_MAX, "SCHEDULE_TICKS_PER_US is too large for a 32-bit fixed point conversion");
+    return (COMPARE_TYPE)fixedTimeToTicks(angleToFixedTime(angle), SCHEDULE_TICKS_PER_US);
+#else
     uint32_t micros = angleToTime(angle);
     return uS_TO_TIMER_COMPARE(micros);
+#endif
 }
 END_LTO_INLINE()
 
@@ -7,6 +7,7 @@
 static void nullTriggerHandler (void){return;} //initialisation function for triggerhandlers, does exactly nothing
 static uint16_t nullGetRPM(void){return 0;} //initialisation function for getRpm, returns safe value of 0
 static int16_t nullGetCrankAngle(void){return 0;} //initialisation function for getCrankAngle, returns safe value of 0
+static toothAngle_t nullGetToothAngle(int16_t angle, uint16_t maxAngle) { UNUSED(angle); UNUSED(maxAngle); return toothAngle_t{ 0U, 0U }; }
 static bool nullEngineIsRunning(uint32_t currMillis) { UNUSED(currMillis); return false; }
 static decoder_status_t nullGetStatus(void) noexcept { return decoder_status_t{}; }
 static decoder_features_t nullGetFeatures(void) { return decoder_features_t(); }
@@ -19,6 +20,7 @@ decoder_builder_t::decoder_builder_t(void)
     (void)setGetRPM(&nullGetRPM);
     (void)setGetCrankAngle(&nullGetCrankAngle);
     (void)setSetEndTeeth(&nullTriggerHandler);
+    (void)setGetToothAngle(&nullGetToothAngle);
     (void)setReset(&nullTriggerHandler);
     (void)setIsEngineRunning(&nullEngineIsRunning);
     (void)setGetStatus(&nullGetStatus);
@@ -32,6 +34,7 @@ decoder_builder_t::decoder_builder_t(const decoder_t &decoder)
     (void)setGetRPM(decoder.getRPM);
     (void)setGetCrankAngle(decoder.getCrankAngle);
     (void)setSetEndTeeth(decoder.setEndTeeth);
+    (void)setGetToothAngle(decoder.getToothAngle);
     (void)setReset(decoder.reset);
     (void)setIsEngineRunning(decoder.isEngineRunning);
     (void)setGetStatus(decoder.getStatus);
@@ -98,6 +101,12 @@ decoder_builder_t& decoder_builder_t::setSetEndTeeth(decoder_t::setEndTeeth_t se
     return *this;
 }
 
+decoder_builder_t& decoder_builder_t::setGetToothAngle(decoder_t::getToothAngle_t getToothAngle)
+{
+    _decoder.getToothAngle = getToothAngle==nullptr ? &nullGetToothAngle : getToothAngle;
+    return *this;
+}
+
 decoder_builder_t& decoder_builder_t::setReset(decoder_t::reset_t reset)
 {
     _decoder.reset = reset==nullptr ? &nullTriggerHandler : reset;
@@ -25,6 +25,7 @@ struct decoder_builder_t {
   decoder_builder_t& setGetRPM(decoder_t::getRPM_t getRPM);
   decoder_builder_t& setGetCrankAngle(decoder_t::getCrankAngle_t getCrankAngle);
   decoder_builder_t& setSetEndTeeth(decoder_t::setEndTeeth_t setEndTeeth);
+  decoder_builder_t& setGetToothAngle(decoder_t::getToothAngle_t getToothAngle);
   decoder_builder_t& setReset(decoder_t::reset_t reset);
   decoder_builder_t& setIsEngineRunning(decoder_t::engine_running_t isRunning);
   decoder_builder_t& setGetStatus(decoder_t::status_fun_t getStatus);
@@ -51,6 +51,12 @@ struct interrupt_t
   boardInputPin_t _pin;
 };
 
+/** @brief A crank angle expressed as a decoder tooth plus the degrees after it */
+struct toothAngle_t {
+  uint16_t tooth;     ///< Decoder tooth number, as passed to the per tooth timing. 0 if not set
+  uint16_t residual;  ///< Crank degrees from the tooth to the angle
+};
+
 /** \enum SyncStatus
  * @brief The decoder trigger status
  * */
@@ -118,6 +124,21 @@ struct decoder_t
   setEndTeeth_t setEndTeeth;
   /// @}
 
+  /// @{
+  /**
+   * @brief The function to place a crank angle against the last tooth before it
+   * 
+   * The tooth is numbered as the primary trigger passes it to the per tooth timing,
+   * so a schedule registered against it is set by the trigger ISR. See setScheduleAtTooth()
+   * 
+   * @param angle Crank angle (degrees)
+   * @param maxAngle Length of the event cycle (degrees). E.g. CRANK_ANGLE_MAX_INJ
+   * @return The tooth is 0 if the decoder can't place the angle
+   */
+  using getToothAngle_t = toothAngle_t(*)(int16_t angle, uint16_t maxAngle);
+  getToothAngle_t getToothAngle;
+  /// @}
+
   /// @{
   /** @brief The function to reset the decoder. Called when the engine is stopped, or when the engine is started */
   using reset_t = void(*)(void);
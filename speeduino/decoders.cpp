@@ -40,12 +40,13 @@ A full copy of the license may be found in the projects root directory
 #include "crankMaths.h"
 #include "timers.h"
 #include "unit_testing.h"
-#include "atomic.h"
+#include "atomic_profile.h"
 #include "decoder_init.h"
 #include "decoder_builder.h"
 #include "scheduledIO_ign.h"
 #include "src/pins/boardInputPin.h"
 #include "scheduler_ignition_controller.h"
+#include "scheduler_fuel_controller.h"
 
 #define CRANK_ANGLE_MAX (max(CRANK_ANGLE_MAX_IGN, CRANK_ANGLE_MAX_INJ))
 
@@ -62,7 +63,7 @@ static volatile unsigned long lastGap;
 static volatile unsigned long targetGap;
 
 TESTABLE_STATIC unsigned long MAX_STALL_TIME = MICROS_PER_SEC/2U; //The maximum time (in uS) that the system will continue to function before the engine is considered stalled/stopped. This is unique to each decoder, depending on the number of teeth etc. 500000 (half a second) is used as the default value, most decoders will be much less.
-TESTABLE_STATIC uint16_t toothCurrentCount = 0; //The current number of teeth (Once sync has been achieved, this can never actually be 0
+TESTABLE_STATIC volatile uint16_t toothCurrentCount = 0; //The current number of teeth (Once sync has been achieved, this can never actually be 0
 TESTABLE_STATIC volatile byte toothSystemCount = 0; //Used for decoders such as Audi 135 where not every tooth is used for calculating crank angle. This variable stores the actual number of teeth, not the number being used to calculate crank angle
 TESTABLE_STATIC volatile unsigned long toothSystemLastToothTime = 0; //As below, but used for decoders where not every tooth count is used for calculation
 TESTABLE_STATIC volatile unsigned long toothLastToothTime = 0; //The time (micros()) that the last tooth was registered
@@ -98,6 +99,55 @@ static int16_t toothAngles[24]; //An array for storing fixed tooth angles. Curre
 
 TESTABLE_STATIC decoder_status_t decoderStatus;
 
+/*
+Lock free (seqlock style) reads of the tooth timing state by the main loop.
+The trigger ISRs increment toothStateSequence after changing the state in toothSnapshot_t. An ISR always
+runs to completion before the main loop resumes, so if the sequence is unchanged across a read of the
+state, no ISR ran part way through the read & the copy is consistent. Otherwise the read is retried.
+This keeps the main loop from delaying the trigger ISRs, unlike disabling interrupts around the reads.
+*/
+static volatile uint8_t toothStateSequence;
+
+/** @brief A consistent copy of the tooth timing state written by the trigger ISRs */
+struct toothSnapshot_t {
+  uint32_t toothLastToothTime;
+  uint32_t toothLastMinusOneToothTime;
+  uint32_t toothOneTime;
+  uint32_t toothOneMinusOneTime;
+  uint16_t toothCurrentCount;
+  bool revolutionOne;
+};
+
+/** @brief Call from an ISR after changing any of the state in toothSnapshot_t */
+static inline void publishToothState(void)
+{
+  toothStateSequence = toothStateSequence + 1U;
+}
+
+static inline void setToothOneTime(unsigned long time)
+{
+  toothOneMinusOneTime = toothOneTime;
+  toothOneTime = time;
+  publishToothState();
+}
+
+static toothSnapshot_t getToothSnapshot(void)
+{
+  toothSnapshot_t snapshot;
+  uint8_t sequence;
+  do
+  {
+    sequence = toothStateSequence;
+    snapshot.toothLastToothTime = toothLastToothTime;
+    snapshot.toothLastMinusOneToothTime = toothLastMinusOneToothTime;
+    snapshot.toothOneTime = toothOneTime;
+    snapshot.toothOneMinusOneTime = toothOneMinusOneTime;
+    snapshot.toothCurrentCount = toothCurrentCount;
+    snapshot.revolutionOne = revolutionOne;
+  } while (sequence != toothStateSequence);
+  return snapshot;
+}
+
 #ifdef USE_LIBDIVIDE
 #include <libdivide.h>
 static libdivide::libdivide_s16_t divTriggerToothAngle;
@@ -292,7 +342,7 @@ void loggerTertiaryISR(void)
 static decoder_status_t sharedGetStatus(void) noexcept
 {
   // NOTE: we are deliberately returning a copy of the struct to avoid read tearing since it's written to within interrupts
-  ATOMIC() {
+  ATOMIC_PROFILED(ATOMIC_SITE_DECODER) {
     return decoderStatus;
   }
   return decoderStatus; // Never reached, just to avoid compiler warning
@@ -317,6 +367,17 @@ static uint16_t timeToAngleIntervalTooth(uint32_t time)
     }
 }
 
+/** @brief As angleToTime(), but based on the gap between the 2 most recent teeth. Only call from the primary trigger ISR. */
+static uint32_t angleToTimeIntervalTooth(uint16_t angle)
+{
+  if(decoderStatus.toothAngleIsCorrect)
+  {
+    return ((uint32_t)angle * (toothLastToothTime - toothLastMinusOneToothTime)) / triggerToothAngle;
+  }
+  //The last gap wasn't a regular tooth gap. E.g. it spanned the missing teeth
+  return angleToTime(angle);
+}
+
 static inline bool IsCranking(const statuses &status) {
   return (status.RPM < status.crankRPM) && (status.startRevolutions == 0U);
 }
@@ -325,7 +386,7 @@ TESTABLE_STATIC bool sharedEngineIsRunning(uint32_t curTime) {
   // Check how long ago the last tooth was seen compared to now. 
   // If it was more than MAX_STALL_TIME then the engine is probably stopped. 
   uint32_t lastToothTime = 0U;
-  ATOMIC() {
+  ATOMIC_PROFILED(ATOMIC_SITE_DECODER) {
     lastToothTime = toothLastToothTime;
   }
 
@@ -366,16 +427,13 @@ TESTABLE_STATIC __attribute__((noinline)) bool SetRevolutionTime(uint32_t revTim
 }
 
 static bool UpdateRevolutionTimeFromTeeth(bool isCamTeeth) {
-  noInterrupts();
-  bool updatedRevTime = decoderStatus.syncStatus!=SyncStatus::None 
+  toothSnapshot_t teeth = getToothSnapshot();
+  return decoderStatus.syncStatus!=SyncStatus::None 
     && !IsCranking(currentStatus)
-    && (toothOneMinusOneTime!=UINT32_C(0))
-    && (toothOneTime>toothOneMinusOneTime) 
+    && (teeth.toothOneMinusOneTime!=UINT32_C(0))
+    && (teeth.toothOneTime>teeth.toothOneMinusOneTime) 
     //The time in uS that one revolution would take at current speed (The time tooth 1 was last seen, minus the time it was seen prior to that)
-    && SetRevolutionTime((toothOneTime - toothOneMinusOneTime) >> (isCamTeeth ? 1U : 0U)); 
-
-  interrupts();
- return updatedRevTime;  
+    && SetRevolutionTime((teeth.toothOneTime - teeth.toothOneMinusOneTime) >> (isCamTeeth ? 1U : 0U)); 
 }
 
 static inline uint16_t RpmFromRevolutionTimeUs(uint32_t revTime) {
@@ -460,11 +518,21 @@ static __attribute__((noinline)) int crankingGetRPM(byte totalTeeth, bool isCamT
   return currentStatus.RPM;
 }
 
+/** @brief Set the schedule if its event is registered against the current tooth. See setScheduleAtTooth() */
+static inline void checkToothSchedule(Schedule &schedule, uint16_t currentTooth, bool allowQueuedSchedule)
+{
+  if (schedule._armTooth == currentTooth)
+  {
+    setSchedule(schedule, angleToTimeIntervalTooth(schedule._armResidual), schedule._armDuration, allowQueuedSchedule);
+  }
+}
+
 /**
 On decoders that are enabled for per tooth based timing adjustments, this function performs the timer compare changes on the schedules themselves
 For each ignition channel, a check is made whether we're at the relevant tooth and whether that ignition schedule is currently running
 Only if both these conditions are met will the schedule be updated with the latest timing information.
 If it's the correct tooth, but the schedule is not yet started, calculate and an end compare value (This situation occurs when both the start and end of the ignition pulse happen after the end tooth, but before the next tooth)
+Any fuel or ignition schedule registered against this tooth is also set here.
 */
 static inline void checkPerToothTiming(int16_t crankAngle, uint16_t currentTooth)
 {
@@ -516,6 +584,53 @@ static inline void checkPerToothTiming(int16_t crankAngle, uint16_t currentTooth
       adjustCrankAngle(currentStatus, ignitionSchedule8, crankAngle);
     }
 #endif
+
+    checkToothSchedule(ignitionSchedule1, currentTooth, false);
+#if IGN_CHANNELS >= 2
+    checkToothSchedule(ignitionSchedule2, currentTooth, false);
+#endif
+#if IGN_CHANNELS >= 3
+    checkToothSchedule(ignitionSchedule3, currentTooth, false);
+#endif
+#if IGN_CHANNELS >= 4
+    checkToothSchedule(ignitionSchedule4, currentTooth, false);
+#endif
+#if IGN_CHANNELS >= 5
+    checkToothSchedule(ignitionSchedule5, currentTooth, false);
+#endif
+#if IGN_CHANNELS >= 6
+    checkToothSchedule(ignitionSchedule6, currentTooth, false);
+#endif
+#if IGN_CHANNELS >= 7
+    checkToothSchedule(ignitionSchedule7, currentTooth, false);
+#endif
+#if IGN_CHANNELS >= 8
+    checkToothSchedule(ignitionSchedule8, currentTooth, false);
+#endif
+
+    // An injection can be queued behind the running one: the delay is at most a few teeth
+    checkToothSchedule(fuelSchedule1, currentTooth, true);
+#if INJ_CHANNELS >= 2
+    checkToothSchedule(fuelSchedule2, currentTooth, true);
+#endif
+#if INJ_CHANNELS >= 3
+    checkToothSchedule(fuelSchedule3, currentTooth, true);
+#endif
+#if INJ_CHANNELS >= 4
+    checkToothSchedule(fuelSchedule4, currentTooth, true);
+#endif
+#if INJ_CHANNELS >= 5
+    checkToothSchedule(fuelSchedule5, currentTooth, true);
+#endif
+#if INJ_CHANNELS >= 6
+    checkToothSchedule(fuelSchedule6, currentTooth, true);
+#endif
+#if INJ_CHANNELS >= 7
+    checkToothSchedule(fuelSchedule7, currentTooth, true);
+#endif
+#if INJ_CHANNELS >= 8
+    checkToothSchedule(fuelSchedule8, currentTooth, true);
+#endif
   }
 }
 
@@ -596,8 +711,7 @@ static void triggerPri_missingTooth(void)
                   else { revolutionOne = 0; }
                 }
                 else {revolutionOne = !revolutionOne;} //Flip sequential revolution tracker if poll level is not used
-                toothOneMinusOneTime = toothOneTime;
-                toothOneTime = curTime;
+                setToothOneTime(curTime);
 
                 //if Sequential fuel or ignition is in use, further checks are needed before determining sync
                 if( (configPage4.sparkMode == IGN_MODE_SEQUENTIAL) || (configPage2.injLayout == INJ_SEQUENTIAL) )
@@ -638,6 +752,7 @@ static void triggerPri_missingTooth(void)
         toothLastMinusOneToothTime = toothLastToothTime;
         toothLastToothTime = curTime;
       }
+      publishToothState();
      
 
       //NEW IGNITION MODE
@@ -716,6 +831,7 @@ static void triggerSec_missingTooth(void)
         break;
     }
     toothLastSecToothTime = curTime2;
+    publishToothState(); // revolutionOne may have changed
   } //Trigger filter
 }
 
@@ -786,15 +902,11 @@ static uint16_t getRPM_missingTooth(void)
 static int16_t getCrankAngle_missingTooth(void)
 {
     //This is the current angle ATDC the engine is at. This is the last known position based on what tooth was last 'seen'. It is only accurate to the resolution of the trigger wheel (Eg 36-1 is 10 degrees)
-    unsigned long tempToothLastToothTime;
-    int tempToothCurrentCount;
-    bool tempRevolutionOne;
-    //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempRevolutionOne = revolutionOne;
-    tempToothLastToothTime = toothLastToothTime;
-    interrupts();
+    //Grab a consistent copy of the variables that are used in the trigger code.
+    toothSnapshot_t teeth = getToothSnapshot();
+    int tempToothCurrentCount = teeth.toothCurrentCount;
+    bool tempRevolutionOne = teeth.revolutionOne;
+    unsigned long tempToothLastToothTime = teeth.toothLastToothTime;
 
     int crankAngle = ((tempToothCurrentCount - 1) * triggerToothAngle) + configPage4.triggerAngle; //Number of teeth that have passed since tooth 1, multiplied by the angle each tooth represents, plus the angle that tooth 1 is ATDC. This gives accuracy only to the nearest tooth.
     
@@ -836,32 +948,74 @@ static uint16_t __attribute__((noinline)) calcEndTeeth_missingTooth(const Igniti
   return clampToActualTeeth(clampToToothCount(tempEndTooth, toothAdder), toothAdder);
 }
 
+/**
+ * @brief Place a crank angle against the last tooth before it, as numbered by triggerPri_missingTooth.
+ * 
+ * @return The tooth & residual angle. The tooth is 0 if per tooth timing is off, or the teeth don't map onto the event cycle.
+ */
+TESTABLE_STATIC toothAngle_t getToothAngle_missingTooth(int16_t angle, uint16_t maxAngle) {
+  // The primary trigger only runs the per tooth timing if it is on. It only numbers the 2nd revolution on from the 1st when sequential
+  if (!configPage2.perToothIgn) { return toothAngle_t{ 0U, 0U }; }
+  uint8_t toothAdder = 0;
+  if( (configPage4.sparkMode == IGN_MODE_SEQUENTIAL) && (configPage4.TrigSpeed == CRANK_SPEED) && (configPage2.strokes == FOUR_STROKE) ) { toothAdder = configPage4.triggerTeeth; }
+
+  const uint16_t cycleTeeth = (uint16_t)configPage4.triggerTeeth + toothAdder;
+  // E.g. a 360° wheel with 720° events (no cam sync), or a tooth angle that doesn't divide 360
+  if ((cycleTeeth * triggerToothAngle) != maxAngle) { return toothAngle_t{ 0U, 0U }; }
+
+  // Angle after tooth #1, in (0, maxAngle]. An event on a tooth belongs to the previous tooth.
+  angle = angle - configPage4.triggerAngle;
+  while (angle <= 0) { angle += (int16_t)maxAngle; }
+  while (angle > (int16_t)maxAngle) { angle -= (int16_t)maxAngle; }
+
+  uint16_t toothIndex = (uint16_t)(angle - 1) / triggerToothAngle; // Zero based
+  uint16_t residual = (uint16_t)angle - (toothIndex * triggerToothAngle);
+
+  // Step back over any missing teeth
+  uint16_t revolutionTooth = (toothIndex % configPage4.triggerTeeth) + 1U;
+  if (revolutionTooth > triggerActualTeeth)
+  {
+    uint16_t missing = revolutionTooth - triggerActualTeeth;
+    toothIndex = toothIndex - missing;
+    residual = residual + (missing * triggerToothAngle);
+  }
+  return toothAngle_t{ (uint16_t)(toothIndex + 1U), residual };
+}
+
 static void triggerSetEndTeeth_missingTooth(void)
 {
   uint8_t toothAdder = 0;
   if( ((configPage4.sparkMode == IGN_MODE_SEQUENTIAL) || (configPage4.sparkMode == IGN_MODE_SINGLE)) && (configPage4.TrigSpeed == CRANK_SPEED) && (configPage2.strokes == FOUR_STROKE) ) { toothAdder = configPage4.triggerTeeth; }
 
   ignitionEndTeeth[0] = calcEndTeeth_missingTooth(ignitionSchedule1, toothAdder);
+  ignitionSchedule1.chargeTooth = getToothAngle_missingTooth(ignitionSchedule1.chargeAngle, CRANK_ANGLE_MAX_IGN);
 #if (IGN_CHANNELS >= 2)
   ignitionEndTeeth[1] = calcEndTeeth_missingTooth(ignitionSchedule2, toothAdder);
+  ignitionSchedule2.chargeTooth = getToothAngle_missingTooth(ignitionSchedule2.chargeAngle, CRANK_ANGLE_MAX_IGN);
 #endif
 #if (IGN_CHANNELS >= 3)
   ignitionEndTeeth[2] = calcEndTeeth_missingTooth(ignitionSchedule3, toothAdder);
+  ignitionSchedule3.chargeTooth = getToothAngle_missingTooth(ignitionSchedule3.chargeAngle, CRANK_ANGLE_MAX_IGN);
 #endif
 #if (IGN_CHANNELS >= 4)
   ignitionEndTeeth[3] = calcEndTeeth_missingTooth(ignitionSchedule4, toothAdder);
+  ignitionSchedule4.chargeTooth = getToothAngle_missingTooth(ignitionSchedule4.chargeAngle, CRANK_ANGLE_MAX_IGN);
 #endif
 #if IGN_CHANNELS >= 5
   ignitionEndTeeth[4] = calcEndTeeth_missingTooth(ignitionSchedule5, toothAdder);
+  ignitionSchedule5.chargeTooth = getToothAngle_missingTooth(ignitionSchedule5.chargeAngle, CRANK_ANGLE_MAX_IGN);
 #endif
 #if IGN_CHANNELS >= 6
   ignitionEndTeeth[5] = calcEndTeeth_missingTooth(ignitionSchedule6, toothAdder);
+  ignitionSchedule6.chargeTooth = getToothAngle_missingTooth(ignitionSchedule6.chargeAngle, CRANK_ANGLE_MAX_IGN);
 #endif
 #if IGN_CHANNELS >= 7
   ignitionEndTeeth[6] = calcEndTeeth_missingTooth(ignitionSchedule7, toothAdder);
+  ignitionSchedule7.chargeTooth = getToothAngle_missingTooth(ignitionSchedule7.chargeAngle, CRANK_ANGLE_MAX_IGN);
 #endif
 #if IGN_CHANNELS >= 8
   ignitionEndTeeth[7] = calcEndTeeth_missingTooth(ignitionSchedule8, toothAdder);
+  ignitionSchedule8.chargeTooth = getToothAngle_missingTooth(ignitionSchedule8.chargeAngle, CRANK_ANGLE_MAX_IGN);
 #endif
 }
 
@@ -909,6 +1063,7 @@ decoder_t __attribute__((optimize("Os"))) triggerSetup_missingTooth(void)
                   .setGetRPM(getRPM_missingTooth)
                   .setGetCrankAngle(getCrankAngle_missingTooth)
                   .setSetEndTeeth(triggerSetEndTeeth_missingTooth)
+                  .setGetToothAngle(getToothAngle_missingTooth)
                   .setReset(sharedDecoderReset)
                   .setIsEngineRunning(sharedEngineIsRunning)
                   .setGetStatus(sharedGetStatus)
@@ -944,8 +1099,7 @@ static void triggerPri_DualWheel(void)
         {
           toothCurrentCount = 1;
           revolutionOne = !revolutionOne; //Flip sequential revolution tracker
-          toothOneMinusOneTime = toothOneTime;
-          toothOneTime = curTime;
+          setToothOneTime(curTime);
           currentStatus.startRevolutions++; //Counter
           if ( configPage4.TrigSpeed == CAM_SPEED ) { currentStatus.startRevolutions++; } //Add an extra revolution count if we're running at cam speed
         }
@@ -1150,8 +1304,7 @@ static void triggerPri_BasicDistributor(void)
     if( (toothCurrentCount == triggerActualTeeth) || (decoderStatus.syncStatus!=SyncStatus::Full) ) //Check if we're back to the beginning of a revolution
     {
       toothCurrentCount = 1; //Reset the counter
-      toothOneMinusOneTime = toothOneTime;
-      toothOneTime = curTime;
+      setToothOneTime(curTime);
       decoderStatus.syncStatus = SyncStatus::Full;
       currentStatus.startRevolutions++; //Counter
     }
@@ -1361,8 +1514,7 @@ static void triggerPri_GM7X(void)
       if( toothCurrentCount > 7 )
       {
         toothCurrentCount = 1;
-        toothOneMinusOneTime = toothOneTime;
-        toothOneTime = curTime;
+        setToothOneTime(curTime);
 
         decoderStatus.toothAngleIsCorrect = true;
       }
@@ -1511,8 +1663,7 @@ static void triggerPri_4G63(void)
     if( (toothCurrentCount == 1) || (toothCurrentCount > triggerActualTeeth) ) //Trigger is on CHANGE, hence 4 pulses = 1 crank rev (or 6 pulses for 6 cylinders)
     {
        toothCurrentCount = 1; //Reset the counter
-       toothOneMinusOneTime = toothOneTime;
-       toothOneTime = curTime;
+       setToothOneTime(curTime);
        currentStatus.startRevolutions++; //Counter
     }
 
@@ -1936,8 +2087,7 @@ static void triggerPri_24X(void)
     if(toothCurrentCount == 0)
     {
        toothCurrentCount = 1; //Reset the counter
-       toothOneMinusOneTime = toothOneTime;
-       toothOneTime = curTime;
+       setToothOneTime(curTime);
        revolutionOne = !revolutionOne; //Sequential revolution flip
        decoderStatus.syncStatus = SyncStatus::Full;
        currentStatus.startRevolutions++; //Counter
@@ -2065,8 +2215,7 @@ static void triggerPri_Jeep2000(void)
       if(toothCurrentCount == 0)
       {
          toothCurrentCount = 1; //Reset the counter
-         toothOneMinusOneTime = toothOneTime;
-         toothOneTime = curTime;
+         setToothOneTime(curTime);
          decoderStatus.syncStatus = SyncStatus::Full;
          currentStatus.startRevolutions++; //Counter
          triggerToothAngle = 60; //There are groups of 4 pulses (Each 20 degrees apart), with each group being 60 degrees apart. Hence #1 is always 60
@@ -2187,8 +2336,7 @@ static void triggerPri_Audi135(void)
          if ( (toothCurrentCount == 1) || (toothCurrentCount > 45) )
          {
            toothCurrentCount = 1;
-           toothOneMinusOneTime = toothOneTime;
-           toothOneTime = curTime;
+           setToothOneTime(curTime);
            revolutionOne = !revolutionOne;
            currentStatus.startRevolutions++; //Counter
          }
@@ -2305,8 +2453,7 @@ static void triggerPri_HondaD17(void)
    }
    else if( (toothCurrentCount == 1) && (decoderStatus.syncStatus==SyncStatus::Full) )
    {
-     toothOneMinusOneTime = toothOneTime;
-     toothOneTime = curTime;
+     setToothOneTime(curTime);
      currentStatus.startRevolutions++; //Counter
 
      toothLastMinusOneToothTime = toothLastToothTime;
@@ -2423,8 +2570,7 @@ static void triggerPri_HondaJ32(void)
 
     if (toothCurrentCount == 25) { // handle rollover.  Normal sized tooth here
       toothCurrentCount = 1;
-      toothOneMinusOneTime = toothOneTime;
-      toothOneTime = curTime;
+      setToothOneTime(curTime);
       currentStatus.startRevolutions++;
       SetRevolutionTime(toothOneTime - toothOneMinusOneTime);
     }
@@ -2456,6 +2602,7 @@ static void triggerPri_HondaJ32(void)
         toothCurrentCount = 16;  // This so happens to be the tooth number of the first tooth in the string of 7 (where we are now)
         toothOneTime = curTime - (15 * lastGap); // Initialize tooth 1 times based on last gap width.
         toothOneMinusOneTime = toothOneTime - (24 * lastGap);
+        publishToothState();
       }
       else{ // Unclear which gap we just passed. reset counter
         toothCurrentCount = 1;
@@ -2550,8 +2697,7 @@ static void triggerPri_Miata9905(void)
     if( (toothCurrentCount == (triggerActualTeeth + 1)) )
     {
        toothCurrentCount = 1; //Reset the counter
-       toothOneMinusOneTime = toothOneTime;
-       toothOneTime = curTime;
+       setToothOneTime(curTime);
        currentStatus.startRevolutions++; //Counter
     }
     else
@@ -2832,8 +2978,7 @@ static void triggerPri_MazdaAU(void)
     if( (toothCurrentCount == 1) || (toothCurrentCount == 5) ) //Trigger is on CHANGE, hence 4 pulses = 1 crank rev
     {
        toothCurrentCount = 1; //Reset the counter
-       toothOneMinusOneTime = toothOneTime;
-       toothOneTime = curTime;
+       setToothOneTime(curTime);
        decoderStatus.syncStatus = SyncStatus::Full;
        currentStatus.startRevolutions++; //Counter
     }
@@ -3062,8 +3207,7 @@ static void triggerPri_Nissan360(void)
      if ( toothCurrentCount == 361 ) //2 complete crank revolutions
      {
        toothCurrentCount = 1;
-       toothOneMinusOneTime = toothOneTime;
-       toothOneTime = curTime;
+       setToothOneTime(curTime);
        currentStatus.startRevolutions++; //Counter
      }
      //Recalc the new filter value
@@ -3379,8 +3523,7 @@ static void triggerPri_Subaru67(void)
     if ( toothCurrentCount > 12 ) // done 720 degrees so increment rotation
     {
       toothCurrentCount = 1;
-      toothOneMinusOneTime = toothOneTime;
-      toothOneTime = curTime;
+      setToothOneTime(curTime);
       currentStatus.startRevolutions++; //Counter
     }
 
@@ -3590,8 +3733,7 @@ static void triggerPri_Daihatsu(void)
       if( (toothCurrentCount == triggerActualTeeth) ) //Check if we're back to the beginning of a revolution
       {
          toothCurrentCount = 1; //Reset the counter
-         toothOneMinusOneTime = toothOneTime;
-         toothOneTime = curTime;
+         setToothOneTime(curTime);
          decoderStatus.syncStatus = SyncStatus::Full;
          currentStatus.startRevolutions++; //Counter
 
@@ -3760,8 +3902,7 @@ static void triggerPri_Harley(void)
         {
           toothCurrentCount = 1;
           triggerToothAngle = 0;// Has to be equal to Angle Routine
-          toothOneMinusOneTime = toothOneTime;
-          toothOneTime = curTime;
+          setToothOneTime(curTime);
           decoderStatus.syncStatus = SyncStatus::Full;
         }
         else
@@ -3928,8 +4069,7 @@ static void triggerPri_ThirtySixMinus222(void)
          //Means a complete rotation has occurred.
          toothCurrentCount = 1;
          revolutionOne = !revolutionOne; //Flip sequential revolution tracker
-         toothOneMinusOneTime = toothOneTime;
-         toothOneTime = curTime;
+         setToothOneTime(curTime);
          currentStatus.startRevolutions++; //Counter
 
        }
@@ -4102,8 +4242,7 @@ static void triggerPri_ThirtySixMinus21(void)
          //Means a complete rotation has occurred.
          toothCurrentCount = 1;
          revolutionOne = !revolutionOne; //Flip sequential revolution tracker
-         toothOneMinusOneTime = toothOneTime;
-         toothOneTime = curTime;
+         setToothOneTime(curTime);
          currentStatus.startRevolutions++; //Counter
 
        }
@@ -4206,8 +4345,7 @@ static void triggerPri_420a(void)
     {
       //Means a complete rotation has occurred.
       toothCurrentCount = 1;
-      toothOneMinusOneTime = toothOneTime;
-      toothOneTime = curTime;
+      setToothOneTime(curTime);
       currentStatus.startRevolutions++; //Counter
     }
 
@@ -4401,8 +4539,7 @@ static void triggerPri_Webber(void)
       {
         toothCurrentCount = 1;
         revolutionOne = !revolutionOne; //Flip sequential revolution tracker
-        toothOneMinusOneTime = toothOneTime;
-        toothOneTime = curTime;
+        setToothOneTime(curTime);
         currentStatus.startRevolutions++; //Counter
       }
 
@@ -4746,8 +4883,7 @@ static void triggerPri_NGC(void)
             //Just passed the HIGH missing tooth
             toothCurrentCount = 1;
 
-            toothOneMinusOneTime = toothOneTime;
-            toothOneTime = curTime;
+            setToothOneTime(curTime);
 
             if (decoderStatus.syncStatus==SyncStatus::Full) { currentStatus.startRevolutions++; }
             else { currentStatus.startRevolutions = 0; }
@@ -5083,8 +5219,7 @@ static void triggerPri_Vmax(void)
           {
             secondaryToothCount = 1;
             triggerToothAngle = 70;// Has to be equal to Angle Routine, and describe the delta between two teeth.
-            toothOneMinusOneTime = toothOneTime;
-            toothOneTime = curTime;
+            setToothOneTime(curTime);
             decoderStatus.syncStatus = SyncStatus::Full;
             //setFilter((curGap/1.75));//Angle to this tooth is 70, next is in 40, compensating.
             setFilter( ((curGap*4)/7) );//Angle to this tooth is 70, next is in 40, compensating.
@@ -5312,8 +5447,7 @@ static void triggerPri_Renix(void)
       if( (configPage2.nCylinders == 6 && toothCurrentCount == 7) ||    // 6 Pretend teeth on the 66 tooth wheel, if get to severn rotate round back to first tooth
           (configPage2.nCylinders == 4 && toothCurrentCount == 5 ) )    // 4 Pretend teeth on the 44 tooth wheel, if get to five rotate round back to first tooth
       {
-        toothOneMinusOneTime = toothOneTime;
-        toothOneTime = curTime;
+        setToothOneTime(curTime);
         decoderStatus.syncStatus = SyncStatus::Full;
         currentStatus.startRevolutions++; //Counter               
         revolutionOne = !revolutionOne;
@@ -5581,8 +5715,7 @@ static void triggerRoverMEMSCommon(void)
   if( toothCurrentCount > 18) 
   {
     toothCurrentCount = 1;
-    toothOneMinusOneTime = toothOneTime;
-    toothOneTime = curTime;
+    setToothOneTime(curTime);
     revolutionOne = !revolutionOne; //Flip sequential revolution tracker   
   }
 
@@ -5837,8 +5970,7 @@ static void triggerPri_SuzukiK6A(void)
     {
       // seen enough teeth to have a revolution of the crank
       toothCurrentCount = 1; //Reset the counter
-      toothOneMinusOneTime = toothOneTime;
-      toothOneTime = curTime;
+      setToothOneTime(curTime);
       currentStatus.startRevolutions = currentStatus.startRevolutions + 2U; // increment for 2 revs as we do 720 degrees on the the crank       
     }
     else if (toothCurrentCount > (triggerActualTeeth + 1U))
@@ -6167,8 +6299,7 @@ static void triggerPri_FordTFI(void)
         currentStatus.syncLossCounter++;
       }
       toothCurrentCount = 1; //Reset the counter
-      toothOneMinusOneTime = toothOneTime;
-      toothOneTime = curTime;
+      setToothOneTime(curTime);
       currentStatus.startRevolutions++; //Counter
     }
 
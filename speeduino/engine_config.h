@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Optional compile time engine configuration.
+ *
+ * Normally the cylinder count, injector layout and spark mode are read from the tune
+ * every time the fuel & ignition schedulers run. For a known engine (E.g. a fleet of
+ * identical vehicles) they can be fixed at compile time by defining *all* of:
+ *  - FIXED_ENGINE_CYLINDERS (1-8)
+ *  - FIXED_ENGINE_INJ_LAYOUT (E.g. INJ_SEQUENTIAL)
+ *  - FIXED_ENGINE_SPARK_MODE (E.g. IGN_MODE_WASTEDCOP)
+ *
+ * The accessors below then return compile time constants & the optimizer removes the
+ * dead branches (E.g. rotary ignition, sync state switching). INJ_CHANNELS & IGN_CHANNELS
+ * should also be set to the number of outputs the engine uses, so unused channels are
+ * removed from the scheduler loops. See the megaatmega2560-fixed-4cyl PlatformIO environment.
+ *
+ * @note The tune values are overwritten with the fixed values during initialisation, so
+ * TunerStudio will show (and burn) the fixed values.
+ */
+
+#include "config_pages.h"
+
+#if defined(FIXED_ENGINE_CYLINDERS) || defined(FIXED_ENGINE_INJ_LAYOUT) || defined(FIXED_ENGINE_SPARK_MODE)
+#if !defined(FIXED_ENGINE_CYLINDERS) || !defined(FIXED_ENGINE_INJ_LAYOUT) || !defined(FIXED_ENGINE_SPARK_MODE)
+#error "FIXED_ENGINE_CYLINDERS, FIXED_ENGINE_INJ_LAYOUT and FIXED_ENGINE_SPARK_MODE must all be defined"
+#endif
+#define FIXED_ENGINE_CONFIG
+static_assert(FIXED_ENGINE_CYLINDERS>=1 && FIXED_ENGINE_CYLINDERS<=8, "FIXED_ENGINE_CYLINDERS must be 1-8");
+#endif
+
+/** @brief Number of cylinders (see @ref config2.nCylinders) */
+static inline uint8_t getEngineCylinders(const config2 &page2) {
+#if defined(FIXED_ENGINE_CONFIG)
+  (void)page2;
+  return FIXED_ENGINE_CYLINDERS;
+#else
+  return page2.nCylinders;
+#endif
+}
+
+/** @brief Configured injector layout (see @ref config2.injLayout) */
+static inline uint8_t getEngineInjLayout(const config2 &page2) {
+#if defined(FIXED_ENGINE_CONFIG)
+  (void)page2;
+  return FIXED_ENGINE_INJ_LAYOUT;
+#else
+  return page2.injLayout;
+#endif
+}
+
+/** @brief Configured spark mode (see @ref config4.sparkMode) */
+static inline uint8_t getEngineSparkMode(const config4 &page4) {
+#if defined(FIXED_ENGINE_CONFIG)
+  (void)page4;
+  return FIXED_ENGINE_SPARK_MODE;
+#else
+  return page4.sparkMode;
+#endif
+}
+
+/** @brief Overwrite the tune values with the compile time configuration (if any) */
+static inline void applyFixedEngineConfig(config2 &page2, config4 &page4) {
+#if defined(FIXED_ENGINE_CONFIG)
+  page2.nCylinders = FIXED_ENGINE_CYLINDERS;
+  page2.injLayout = FIXED_ENGINE_INJ_LAYOUT;
+  page4.sparkMode = FIXED_ENGINE_SPARK_MODE;
+#else
+  (void)page2;
+  (void)page4;
+#endif
+}
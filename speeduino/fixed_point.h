@@ -0,0 +1,204 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Q format fixed point arithmetic.
+ *
+ * @see https://en.wikipedia.org/wiki/Q_(number_format)
+ *
+ * A fixed point number is an integer (the *raw* value) with an implied binary
+ * point FRACTIONAL_BITS from the right. E.g. in UQ8.8 the raw value 0x0180 is 1.5.
+ *
+ * All arithmetic operators saturate, rather than wrap, on overflow. The
+ * underlying instruction sequence is chosen at compile time based on the
+ * storage type:
+ *  - addition & subtraction use the carry/overflow flag via __builtin_add_overflow() and
+ *    __builtin_sub_overflow() (a single extra branch on both AVR & ARM). No type promotion is required.
+ *  - multiplication promotes to the next widest integer type only, and uses avr-fast-shift
+ *    for the 32-bit rounding shift.
+ *  - mulUnit() is available for the common case of multiplying two values in the range [0, 1]
+ *    without type promotion.
+ */
+
+#include <stdint.h>
+#include <avr-fast-shift.h>
+
+/// @cond
+namespace _fixed_point_detail {
+
+  template <typename TStorage, typename TWide, TStorage maxValue>
+  struct unsigned_traits {
+    using wide_t = TWide;
+    static constexpr TStorage MIN = 0U;
+    static constexpr TStorage MAX = maxValue;
+    static inline TStorage saturate(wide_t value) {
+      return value>(wide_t)MAX ? MAX : (TStorage)value;
+    }
+  };
+
+  template <typename TStorage, typename TWide, TStorage minValue, TStorage maxValue>
+  struct signed_traits {
+    using wide_t = TWide;
+    static constexpr TStorage MIN = minValue;
+    static constexpr TStorage MAX = maxValue;
+    static inline TStorage saturate(wide_t value) {
+      return value>(wide_t)MAX ? MAX : value<(wide_t)MIN ? MIN : (TStorage)value;
+    }
+  };
+
+  template <typename TStorage> struct storage_traits;
+  template <> struct storage_traits<uint8_t> : unsigned_traits<uint8_t, uint16_t, UINT8_MAX> { };
+  template <> struct storage_traits<uint16_t> : unsigned_traits<uint16_t, uint32_t, UINT16_MAX> { };
+  template <> struct storage_traits<uint32_t> : unsigned_traits<uint32_t, uint64_t, UINT32_MAX> { };
+  template <> struct storage_traits<int8_t> : signed_traits<int8_t, int16_t, INT8_MIN, INT8_MAX> { };
+  template <> struct storage_traits<int16_t> : signed_traits<int16_t, int32_t, INT16_MIN, INT16_MAX> { };
+  template <> struct storage_traits<int32_t> : signed_traits<int32_t, int64_t, INT32_MIN, INT32_MAX> { };
+
+  // Right shift, rounding to nearest (0.5 rounds up)
+  template <uint8_t b, typename T>
+  static inline T shift_round(T value) {
+    return (T)((T)(value + (T)((T)1U<<(b-1U))) >> b);
+  }
+  // 32-bit unsigned shifts are slow on AVR unless we use avr-fast-shift
+  template <uint8_t b>
+  static inline uint32_t shift_round(uint32_t value) {
+    return rshift<b>((uint32_t)(value + (UINT32_C(1)<<(b-1U))));
+  }
+}
+/// @endcond
+
+/**
+ * @brief A Q format fixed point number.
+ *
+ * @tparam TStorage The underlying integer type. Signed types give a signed fixed point type.
+ * @tparam fracBits Number of fractional bits. The remaining bits (including any sign bit) are the integer part.
+ */
+template <typename TStorage, uint8_t fracBits>
+class fixed_point_t {
+  using traits_t = _fixed_point_detail::storage_traits<TStorage>;
+
+public:
+  static_assert(fracBits>0U && fracBits<(sizeof(TStorage)*8U), "Fractional bits must fit within the storage type");
+
+  /** @brief The underlying integer type */
+  using storage_t = TStorage;
+  /** @brief The promoted type used for intermediate results. */
+  using wide_t = typename traits_t::wide_t;
+
+  /** @brief Number of fractional bits */
+  static constexpr uint8_t FRACTIONAL_BITS = fracBits;
+  /** @brief Number of integer bits (including the sign bit, if any) */
+  static constexpr uint8_t INTEGER_BITS = (uint8_t)((sizeof(TStorage)*8U) - fracBits);
+  /** @brief Raw value of 1.0 - note this may not be representable in storage_t (E.g. Q1.15) */
+  static constexpr wide_t RAW_ONE = (wide_t)((wide_t)1U << fracBits);
+  /** @brief Raw value of 0.5 */
+  static constexpr TStorage RAW_HALF = (TStorage)(RAW_ONE/2U);
+
+  constexpr fixed_point_t(void) : _raw(0) { }
+
+  /** @brief Construct from a raw (already scaled) value */
+  static constexpr fixed_point_t fromRaw(TStorage raw) {
+    return fixed_point_t(raw);
+  }
+  /** @brief Construct from an integer. The caller must ensure value is in range */
+  static constexpr fixed_point_t fromInteger(TStorage value) {
+    return fixed_point_t((TStorage)(value * RAW_ONE));
+  }
+  /** @brief The maximum representable value */
+  static constexpr fixed_point_t max(void) {
+    return fixed_point_t(traits_t::MAX);
+  }
+  /** @brief The minimum representable value */
+  static constexpr fixed_point_t min(void) {
+    return fixed_point_t(traits_t::MIN);
+  }
+
+  /** @brief The raw (scaled) value */
+  constexpr TStorage raw(void) const {
+    return _raw;
+  }
+  /** @brief Convert to an integer, truncating (rounding towards negative infinity) */
+  constexpr TStorage toInteger(void) const {
+    return (TStorage)(_raw >> fracBits);
+  }
+  /** @brief Convert to an integer, rounding to the nearest integer */
+  TStorage toIntegerRounded(void) const {
+    return (TStorage)_fixed_point_detail::shift_round<fracBits>((wide_t)_raw);
+  }
+
+  /**
+   * @brief Apply this value as a multiplier to an integer. E.g. 0.5 * 300 == 150
+   *
+   * This is the fixed point equivalent of a percentage calculation. The result is rounded.
+   *
+   * @warning For performance, the product is computed in TInt *without* promotion or saturation.
+   * The caller must ensure value * raw() fits within TInt.
+   */
+  template <typename TInt>
+  TInt scale(TInt value) const {
+    static_assert(sizeof(TInt)>=sizeof(TStorage), "Integer type must be at least as wide as the storage type");
+    return _fixed_point_detail::shift_round<fracBits>((TInt)(value * (TInt)_raw));
+  }
+
+  /**
+   * @brief Multiply two values that are known to be in the range [0, 1]
+   *
+   * Since both operands are <=1, the product can only overflow the storage type
+   * when both are exactly 1. That is checked explicitly, which allows the multiplication
+   * to be performed without type promotion (E.g. 16-bit multiply on AVR instead of 32-bit).
+   */
+  static inline fixed_point_t mulUnit(const fixed_point_t &a, const fixed_point_t &b) {
+    static_assert(traits_t::MIN==0U, "mulUnit() requires an unsigned type");
+    static_assert(fracBits*2U<=(sizeof(TStorage)*8U), "mulUnit() requires at least 2x fracBits of storage");
+    if (a._raw==RAW_ONE && b._raw==RAW_ONE) {
+      return a;
+    }
+    return fixed_point_t((TStorage)((TStorage)((TStorage)(a._raw * b._raw) + RAW_HALF) >> fracBits));
+  }
+
+  /// @{
+  /// @brief Saturating arithmetic
+  friend inline fixed_point_t operator+(const fixed_point_t &a, const fixed_point_t &b) {
+    TStorage result;
+    if (__builtin_add_overflow(a._raw, b._raw, &result)) {
+      return b._raw>(TStorage)0 ? max() : min();
+    }
+    return fixed_point_t(result);
+  }
+  friend inline fixed_point_t operator-(const fixed_point_t &a, const fixed_point_t &b) {
+    TStorage result;
+    if (__builtin_sub_overflow(a._raw, b._raw, &result)) {
+      return b._raw>(TStorage)0 ? min() : max();
+    }
+    return fixed_point_t(result);
+  }
+  friend inline fixed_point_t operator*(const fixed_point_t &a, const fixed_point_t &b) {
+    wide_t product = (wide_t)((wide_t)a._raw * (wide_t)b._raw);
+    return fixed_point_t(traits_t::saturate(_fixed_point_detail::shift_round<fracBits>(product)));
+  }
+  /// @}
+
+  /// @{
+  /// @brief Comparison
+  friend constexpr bool operator==(const fixed_point_t &a, const fixed_point_t &b) { return a._raw==b._raw; }
+  friend constexpr bool operator!=(const fixed_point_t &a, const fixed_point_t &b) { return a._raw!=b._raw; }
+  friend constexpr bool operator<(const fixed_point_t &a, const fixed_point_t &b) { return a._raw<b._raw; }
+  friend constexpr bool operator<=(const fixed_point_t &a, const fixed_point_t &b) { return a._raw<=b._raw; }
+  friend constexpr bool operator>(const fixed_point_t &a, const fixed_point_t &b) { return a._raw>b._raw; }
+  friend constexpr bool operator>=(const fixed_point_t &a, const fixed_point_t &b) { return a._raw>=b._raw; }
+  /// @}
+
+private:
+  explicit constexpr fixed_point_t(TStorage raw) : _raw(raw) { }
+
+  TStorage _raw;
+};
+
+/** @brief Unsigned, 8 integer bits & 8 fractional bits. Range [0, 255.996] */
+using UQ8_8_t = fixed_point_t<uint16_t, 8U>;
+
+/** @brief Unsigned, 16 integer bits & 16 fractional bits. Range [0, 65535.99998] */
+using UQ16_16_t = fixed_point_t<uint32_t, 16U>;
+
+/** @brief Signed, 1 integer (sign) bit & 15 fractional bits. Range [-1, 0.99997] */
+using Q1_15_t = fixed_point_t<int16_t, 15U>;
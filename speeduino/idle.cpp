@@ -43,16 +43,16 @@ static unsigned int iacStepTime_uS;
 static unsigned int iacCoolTime_uS;
 static unsigned int completedHomeSteps;
 
-static volatile bool idle_pwm_state;
+TESTABLE_STATIC volatile bool idle_pwm_state;
 static bool lastDFCOValue;
-static uint16_t idle_pwm_max_count; //Used for variable PWM frequency
+TESTABLE_STATIC uint16_t idle_pwm_max_count; //Used for variable PWM frequency
 static volatile unsigned int idle_pwm_cur_value;
 static int32_t idle_pid_target_value;
 static int32_t FeedForwardTerm;
-static uint32_t idle_pwm_target_value;
+TESTABLE_STATIC uint32_t idle_pwm_target_value;
 static int32_t idle_cl_target_rpm;
 
-static fastOutputPin_t idle_pin;
+TESTABLE_STATIC fastOutputPin_t idle_pin;
 static fastOutputPin_t idle2_pin;
 
 constexpr table2D_u8_u8_10 iacPWMTable(&configPage6.iacBins, &configPage6.iacOLPWMVal);
@@ -90,12 +90,32 @@ static inline void initialiseIdleUpOutput(void)
   currentStatus.idleUpOutputActive = false;
 }
 
+/** @brief Stepper idle is run from the main loop, so its PID computes at most every 250ms (4Hz).
+ * PWM idle is a fixed rate task, so its PID computes on every run and the sample period is the task interval. */
+static inline uint16_t getIdlePidSampleTime(const config6 &page6)
+{
+  return isStepperIac(page6) ? 250U : IDLE_CONTROL_INTERVAL_MS;
+}
+
 static void setIdlePidTunings(const config6 &page6)
 {
-  idlePID.setTunings(PidTuningParameters(page6.idleKP, page6.idleKI, page6.idleKD), millis(), 250); //4Hz means 250ms
+  idlePID.setTunings(PidTuningParameters(page6.idleKP, page6.idleKI, page6.idleKD), millis(), getIdlePidSampleTime(page6));
   idlePID.setSetPoint(idle_cl_target_rpm);
 }
 
+/** @brief PWM idle is run as a 10Hz fixed rate task, so the PID settings are re-read every 10th run (once per second) */
+static inline bool isPwmIdlePidRetuneDue(void)
+{
+  static uint8_t pwmIdleRunCount = 0U;
+  ++pwmIdleRunCount;
+  if (pwmIdleRunCount >= 10U)
+  {
+    pwmIdleRunCount = 0U;
+    return true;
+  }
+  return false;
+}
+
 static void configureIdlePID(const config6 &page6, uint32_t minOutput, uint32_t maxOutput, uint16_t initialTarget)
 {
     idlePID.setOutputLimits(minOutput, maxOutput);
@@ -104,6 +124,55 @@ static void configureIdlePID(const config6 &page6, uint32_t minOutput, uint32_t
     idlePID.activate(currentStatus.RPM); //Turn PID on
 }
 
+/** @brief true if idleInterrupt() drives the (1st) idle output low for the duty
+ * 
+ * The 2nd idle output is always the inverse of the 1st. On Teensy 4.1 the PIT timers count down &
+ * have the opposite effect on PWM. Hardware PWM uses the same polarity, so the output is the same
+ * whether or not the pin has hardware PWM.
+ */
+TESTABLE_INLINE_STATIC bool isIdlePwmActiveLow(const config6 &page6)
+{
+#if defined(CORE_TEENSY41)
+  return page6.iacPWMdir == 0U;
+#else
+  return page6.iacPWMdir != 0U;
+#endif
+}
+
+//Start of the PWM period: drive the idle output(s) to their active state
+static inline void idlePwmOn(void)
+{
+  if (isIdlePwmActiveLow(configPage6))
+  {
+    idle_pin.setPinLow();
+    if(configPage6.iacChannels == 1) { idle2_pin.setPinHigh(); } //If 2 idle channels are in use, flip idle2 to be the opposite of idle1
+  }
+  else
+  {
+    idle_pin.setPinHigh();
+    if(configPage6.iacChannels == 1) { idle2_pin.setPinLow(); }
+  }
+}
+
+//End of the PWM pulse: drive the idle output(s) to their inactive state
+static inline void idlePwmOff(void)
+{
+  if (isIdlePwmActiveLow(configPage6))
+  {
+    idle_pin.setPinHigh();
+    if(configPage6.iacChannels == 1) { idle2_pin.setPinLow(); }
+  }
+  else
+  {
+    idle_pin.setPinLow();
+    if(configPage6.iacChannels == 1) { idle2_pin.setPinHigh(); }
+  }
+}
+
+#if defined(AUX_PWM_CHANNELS)
+static uint16_t getIdlePwmDuty(void) { return (uint16_t)idle_pwm_target_value; }
+#endif
+
 void initialiseIdle(bool forcehoming)
 {
   //By default, turn off the PWM interrupt (It gets turned on below if needed)
@@ -114,6 +183,13 @@ void initialiseIdle(bool forcehoming)
   idle2_pin.setPin(pinNumbers.pinIdle2, OUTPUT);
 
   idle_pwm_max_count = pwmFreqToTicks(FREQUENCY.toUser(configPage6.idleFreq));
+#if defined(AUX_PWM_CHANNELS)
+  configureAuxPwm(AUX_PWM_IDLE, { idlePwmOn, idlePwmOff, getIdlePwmDuty }, idle_pwm_max_count);
+#endif
+#if defined(HW_AUX_PWM)
+  //The 2nd idle output must be the exact inverse of the 1st, so 2 channel idle stays on the timer interrupt
+  (void)setAuxPwmPin(AUX_PWM_IDLE, configPage6.iacChannels == 1 ? NOT_A_PIN : pinNumbers.pinIdle1, isIdlePwmActiveLow(configPage6));
+#endif
   
   //Initialising comprises of setting the 2D tables with the relevant values from the config pages
   switch(configPage6.iacAlgorithm)
@@ -434,7 +510,7 @@ void idleControl(void)
           currentStatus.idleLoad = map(idleTaper, 0, configPage2.idleTaperTime,\
           table2D_getValue(&iacCrankDutyTable, temperatureAddOffset(currentStatus.coolant)),\
           table2D_getValue(&iacPWMTable, temperatureAddOffset(currentStatus.coolant)));
-          if( BIT_CHECK(currentStatus.LOOP_TIMER, BIT_TIMER_10HZ) ) { idleTaper++; }
+          idleTaper++; //PWM idle is run at a fixed 10Hz
         }
         else
         {
@@ -474,9 +550,9 @@ void idleControl(void)
       else
       {
         idle_cl_target_rpm = (uint16_t)currentStatus.CLIdleTarget * 10; //Multiply the byte target value back out by 10
-        if( BIT_CHECK(currentStatus.LOOP_TIMER, BIT_TIMER_1HZ) ) { setIdlePidTunings(configPage6); } //Re-read the PID settings once per second
+        if( isPwmIdlePidRetuneDue() ) { setIdlePidTunings(configPage6); } //Re-read the PID settings once per second
         
-        PID_computed = idlePID.compute(millis(), currentStatus.RPM, &idle_pid_target_value);
+        PID_computed = idlePID.compute(currentStatus.RPM, &idle_pid_target_value);
         long TEMP_idle_pwm_target_value;
         if(PID_computed == true)
         {
@@ -555,13 +631,13 @@ void idleControl(void)
         
     
         idle_cl_target_rpm = (uint16_t)currentStatus.CLIdleTarget * 10U; //Multiply the byte target value back out by 10
-        if( BIT_CHECK(currentStatus.LOOP_TIMER, BIT_TIMER_1HZ) ) { setIdlePidTunings(configPage6); } //Re-read the PID settings once per second
+        if( isPwmIdlePidRetuneDue() ) { setIdlePidTunings(configPage6); } //Re-read the PID settings once per second
         if((currentStatus.RPM - idle_cl_target_rpm > configPage2.iacRPMlimitHysteresis*10) || (currentStatus.TPS > configPage2.iacTPSlimit)){ //reset integral to zero when TPS is bigger than set value in TS (opening throttle so not idle anymore). OR when RPM higher than Idle Target + RPM Histeresis (coming back from high rpm with throttle closed)
           idlePID.resetIntegeral();
         }
         
         idlePID.setFeedForwardTerm(FeedForwardTerm);
-        PID_computed = idlePID.compute(millis(), currentStatus.RPM, &idle_pid_target_value);
+        PID_computed = idlePID.compute(currentStatus.RPM, &idle_pid_target_value);
 
         if(PID_computed == true)
         {
@@ -779,61 +855,21 @@ void disableIdle(void)
   currentStatus.idleLoad = 0;
 }
 
+#if !defined(SOFT_PWM_ENGINE)
 void idleInterrupt(void)
 {
   if (idle_pwm_state)
   {
-    if (configPage6.iacPWMdir == 0)
-    {
-      //Normal direction
-      #if defined (CORE_TEENSY41) //PIT TIMERS count down and have opposite effect on PWM
-      idle_pin.setPinHigh();
-      if(configPage6.iacChannels == 1) { idle2_pin.setPinLow(); }
-      #else
-      idle_pin.setPinLow();  // Switch pin to low (1 pin mode)
-      if(configPage6.iacChannels == 1) { idle2_pin.setPinHigh(); } //If 2 idle channels are in use, flip idle2 to be the opposite of idle1
-      #endif
-    }
-    else
-    {
-      //Reversed direction
-      #if defined (CORE_TEENSY41) //PIT TIMERS count down and have opposite effect on PWM
-      idle_pin.setPinLow();
-      if(configPage6.iacChannels == 1) { idle2_pin.setPinHigh(); }
-      #else
-      idle_pin.setPinHigh();  // Switch pin high
-      if(configPage6.iacChannels == 1) { idle2_pin.setPinLow(); } //If 2 idle channels are in use, flip idle2 to be the opposite of idle1
-      #endif
-    }
+    idlePwmOff();
     SET_COMPARE(IDLE_COMPARE, IDLE_COUNTER + (idle_pwm_max_count - idle_pwm_cur_value) );
     idle_pwm_state = false;
   }
   else
   {
-    if (configPage6.iacPWMdir == 0)
-    {
-      //Normal direction
-      #if defined (CORE_TEENSY41) //PIT TIMERS count down and have opposite effect on PWM
-      idle_pin.setPinLow();
-      if(configPage6.iacChannels == 1) { idle2_pin.setPinHigh(); }
-      #else
-      idle_pin.setPinHigh();  // Switch pin high
-      if(configPage6.iacChannels == 1) { idle2_pin.setPinLow(); } //If 2 idle channels are in use, flip idle2 to be the opposite of idle1
-      #endif
-    }
-    else
-    {
-      //Reversed direction
-      #if defined (CORE_TEENSY41) //PIT TIMERS count down and have opposite effect on PWM
-      idle_pin.setPinHigh();
-      if(configPage6.iacChannels == 1) { idle2_pin.setPinLow(); }
-      #else
-      idle_pin.setPinLow();  // Switch pin to low (1 pin mode)
-      if(configPage6.iacChannels == 1) { idle2_pin.setPinHigh(); } //If 2 idle channels are in use, flip idle2 to be the opposite of idle1
-      #endif
-    }
+    idlePwmOn();
     SET_COMPARE(IDLE_COMPARE, IDLE_COUNTER + idle_pwm_target_value);
     idle_pwm_cur_value = idle_pwm_target_value;
     idle_pwm_state = true;
   }
 }
+#endif
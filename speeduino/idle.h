@@ -3,6 +3,9 @@
 
 #include <stdint.h>
 
+/** @brief idleControl() must be run at this fixed interval (in milliseconds) for PWM idle. It is the PWM idle PID sample period. */
+constexpr uint8_t IDLE_CONTROL_INTERVAL_MS = 100U;
+
 void initialiseIdle(bool forcehoming);
 void idleControl(void);
 void disableIdle(void);
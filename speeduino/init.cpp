@@ -35,6 +35,7 @@
 #include "scheduler_ignition_controller.h"
 #include "maths.h"
 #include "elapsed_time.h"
+#include "engine_config.h"
 #include "src/controllers/fuelPump/fuelPumpController.h"
 #include "src/controllers/fan/fanController.h"
 #include "src/controllers/boost/boostController.h"
@@ -91,29 +92,128 @@ static void processResetStorageRequest(void) {
 }
 #endif
 
-/** Initialise Speeduino for the main loop.
- * Top level init entry point for all initialisations:
- * - Initialise and set sizes of 3D tables
- * - Load config from EEPROM, update config structures to current version of SW if needed.
+/** @brief Pages that aren't needed to start the engine.
+ * 
+ * These are loaded by the first deferred initialisation stage, after the trigger is attached.
+ * Until then they are zero: I.e. the features they configure are off. The pins they select are
+ * mapped once they are loaded (see setDeferredPinMapping()).
+ * 
+ * The CAN bus page is not deferred: the board initialisation overrides some of its settings.
+ */
+static constexpr uint8_t deferredPages[] = { progOutsPage, boostvvtPage2 };
+
+/** @brief The deferred initialisation stages, in the order they are run */
+enum class DeferredInitStage : uint8_t {
+  /** Load the deferred pages, start CAN & secondary serial */
+  Comms,
+  /** SD card & RTC */
+  Logging,
+  /** Idle, fan, boost, VVT, air con, nitrous & programmable outputs */
+  Auxiliaries,
+  Complete,
+};
+static DeferredInitStage deferredStage = DeferredInitStage::Complete;
+static bool isDeferredPagesLoaded = true;
+
+static bool isDeferredPage(uint8_t pageNum)
+{
+  for (uint8_t index=0U; index<_countof(deferredPages); ++index)
+  {
+    if (deferredPages[index]==pageNum) { return true; }
+  }
+  return false;
+}
+
+static void loadCriticalPages(void)
+{
+  for (uint8_t pageNum=MIN_PAGE_NUM; pageNum<MAX_PAGE_NUM; ++pageNum)
+  {
+    if (!isDeferredPage(pageNum)) { loadPage(pageNum); }
+  }
+}
+
+/** Load the tune from storage. Only the critical pages are loaded, unless an update is required */
+static void loadTune(void)
+{
+  if (isUpdateRequired())
+  {
+    // Updates can touch any page, so everything must be loaded first
+    loadAllPages();
+  }
+  else
+  {
+    loadCriticalPages();
+    isDeferredPagesLoaded = false;
+  }
+  loadAllCalibrationTables(); 
+  doUpdates(); //Check if any data items need updating (Occurs with firmware updates)
+}
+
+#if defined(UNIT_TEST)
+/** Unit tests set up the tune in memory, so @ref initialiseCritical() doesn't load it unless this is set.
+ * Set the storage API first. */
+bool isUnitTestTuneLoaded = false;
+#endif
+
+/** Set the pins selected by the deferred pages: the SD logging enable input & the air con pins */
+static void setDeferredPinMapping(void)
+{
+#ifdef SD_LOGGING
+  if ( (configPage13.onboard_log_trigger_Epin != 0) && (configPage13.onboard_log_tr5_Epin_pin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinSDEnable = pinTranslate(configPage13.onboard_log_tr5_Epin_pin); }
+#endif
+
+  // Air conditioning control initialisation
+  if ((configPage15.airConCompPin != 0) && (configPage15.airConCompPin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinAirConComp = pinTranslate(configPage15.airConCompPin); }
+  if ((configPage15.airConFanPin != 0) && (configPage15.airConFanPin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinAirConFan = pinTranslate(configPage15.airConFanPin); }
+  if ((configPage15.airConReqPin != 0) && (configPage15.airConReqPin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinAirConRequest = pinTranslate(configPage15.airConReqPin); }
+
+#ifdef SD_LOGGING
+  if( (configPage13.onboard_log_trigger_Epin > 0) && (!pinIsOutput(pinNumbers.pinSDEnable)) )
+  {
+    pinMode(pinNumbers.pinSDEnable, INPUT);
+  }
+#endif
+}
+
+static void loadDeferredPages(void)
+{
+  if (!isDeferredPagesLoaded)
+  {
+    for (uint8_t index=0U; index<_countof(deferredPages); ++index)
+    {
+      loadPage(deferredPages[index]);
+    }
+    isDeferredPagesLoaded = true;
+    setDeferredPinMapping();
+  }
+}
+
+/** Initialise everything required to start the engine (fuel, ignition & the trigger decoder).
+ * This is the first stage of @ref initialiseAll():
+ * - Load the fuel, ignition & decoder pages and the calibration tables from EEPROM. The remaining
+ *   pages are loaded later (unless the config structures need updating to the current version of SW,
+ *   which requires every page)
  * - Initialise board (The initBoard() is for board X implemented in board_X.ino file)
  * - Initialise timers (See timers.ino)
- * - Perform optional SD card and RTC battery inits
- * - Load calibration tables from EEPROM
  * - Perform pin mapping (calling @ref setPinMapping() based on @ref config2.pinMapping)
- * - Stop any coil charging and close injectors
- * - Initialise schedulers, Idle, Fan, auxPWM, Corrections, AD-conversions, Programmable I/O
+ * - Initialise schedulers, Corrections, AD-conversions
  * - Initialise baro (ambient pressure) by reading MAP (before engine runs)
- * - Initialise triggers (by @ref initialiseTriggers() )
+ * - Initialise triggers (by @ref buildDecoder() )
  * - Perform cyl. count based initialisations (@ref config2.nCylinders)
  * - Perform injection and spark mode based setup
  *   - Assign injector open/close and coil charge begin/end functions to their dedicated global vars
  * - Perform fuel pressure priming by turning fuel pump on
  * - Read CLT and TPS sensors to have cranking pulsewidths computed correctly
- * - Mark Initialisation completed (this flag-marking is used in code to prevent after-init changes)
+ * 
+ * The engine can be started once this returns: the remaining initialisation is run from the main loop
+ * by @ref initialiseDeferredStage()
  */
-void initialiseAll(void)
+void initialiseCritical(void)
 {   
+    currentStatus.initialisationComplete = false;
     currentStatus.injPrimed = false;
+    deferredStage = DeferredInitStage::Comms;
+    isDeferredPagesLoaded = true;
 
     pinMode(LED_BUILTIN, OUTPUT);
     digitalWrite(LED_BUILTIN, LOW);
@@ -124,12 +224,12 @@ void initialiseAll(void)
     #endif
 
     // Unit tests should be independent of any stored configuration on the board!
-#if !defined(UNIT_TEST)
+#if defined(UNIT_TEST)
+    if (isUnitTestTuneLoaded) { loadTune(); }
+#else
     setStorageAPI(getBoardStorageApi());
     processResetStorageRequest();
-    loadAllPages();
-    loadAllCalibrationTables(); 
-    doUpdates(); //Check if any data items need updating (Occurs with firmware updates)
+    loadTune();
 #endif
 
     //Always start with a clean slate on the bootloader capabilities level
@@ -138,11 +238,6 @@ void initialiseAll(void)
     
     initBoard(115200); //This calls the current individual boards init function. See the board_xxx.ino files for these.
     initialiseTimers();
-    
-  #ifdef SD_LOGGING
-    initRTC();
-    if(configPage13.onboard_log_file_style) { initSD(); }
-  #endif
 
     pPrimarySerial = &Serial; //Default to standard Serial interface
     currentStatus.allowLegacyComms = true; //Flag legacy comms as being allowed on startup
@@ -152,36 +247,23 @@ void initialiseAll(void)
     {
       //First time running on this board
       setTuneToEmpty();
+      isDeferredPagesLoaded = true; // Don't overwrite the empty tune
       configPage4.triggerTeeth = 4; //Avoiddiv by 0 when start decoders
       configPage2.pinMapping = 3; //Force board to v0.4
     }
     setPinMapping(configPage2.pinMapping);
 
-    // Repeatedly initialising the CAN bus hangs the system when
-    // running initialisation tests on Teensy 3.5
-    #if defined(NATIVE_CAN_AVAILABLE) && !defined(UNIT_TEST)
-      initCAN();
-    #endif
-
-    //Must come after setPinMapping() as secondary serial can be changed on a per board basis
-    if (configPage9.enable_secondarySerial == 1) { secondarySerial.begin(115200); }
-  
     //Set the tacho output default state
     digitalWrite(pinNumbers.pinTachOut, HIGH);
+    //Lock the tune to the compile time engine configuration (if any)
+    applyFixedEngineConfig(configPage2, configPage4);
     //Perform all initialisations
     initialiseIgnitionSchedules(currentStatus, configPage2, configPage4, configPage10, pinNumbers);
     initialiseFuelSchedules(currentStatus, configPage2, configPage4, configPage10, pinNumbers);
-    initialiseIdle(true);
-    initialiseFan(pinNumbers.pinFan);
-    initialiseBoost(pinNumbers.pinBoost);
-    initialiseAirCon();
-    initialiseNitrous();
-    initialiseAuxPWM();
     initialiseCorrections();
     currentStatus.ioError = false; //Clear the I/O error bit. The bit will be set in initialiseADC() if there is problem in there.
     initialiseADC();
     initialiseMAPBaro();
-    initialiseProgrammableIO(currentStatus, configPage13);
     initialiseFlexSensor(configPage2, currentStatus, pinNumbers.pinFlex);
 
     //Same as above, but for the VSS input
@@ -252,9 +334,70 @@ void initialiseAll(void)
     /* SweepMax is stored as a byte, RPM/100. divide by 60 to convert min to sec (net 5/3).  Multiply by ignition pulses per rev.
        tachoSweepIncr is also the number of tach pulses per second */
     tachoSweepIncr = configPage2.tachoSweepMaxRPM * currentStatus.maxIgnOutputs * 5 / 3;
-   
-    currentStatus.initialisationComplete = true;
-    digitalWrite(LED_BUILTIN, HIGH);
+}
+
+/** Run the next stage of the non-critical initialisation. Called once per main loop until it returns true,
+ * so that no single loop is delayed by the whole of the initialisation.
+ * 
+ * The main loop skips the auxiliary controllers until initialisation is complete
+ * (@ref statuses::initialisationComplete).
+ * 
+ * @return true if initialisation is complete
+ */
+bool initialiseDeferredStage(void)
+{
+  switch (deferredStage)
+  {
+    case DeferredInitStage::Comms:
+      loadDeferredPages();
+      // Repeatedly initialising the CAN bus hangs the system when
+      // running initialisation tests on Teensy 3.5
+      #if defined(NATIVE_CAN_AVAILABLE) && !defined(UNIT_TEST)
+        initCAN();
+      #endif
+
+      //Must come after setPinMapping() as secondary serial can be changed on a per board basis
+      if (configPage9.enable_secondarySerial == 1) { secondarySerial.begin(115200); }
+      deferredStage = DeferredInitStage::Logging;
+      break;
+
+    case DeferredInitStage::Logging:
+    #ifdef SD_LOGGING
+      initRTC();
+      if(configPage13.onboard_log_file_style) { initSD(); }
+    #endif
+      deferredStage = DeferredInitStage::Auxiliaries;
+      break;
+
+    case DeferredInitStage::Auxiliaries:
+      initialiseIdle(true);
+      initialiseFan(pinNumbers.pinFan);
+      initialiseBoost(pinNumbers.pinBoost);
+      initialiseAirCon();
+      initialiseNitrous();
+      initialiseAuxPWM();
+      initialiseProgrammableIO(currentStatus, configPage13);
+
+      currentStatus.initialisationComplete = true;
+      digitalWrite(LED_BUILTIN, HIGH);
+      deferredStage = DeferredInitStage::Complete;
+      break;
+
+    case DeferredInitStage::Complete:
+    default:
+      break;
+  }
+  return deferredStage==DeferredInitStage::Complete;
+}
+
+/** Initialise Speeduino for the main loop.
+ * Top level init entry point for all initialisations: @ref initialiseCritical(), followed by every
+ * stage of @ref initialiseDeferredStage().
+ */
+void initialiseAll(void)
+{
+  initialiseCritical();
+  while (!initialiseDeferredStage()) { }
 }
 
 
@@ -290,10 +433,7 @@ void setPinMapping(byte boardID)
   if ( (configPage10.wmiIndicatorPin != 0) && (configPage10.wmiIndicatorPin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinWMIIndicator = pinTranslate(configPage10.wmiIndicatorPin); }
   if ( (configPage10.wmiEnabledPin != 0) && (configPage10.wmiEnabledPin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinWMIEnabled = pinTranslate(configPage10.wmiEnabledPin); }
   if ( (configPage10.vvt2Pin != 0) && (configPage10.vvt2Pin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinVVT_2 = pinTranslate(configPage10.vvt2Pin); }
-#ifdef SD_LOGGING
-  if ( (configPage13.onboard_log_trigger_Epin != 0) && (configPage13.onboard_log_tr5_Epin_pin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinSDEnable = pinTranslate(configPage13.onboard_log_tr5_Epin_pin); }
-#endif
-  
+
 
   //Currently there's no default pin for Idle Up
   
@@ -305,10 +445,8 @@ void setPinMapping(byte boardID)
   //Currently there's no default pin for closed throttle position sensor
   pinNumbers.pinCTPS = pinTranslate(configPage2.CTPSPin);
   
-  // Air conditioning control initialisation
-  if ((configPage15.airConCompPin != 0) && (configPage15.airConCompPin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinAirConComp = pinTranslate(configPage15.airConCompPin); }
-  if ((configPage15.airConFanPin != 0) && (configPage15.airConFanPin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinAirConFan = pinTranslate(configPage15.airConFanPin); }
-  if ((configPage15.airConReqPin != 0) && (configPage15.airConReqPin < BOARD_MAX_IO_PINS) ) { pinNumbers.pinAirConRequest = pinTranslate(configPage15.airConReqPin); }
+  // Otherwise they are mapped once loaded
+  if (isDeferredPagesLoaded) { setDeferredPinMapping(); }
     
   /* Reset control is a special case. If reset control is enabled, it needs its initial state set BEFORE its pinMode.
      If that doesn't happen and reset control is in "Serial Command" mode, the Arduino will end up in a reset loop
@@ -407,12 +545,6 @@ void setPinMapping(byte boardID)
   {
     pinMode(pinNumbers.pinOilPressure, INPUT);
   }
-#ifdef SD_LOGGING
-  if( (configPage13.onboard_log_trigger_Epin > 0) && (!pinIsOutput(pinNumbers.pinSDEnable)) )
-  {
-    pinMode(pinNumbers.pinSDEnable, INPUT);
-  }
-#endif
   if(configPage10.wmiEnabled > 0)
   {
     pinMode(pinNumbers.pinWMIEnabled, OUTPUT);
@@ -5,6 +5,8 @@
 #include "statuses.h"
 
 void initialiseAll(void);
+void initialiseCritical(void);
+bool initialiseDeferredStage(void);
 void setPinMapping(byte boardID);
 
 #define VSS_USES_RPM2() (isExternalVssMode(configPage2) && (pinNumbers.pinVSS == pinNumbers.pinTrigger2) && (!currentStatus.decoder.secondary.isValid())) // VSS is on the same pin as RPM2 and RPM2 is not used as part of the decoder
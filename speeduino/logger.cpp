@@ -11,6 +11,7 @@
 #include "resetControl.h"
 #include "scheduler.h"
 #include "scheduler_fuel_controller.h"
+#include "atomic_profile.h"
 #include "globals.h"
 
 static byte setStatusBit(byte status, uint8_t index, bool bit)
@@ -362,6 +363,10 @@ byte getTSLogEntry(uint16_t byteNum)
     case 137: statusValue = highByte(fuelSchedule8.pw); break;
 #endif
     case 138: statusValue = currentStatus.systemTemp; break;
+    case 139: statusValue = currentStatus.taskDeadlineMisses; break;
+    case 140: statusValue = lowByte(getAtomicProfile().maxDuration); break;
+    case 141: statusValue = highByte(getAtomicProfile().maxDuration); break;
+    case 142: statusValue = getAtomicProfile().maxSite; break;
     default: statusValue = 0; // MISRA check
   }
 
@@ -508,6 +513,9 @@ int16_t getReadableLogEntry(uint16_t logIndex)
     case 97: statusValue = fuelSchedule8.pw; break;
 #endif
     case 98: statusValue = currentStatus.systemTemp; break;
+    case 99: statusValue = currentStatus.taskDeadlineMisses; break;
+    case 100: statusValue = (int16_t)getAtomicProfile().maxDuration; break;
+    case 101: statusValue = getAtomicProfile().maxSite; break;
     default: statusValue = 0; // MISRA check
   }
 
@@ -709,7 +717,7 @@ bool is2ByteEntry(uint8_t key)
   // This array indicates which index values from the log are 2 byte values
   // This array MUST remain in ascending order
   // !!!! WARNING: If any value above 255 is required in this array, changes MUST be made to is2ByteEntry() function !!!!
-  static constexpr byte PROGMEM fsIntIndex[] = {4, 14, 17, 22, 26, 28, 33, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64, 66, 68, 70, 72, 76, 78, 80, 82, 86, 88, 90, 93, 95, 99, 104, 111, 121, 125, 130, 132, 134, 136 };
+  static constexpr byte PROGMEM fsIntIndex[] = {4, 14, 17, 22, 26, 28, 33, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64, 66, 68, 70, 72, 76, 78, 80, 82, 86, 88, 90, 93, 95, 99, 104, 111, 121, 125, 130, 132, 134, 136, 140 };
 
   unsigned int bot = 0U;
   unsigned int mid = _countof(fsIntIndex);
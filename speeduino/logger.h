@@ -11,7 +11,7 @@
 
 #include "statuses.h"
 
-constexpr uint8_t LOG_ENTRY_SIZE = 138; /**< The size of the live data packet. This MUST match ochBlockSize setting in the ini file */
+constexpr uint8_t LOG_ENTRY_SIZE = 143; /**< The size of the live data packet. This MUST match ochBlockSize setting in the ini file */
 
 byte getTSLogEntry(uint16_t byteNum);
 int16_t getReadableLogEntry(uint16_t logIndex);
@@ -12,6 +12,7 @@
 #include <libdivide.h>
 #endif
 #include "unit_testing.h"
+#include "fixed_point.h"
 
 uint8_t random1to100(void) noexcept;
 
@@ -235,6 +236,19 @@ static inline uint32_t rshift_round(uint32_t a) {
     return rshift<b>((uint32_t)(a+CORRECTION));
 }
 
+/**
+ * @brief Convert a percentage to an unsigned fixed point fraction. E.g. 50% -> 0.5
+ * 
+ * @warning percent<<fracBits must fit in 16 bits.
+ * 
+ * @tparam fracBits Number of fractional bits in the result
+ * @param percent The percentage to convert
+ */
+template <uint8_t fracBits>
+static inline fixed_point_t<uint16_t, fracBits> percentToFixed(uint16_t percent) {
+  return fixed_point_t<uint16_t, fracBits>::fromRaw(div100((uint16_t)(percent << fracBits)));
+}
+
 /// @cond
 
 /**
@@ -243,8 +257,7 @@ static inline uint32_t rshift_round(uint32_t a) {
  */
 template <uint8_t bitsPrecision>
 static inline uint32_t _percentageApprox(uint16_t percent, uint32_t value) {
-  uint16_t iPercent = div100((uint16_t)(percent << bitsPrecision));
-  return rshift_round<bitsPrecision>(value * (uint32_t)iPercent);
+  return percentToFixed<bitsPrecision>(percent).scale(value);
 }
 
 /// @endcond
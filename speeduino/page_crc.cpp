@@ -5,15 +5,20 @@
 uint32_t __attribute__((optimize("Os"))) calculatePageCRC32(uint8_t pageNum)
 {
     FastCRC32 crcCalc;
-    
-    byte buffer = getPageValue(pageNum, 0);
-    uint32_t crc = crcCalc.crc32(&buffer, 1U);
 
-    for (uint16_t offset=1; offset<getPageSize(pageNum); ++offset)
+    // Feed the CRC in blocks: much faster than byte by byte, with minimal stack usage
+    byte buffer[32];
+    const uint16_t pageSize = getPageSize(pageNum);
+    uint16_t blockSize = min(pageSize, (uint16_t)sizeof(buffer));
+    readPage(pageNum, 0U, buffer, blockSize);
+    uint32_t crc = crcCalc.crc32(buffer, blockSize);
+
+    for (uint16_t offset=blockSize; offset<pageSize; offset+=blockSize)
     {
-        buffer = getPageValue(pageNum, offset);
-        crc = crcCalc.crc32_upd(&buffer, 1U);
+        blockSize = min((uint16_t)(pageSize-offset), (uint16_t)sizeof(buffer));
+        readPage(pageNum, offset, buffer, blockSize);
+        crc = crcCalc.crc32_upd(buffer, blockSize);
     }
 
     return crc;
-}
\ No newline at end of file
+}
@@ -71,6 +71,8 @@ public:
   : _pTable(const_cast<table_t *>(pTable)), // cppcheck-suppress misra-c2012-10.4
     _table_offset(min(table_offset, getTableSize<table_t>()))
   {    
+    // The page layout (and the TS ini) has one byte per table value
+    static_assert(sizeof(typename table_t::value_t::value_type)==sizeof(byte), "Only 8-bit table values can be mapped to a page");
   }
 
   // Getter
@@ -423,6 +425,169 @@ static page_iterator_t map_page_offset_to_entity(uint8_t pageNumber, uint16_t of
   return mapOffsetToEntity_P(pageMap.searchMap, pageMap.mapSize, pageNumber, offset);
 }
 
+// ========================= Span (bulk) access  ===================
+//
+// Copying a span of page bytes one at a time means mapping every byte
+// offset to an entity, then (for tables) to a value/axis element. Instead we
+// map once per entity & copy contiguous runs: raw blocks & table rows are
+// contiguous in memory so can be memcpy'd. The axes are stored in reverse
+// order, so they are copied element by element using the axis iterators.
+//
+// The copy direction is encapsulated in a policy, so the read & write
+// paths share the entity walking code.
+
+// Copy from the tune into a buffer
+struct page_read_policy_t {
+  using buffer_t = byte*;
+
+  static inline bool copyBlock(byte *pEntity, buffer_t pBuffer, uint16_t length)
+  {
+    (void)memcpy(pBuffer, pEntity, length);
+    return true;
+  }
+  static inline void copyElement(byte &entityValue, buffer_t pBuffer)
+  {
+    *pBuffer = entityValue;
+  }
+  static inline bool copyNone(buffer_t pBuffer, uint16_t length)
+  {
+    (void)memset(pBuffer, 0, length);
+    return true;
+  }
+  template <typename TTable>
+  static inline void onTableCopied(TTable &) { }
+};
+
+// Copy from a buffer into the tune
+struct page_write_policy_t {
+  using buffer_t = const byte*;
+
+  static inline bool copyBlock(byte *pEntity, buffer_t pBuffer, uint16_t length)
+  {
+    (void)memcpy(pEntity, pBuffer, length);
+    return true;
+  }
+  static inline void copyElement(byte &entityValue, buffer_t pBuffer)
+  {
+    entityValue = *pBuffer;
+  }
+  static inline bool copyNone(buffer_t, uint16_t)
+  {
+    // Unsettable entity type
+    return false;
+  }
+  template <typename TTable>
+  static inline void onTableCopied(TTable &table)
+  {
+    invalidate_cache(&table.get_value_cache);
+  }
+};
+
+template <typename TPolicy, typename TBuffer>
+static inline void copyTableAxisSpan(table_axis_iterator it, TBuffer pBuffer, uint16_t length)
+{
+  for (uint16_t index=0U; index<length; ++index)
+  {
+    TPolicy::copyElement(*it, pBuffer+index);
+    ++it;
+  }
+}
+
+template <typename TPolicy>
+struct copy_table_span_visitor {
+  using buffer_t = typename TPolicy::buffer_t;
+
+  uint16_t _offset;
+  buffer_t _pBuffer;
+  uint16_t _length;
+
+  explicit copy_table_span_visitor(uint16_t offset, buffer_t pBuffer, uint16_t length)
+    : _offset(offset)
+    , _pBuffer(pBuffer)
+    , _length(length)
+  {
+  }
+
+  template <typename TTable>
+  void visit(TTable &table)
+  {
+    constexpr uint16_t valueEnd = get_table_value_end<TTable>();
+    constexpr uint16_t xAxisEnd = get_table_axisx_end<TTable>();
+    constexpr uint8_t rowSize = TTable::xaxis_t::length;
+
+    // Values: each row is contiguous in memory (but the rows are in reverse order)
+    while ((_length>0U) && (_offset<valueEnd))
+    {
+      uint16_t chunk = min(_length, (uint16_t)(rowSize - (_offset % rowSize)));
+      (void)TPolicy::copyBlock(&table.values.value_at((uint8_t)_offset), _pBuffer, chunk);
+      consume(chunk);
+    }
+    if ((_length>0U) && (_offset<xAxisEnd))
+    {
+      uint16_t chunk = min(_length, (uint16_t)(xAxisEnd - _offset));
+      copyTableAxisSpan<TPolicy>(table.axisX.begin().advance((int8_t)(_offset - valueEnd)), _pBuffer, chunk);
+      consume(chunk);
+    }
+    if (_length>0U)
+    {
+      copyTableAxisSpan<TPolicy>(table.axisY.begin().advance((int8_t)(_offset - xAxisEnd)), _pBuffer, _length);
+      consume(_length);
+    }
+    TPolicy::onTableCopied(table);
+  }
+
+private:
+  void consume(uint16_t length)
+  {
+    _offset = _offset + length;
+    _pBuffer = _pBuffer + length;
+    _length = _length - length;
+  }
+};
+
+// Copy part of a single entity. The caller must ensure the span is within the entity.
+template <typename TPolicy>
+static bool copyEntitySpan(const entity_t &entity, uint16_t entityOffset, typename TPolicy::buffer_t pBuffer, uint16_t length)
+{
+  if (EntityType::Raw==entity.type)
+  {
+    return TPolicy::copyBlock((byte*)entity.pRaw + entityOffset, pBuffer, length);
+  }
+  if (EntityType::Table==entity.type)
+  {
+    copy_table_span_visitor<TPolicy> visitor(entityOffset, pBuffer, length);
+    visitTable3d<copy_table_span_visitor<TPolicy>, void>(*entity.pTable, entity.table_key, visitor);
+    return true;
+  }
+  // Entity has no data
+  return TPolicy::copyNone(pBuffer, length);
+}
+
+template <typename TPolicy>
+static bool copyPageSpan(uint8_t pageNum, uint16_t pageOffset, typename TPolicy::buffer_t pBuffer, uint16_t length)
+{
+  bool allCopied = true;
+  page_iterator_t iter = map_page_offset_to_entity(pageNum, pageOffset);
+  while (length>0U)
+  {
+    uint16_t entityOffset = pageOffset-iter.entity.start;
+    uint16_t chunk = length;
+    if (EntityType::End!=iter.entity.type)
+    {
+      chunk = min(length, (uint16_t)(iter.entity.size-entityOffset));
+    }
+    allCopied = copyEntitySpan<TPolicy>(iter.entity, entityOffset, pBuffer, chunk) && allCopied;
+    pageOffset = pageOffset + chunk;
+    pBuffer = pBuffer + chunk;
+    length = length - chunk;
+    if (length>0U)
+    {
+      iter = advance(iter);
+    }
+  }
+  return allCopied;
+}
+
 // ========================= Set tune to empty support  ===================
 
 static void setTableRowToEmpty(table_row_iterator row)
@@ -517,6 +682,16 @@ byte getPageValue(uint8_t pageNum, uint16_t pageOffset)
   return getEntityValue(iter.entity, pageOffsetToEntityOffset(iter, pageOffset));
 }
 
+void readPage(uint8_t pageNum, uint16_t pageOffset, byte *pBuffer, uint16_t length)
+{
+  (void)copyPageSpan<page_read_policy_t>(pageNum, pageOffset, pBuffer, length);
+}
+
+bool writePage(uint8_t pageNum, uint16_t pageOffset, const byte *pBuffer, uint16_t length)
+{
+  return copyPageSpan<page_write_policy_t>(pageNum, pageOffset, pBuffer, length);
+}
+
 // LCOV_EXCL_START
 // No need to have coverage on simple wrappers
 
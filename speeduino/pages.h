@@ -63,6 +63,34 @@ bool setPageValue(  uint8_t pageNum,        /**< [in] The page number to update.
                     );
 
 
+// ============================== Bulk page access ==========================
+
+/** 
+ * @brief Copy a contiguous span of a page into a buffer, with data aligned as per the ini file
+ * 
+ * Equivalent to calling getPageValue() for each offset, but much faster: each entity is located
+ * once and contiguous runs of bytes are block copied.
+ */
+void readPage(  uint8_t pageNum,        /**< [in] The page number to retrieve data from. */
+                uint16_t pageOffset,    /**< [in] The offset within the page of the first byte to read */
+                byte *pBuffer,          /**< [out] The buffer to copy into. Must be at least length bytes */
+                uint16_t length         /**< [in] The number of bytes to read */
+                );
+
+/** 
+ * @brief Copy a buffer into a contiguous span of a page, with data aligned as per the ini file
+ * 
+ * Equivalent to calling setPageValue() for each offset, but much faster: each entity is located
+ * once and contiguous runs of bytes are block copied.
+ * 
+ * @returns true if all values were set, false otherwise
+ */
+bool writePage( uint8_t pageNum,        /**< [in] The page number to update. */
+                uint16_t pageOffset,    /**< [in] The offset within the page of the first byte to write */
+                const byte *pBuffer,    /**< [in] The new values */
+                uint16_t length         /**< [in] The number of bytes to write */
+                );
+
 // ============================== Page Iteration ==========================
 
 // A logical TS page is actually multiple in memory entities. Allow iteration
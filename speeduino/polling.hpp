@@ -40,4 +40,68 @@ static inline void executePolledAction(const polledAction_t &action, byte loopTi
 static inline void executePolledArrayAction(uint8_t index, const polledAction_t *pActions, byte loopTimer)
 {
     executePolledAction(pActions[index], loopTimer);
-}
\ No newline at end of file
+}
+/**
+ * @brief A task to be run at a fixed period, independent of the main loop rate.
+ *
+ * Unlike a @ref polledAction_t (which runs whenever the main loop sees the timer bit set, so the
+ * interval between runs jitters with the loop time and a bit can be missed entirely), a fixed rate
+ * task keeps its own deadline. The deadline is advanced by exactly one period each time the task
+ * runs, so the *average* rate is fixed even if individual runs are a little late. This gives
+ * closed loop controllers (E.g. PID) a deterministic sample period.
+ */
+struct fixedRateTask_t {
+    void (*pCallback)(void); ///< The function to call when the task is due
+    uint16_t periodMs;       ///< The task period in milliseconds. Must be less than 32768
+    uint16_t nextDueMs;      ///< The next deadline (lower 16 bits of millis())
+    bool isStarted;          ///< False until the first call seeds nextDueMs
+};
+
+/** @brief Run a fixed rate task if it is due
+ *
+ * The first call runs the task and starts the deadlines from that time, so the time before the
+ * task started is never counted as missed deadlines.
+ *
+ * If the task is more than one whole period late (I.e. at least one deadline was missed completely)
+ * the deadline is re-synchronised to the current time rather than running the task repeatedly to
+ * catch up.
+ *
+ * @param task The task to (potentially) execute
+ * @param nowMs The current time (lower 16 bits of millis())
+ * @return The number of deadlines that were missed completely (usually zero)
+ */
+static inline uint8_t executeFixedRateTask(fixedRateTask_t &task, uint16_t nowMs)
+{
+  if (!task.isStarted) {
+    task.nextDueMs = nowMs;
+    task.isStarted = true;
+  }
+  // Signed difference handles the 16-bit millisecond roll over
+  int16_t lateMs = (int16_t)(uint16_t)(nowMs - task.nextDueMs);
+  if (lateMs < 0) { return 0U; }
+
+  task.pCallback();
+
+  if ((uint16_t)lateMs < task.periodMs) {
+    task.nextDueMs = (uint16_t)(task.nextDueMs + task.periodMs);
+    return 0U;
+  }
+  task.nextDueMs = (uint16_t)(nowMs + task.periodMs);
+  uint16_t missed = (uint16_t)lateMs / task.periodMs;
+  return missed > UINT8_MAX ? (uint8_t)UINT8_MAX : (uint8_t)missed;
+}
+
+/** @brief Execute a fixed rate task at a specific index in the array of tasks
+ *
+ * @note Intent is to use this function with static_for to execute all tasks in the array
+ *
+ * @param index The index of the task to execute
+ * @param pTasks The array of tasks to execute from
+ * @param nowMs The current time (lower 16 bits of millis())
+ * @param pMissed Accumulates the number of missed deadlines (saturating)
+ */
+static inline void executeFixedRateArrayTask(uint8_t index, fixedRateTask_t *pTasks, uint16_t nowMs, uint8_t *pMissed)
+{
+  uint8_t missed = executeFixedRateTask(pTasks[index], nowMs);
+  *pMissed = (missed > (uint8_t)(UINT8_MAX - *pMissed)) ? (uint8_t)UINT8_MAX : (uint8_t)(*pMissed + missed);
+}
@@ -7,6 +7,7 @@
 #include "units.h"
 #include "unit_testing.h"
 #include "globals.h"
+#include "prog_mem_support.h"
 
 TESTABLE_STATIC uint8_t ioDelay[_countof(config13::outputPin)];
 TESTABLE_STATIC uint8_t ioOutDelay[_countof(config13::outputPin)];
@@ -39,71 +40,287 @@ void __attribute__((optimize("Os"))) initialiseProgrammableIO(statuses& current,
       else { BIT_CLEAR(pinIsValid, y); }
     }
   }
+  compileProgrammableIO(page13);
 }
 
+// ============================== Rule compilation ==============================
+//
+// The rules are decoded ("compiled") once when page 13 is loaded or changed, rather
+// than every time they are checked. Each condition is reduced to a data reader
+// & a comparator function. Live data that is a plain currentStatus field is
+// resolved to that field, so it is read directly instead of via getTSLogEntry().
+
+struct ioCondition_t;
+/** @brief Read a single data value for a rule condition */
+using ioDataReader_t = int16_t (*)(const ioCondition_t &condition);
+/** @brief Compare a data value against the rule target */
+using ioComparator_t = bool (*)(int16_t data, int16_t target);
+/** @brief Combine the results of the first & second conditions */
+using ioCombiner_t = bool (*)(bool first, bool second);
+
+/** @brief A pre-decoded rule condition */
+struct ioCondition_t {
+  ioDataReader_t pRead;
+  ioComparator_t pCompare;
+  union {
+    uint8_t dataIndex;            ///< Index read by the index based readers
+    const volatile void *pField;  ///< Field read by the field readers
+  };
+};
+
+/** @brief A pre-decoded programmable I/O rule */
+struct ioRule_t {
+  ioCondition_t first;
+  ioCondition_t second;
+  ioCombiner_t pCombine; ///< nullptr if the second condition is disabled
+};
+
+static ioRule_t ioRules[_countof(config13::outputPin)];
+
+static bool compareEqual(int16_t data, int16_t target) { return data == target; }
+static bool compareNotEqual(int16_t data, int16_t target) { return data != target; }
+static bool compareGreater(int16_t data, int16_t target) { return data > target; }
+static bool compareGreaterEqual(int16_t data, int16_t target) { return data >= target; }
+static bool compareLess(int16_t data, int16_t target) { return data < target; }
+static bool compareLessEqual(int16_t data, int16_t target) { return data <= target; }
+static bool compareAnd(int16_t data, int16_t target) { return (data & target) != 0; }
+static bool compareXor(int16_t data, int16_t target) { return (data ^ target) != 0; }
+
+// Indexed by COMPARATOR_*
+static constexpr ioComparator_t comparators[] = {
+  compareEqual, compareNotEqual, compareGreater, compareGreaterEqual, 
+  compareLess, compareLessEqual, compareAnd, compareXor,
+};
+
+static bool combineAnd(bool first, bool second) { return first && second; }
+static bool combineOr(bool first, bool second) { return first || second; }
+static bool combineXor(bool first, bool second) { return first != second; }
+
+// Indexed by BITWISE_*
+static constexpr ioCombiner_t combiners[] = {
+  nullptr, combineAnd, combineOr, combineXor,
+};
+
+static int16_t readRuleStatus(const ioCondition_t &condition) { return BIT_CHECK(currentRuleStatus, condition.dataIndex); }
+static int16_t readZero(const ioCondition_t &) { return 0; }
+static int16_t readLogByte(const ioCondition_t &condition) { return getTSLogEntry(condition.dataIndex); }
+static int16_t readLogWord(const ioCondition_t &condition) { return word(getTSLogEntry(condition.dataIndex+1U), getTSLogEntry(condition.dataIndex)); }
+static int16_t readRunSecs(const ioCondition_t &) { return (int16_t)max((uint32_t)runSecsX10, (uint32_t)32768); } //STM32 used std lib
+static int16_t readInvalid(const ioCondition_t &) { return -1; } //Index is bigger than fullStatus array
+
+// The field readers convert the same way as the live data: 1 byte entries are the low byte,
+// 2 byte entries the low 16 bits & temperatures have the offset added then removed.
+template <typename T>
+static int16_t readByteField(const ioCondition_t &condition) { return (uint8_t)*(const volatile T*)condition.pField; }
+template <typename T>
+static int16_t readWordField(const ioCondition_t &condition) { return (int16_t)(uint16_t)*(const volatile T*)condition.pField; }
+template <typename T>
+static int16_t readTemperatureField(const ioCondition_t &condition) { return temperatureRemoveOffset(temperatureAddOffset(*(const volatile T*)condition.pField)); }
+
+/** @brief A live data entry that is a plain currentStatus field */
+struct ioLiveField_t {
+  uint8_t index; ///< Live data index (see getTSLogEntry())
+  ioDataReader_t pRead;
+  const volatile void *pField;
+};
+
+template <typename T>
+static constexpr ioLiveField_t makeByteField(uint8_t index, const volatile T *pField) { return { index, readByteField<T>, pField }; }
+template <typename T>
+static constexpr ioLiveField_t makeWordField(uint8_t index, const volatile T *pField) { return { index, readWordField<T>, pField }; }
+template <typename T>
+static constexpr ioLiveField_t makeTemperatureField(uint8_t index, const volatile T *pField) { return { index, readTemperatureField<T>, pField }; }
+
+/** @brief The live data entries that can be read directly. Must match getTSLogEntry() & is2ByteEntry() */
+static constexpr ioLiveField_t liveFields[] PROGMEM = {
+  makeByteField(0U, &currentStatus.secl),
+  makeByteField(3U, &currentStatus.syncLossCounter),
+  makeWordField(4U, &currentStatus.MAP),
+  makeTemperatureField(6U, &currentStatus.IAT),
+  makeTemperatureField(7U, &currentStatus.coolant),
+  makeByteField(8U, &currentStatus.batCorrection),
+  makeByteField(9U, &currentStatus.battery10),
+  makeByteField(10U, &currentStatus.O2),
+  makeByteField(11U, &currentStatus.egoCorrection),
+  makeByteField(12U, &currentStatus.iatCorrection),
+  makeByteField(13U, &currentStatus.wueCorrection),
+  makeWordField(14U, &currentStatus.RPM),
+  makeWordField(17U, &currentStatus.corrections),
+  makeByteField(19U, &currentStatus.VE1),
+  makeByteField(20U, &currentStatus.VE2),
+  makeByteField(21U, &currentStatus.afrTarget),
+  makeWordField(22U, &currentStatus.tpsDOT),
+  makeByteField(24U, &currentStatus.advance),
+  makeByteField(25U, &currentStatus.TPS),
+  makeWordField(26U, &currentStatus.loopsPerSecond),
+  makeWordField(33U, &currentStatus.rpmDOT),
+  makeByteField(35U, &currentStatus.ethanolPct),
+  makeByteField(36U, &currentStatus.flexCorrection),
+  makeByteField(37U, &currentStatus.flexIgnCorrection),
+  makeByteField(38U, &currentStatus.idleLoad),
+  makeByteField(40U, &currentStatus.O2_2),
+  makeByteField(41U, &currentStatus.baro),
+  makeWordField(42U, &currentStatus.canin[0]),
+  makeWordField(44U, &currentStatus.canin[1]),
+  makeWordField(46U, &currentStatus.canin[2]),
+  makeWordField(48U, &currentStatus.canin[3]),
+  makeWordField(50U, &currentStatus.canin[4]),
+  makeWordField(52U, &currentStatus.canin[5]),
+  makeWordField(54U, &currentStatus.canin[6]),
+  makeWordField(56U, &currentStatus.canin[7]),
+  makeWordField(58U, &currentStatus.canin[8]),
+  makeWordField(60U, &currentStatus.canin[9]),
+  makeWordField(62U, &currentStatus.canin[10]),
+  makeWordField(64U, &currentStatus.canin[11]),
+  makeWordField(66U, &currentStatus.canin[12]),
+  makeWordField(68U, &currentStatus.canin[13]),
+  makeWordField(70U, &currentStatus.canin[14]),
+  makeWordField(72U, &currentStatus.canin[15]),
+  makeByteField(74U, &currentStatus.tpsADC),
+  makeWordField(86U, &currentStatus.fuelLoad),
+  makeWordField(88U, &currentStatus.ignLoad),
+  makeWordField(90U, &currentStatus.dwell),
+  makeByteField(92U, &currentStatus.CLIdleTarget),
+  makeWordField(93U, &currentStatus.mapDOT),
+  makeWordField(95U, &currentStatus.vvt1Angle),
+  makeByteField(97U, &currentStatus.vvt1TargetAngle),
+  makeByteField(98U, &currentStatus.vvt1Duty),
+  makeWordField(99U, &currentStatus.flexBoostCorrection),
+  makeByteField(101U, &currentStatus.baroCorrection),
+  makeByteField(102U, &currentStatus.VE),
+  makeByteField(103U, &currentStatus.ASEValue),
+  makeWordField(104U, &currentStatus.vss),
+  makeByteField(106U, &currentStatus.gear),
+  makeByteField(107U, &currentStatus.fuelPressure),
+  makeByteField(108U, &currentStatus.oilPressure),
+  makeByteField(109U, &currentStatus.wmiPW),
+  makeWordField(111U, &currentStatus.vvt2Angle),
+  makeByteField(113U, &currentStatus.vvt2TargetAngle),
+  makeByteField(114U, &currentStatus.vvt2Duty),
+  makeByteField(115U, &currentStatus.outputsStatus),
+  makeByteField(117U, &currentStatus.fuelTempCorrection),
+  makeByteField(118U, &currentStatus.advance1),
+  makeByteField(119U, &currentStatus.advance2),
+  makeWordField(121U, &currentStatus.EMAP),
+  makeByteField(123U, &currentStatus.fanDuty),
+  makeWordField(125U, &currentStatus.actualDwell),
+  makeByteField(128U, &currentStatus.knockCount),
+  makeByteField(129U, &currentStatus.knockRetard),
+  makeByteField(138U, &currentStatus.systemTemp),
+  makeByteField(139U, &currentStatus.taskDeadlineMisses),
+};
+
+#if defined(UNIT_TEST)
+// Externally supplied data source
+static int16_t (*pGetExternalData)(uint16_t index) = nullptr;
+static int16_t readExternalData(const ioCondition_t &condition) { return pGetExternalData(condition.dataIndex); }
+#endif
+
+/** @brief Compile a live data index (I.e. not a rule reuse index)
+ * 
+ * This must give the same results as ProgrammableIOGetData()
+ */
+static ioCondition_t compileLogDataCondition(uint8_t index, uint8_t compType)
+{
+  ioCondition_t condition;
+  condition.pCompare = comparators[compType];
+  condition.dataIndex = index;
+#if defined(UNIT_TEST)
+  if (pGetExternalData != nullptr) { condition.pRead = readExternalData; return condition; }
+#endif
+  if (index >= LOG_ENTRY_SIZE) 
+  { 
+    condition.pRead = (index == 239U) ? readRunSecs : readInvalid; 
+    return condition;
+  }
+  for (uint8_t fieldIndex = 0U; fieldIndex < _countof(liveFields); ++fieldIndex)
+  {
+    ioLiveField_t field = copyObject_P(&liveFields[fieldIndex]);
+    if (field.index == index)
+    {
+      condition.pRead = field.pRead;
+      condition.pField = field.pField;
+      return condition;
+    }
+  }
+  //Computed entries are read via the live data
+  condition.pRead = is2ByteEntry(index) ? readLogWord : readLogByte;
+  return condition;
+}
+
+static ioCondition_t compileFirstCondition(uint8_t dataRequested, uint8_t compType)
+{
+  ioCondition_t condition = compileLogDataCondition(dataRequested, compType);
+  if ( dataRequested > 239U ) //Somehow using 239 uses 9 bytes of RAM, why??
+  {
+    condition.dataIndex = dataRequested - REUSE_RULES;
+    condition.pRead = (condition.dataIndex <= sizeof(config13::outputPin)) ? readRuleStatus : readZero;
+  }
+  return condition;
+}
+
+static ioCondition_t compileSecondCondition(uint8_t dataRequested, uint8_t compType)
+{
+  ioCondition_t condition = compileLogDataCondition(dataRequested, compType);
+  if ( dataRequested > 239U )
+  {
+    condition.dataIndex = dataRequested - REUSE_RULES;
+    condition.pRead = readRuleStatus;
+  }
+  return condition;
+}
+
+static ioRule_t compileRule(const config13& page13, uint8_t ruleIndex)
+{
+  const cmpOperation &operation = page13.operation[ruleIndex];
+  ioRule_t rule;
+  rule.first = compileFirstCondition(page13.firstDataIn[ruleIndex], operation.firstCompType);
+  rule.second = compileSecondCondition(page13.secondDataIn[ruleIndex], operation.secondCompType);
+  rule.pCombine = combiners[operation.bitwise];
+  if ( page13.secondDataIn[ruleIndex] > (REUSE_RULES + sizeof(page13.outputPin)) ) //Failsafe check
+  {
+    rule.pCombine = nullptr;
+  }
+  return rule;
+}
+
+void compileProgrammableIO(const config13& page13)
+{
+  for (uint8_t y = 0; y < _countof(ioRules); y++)
+  {
+    ioRules[y] = compileRule(page13, y);
+  }
+}
+
+static inline bool checkCondition(const ioCondition_t &condition, int16_t target)
+{
+  return condition.pCompare(condition.pRead(condition), target);
+}
+
+static inline bool checkRule(const ioRule_t &rule, const config13& page13, uint8_t ruleIndex)
+{
+  bool result = checkCondition(rule.first, page13.firstTarget[ruleIndex]);
+  if (rule.pCombine != nullptr)
+  {
+    result = rule.pCombine(result, checkCondition(rule.second, page13.secondTarget[ruleIndex]));
+  }
+  return result;
+}
+
+// ============================== Rule evaluation ==============================
+
 /** Check all (8) programmable I/O:s and carry out action on output pin as needed.
  * Compare 2 (16 bit) vars in a way configured by @ref cmpOperation (see also @ref config13.operation).
- * Use ProgrammableIOGetData() to get 2 vars to compare.
+ * The rules must have been compiled by compileProgrammableIO().
  * Skip all programmable I/O:s where output pin is set 0 (meaning: not programmed).
  */
-TESTABLE_STATIC void checkProgrammableIO(statuses& current, const config13& page13, int16_t (*getData)(uint16_t index))
+void checkProgrammableIO(statuses& current, const config13& page13)
 {
-  int16_t data, data2;
-  uint8_t dataRequested;
-  bool firstCheck, secondCheck;
-
-  for (uint8_t y = 0; y < _countof(ioDelay); y++)
+  for (uint8_t y = 0; y < _countof(ioRules); y++)
   {
-    firstCheck = false;
-    secondCheck = false;
     if ( BIT_CHECK(pinIsValid, y) ) //if outputPin == 0 it is disabled
     {
-      dataRequested = page13.firstDataIn[y];
-      if ( dataRequested > 239U ) //Somehow using 239 uses 9 bytes of RAM, why??
-      {
-        dataRequested -= REUSE_RULES;
-        if ( dataRequested <= sizeof(page13.outputPin) ) { data = BIT_CHECK(currentRuleStatus, dataRequested); }
-        else { data = 0; }
-      }
-      else { data = getData(dataRequested); }
-      data2 = page13.firstTarget[y];
-
-      if ( (page13.operation[y].firstCompType == COMPARATOR_EQUAL) && (data == data2) ) { firstCheck = true; }
-      else if ( (page13.operation[y].firstCompType == COMPARATOR_NOT_EQUAL) && (data != data2) ) { firstCheck = true; }
-      else if ( (page13.operation[y].firstCompType == COMPARATOR_GREATER) && (data > data2) ) { firstCheck = true; }
-      else if ( (page13.operation[y].firstCompType == COMPARATOR_GREATER_EQUAL) && (data >= data2) ) { firstCheck = true; }
-      else if ( (page13.operation[y].firstCompType == COMPARATOR_LESS) && (data < data2) ) { firstCheck = true; }
-      else if ( (page13.operation[y].firstCompType == COMPARATOR_LESS_EQUAL) && (data <= data2) ) { firstCheck = true; }
-      else if ( (page13.operation[y].firstCompType == COMPARATOR_AND) && ((data & data2) != 0) ) { firstCheck = true; }
-      else if ( (page13.operation[y].firstCompType == COMPARATOR_XOR) && ((data ^ data2) != 0) ) { firstCheck = true; }
-
-      if (page13.operation[y].bitwise != BITWISE_DISABLED)
-      {
-        dataRequested = page13.secondDataIn[y];
-        if ( dataRequested <= (REUSE_RULES + sizeof(page13.outputPin)) ) //Failsafe check
-        {
-          if ( dataRequested > 239U ) //Somehow using 239 uses 9 bytes of RAM, why??
-          {
-            dataRequested -= REUSE_RULES;
-            data = BIT_CHECK(currentRuleStatus, dataRequested);
-          }
-          else { data = getData(dataRequested); }
-          data2 = page13.secondTarget[y];
-          
-          if ( (page13.operation[y].secondCompType == COMPARATOR_EQUAL) && (data == data2) ) { secondCheck = true; }
-          else if ( (page13.operation[y].secondCompType == COMPARATOR_NOT_EQUAL) && (data != data2) ) { secondCheck = true; }
-          else if ( (page13.operation[y].secondCompType == COMPARATOR_GREATER) && (data > data2) ) { secondCheck = true; }
-          else if ( (page13.operation[y].secondCompType == COMPARATOR_GREATER_EQUAL) && (data >= data2) ) { secondCheck = true; }
-          else if ( (page13.operation[y].secondCompType == COMPARATOR_LESS) && (data < data2) ) { secondCheck = true; }
-          else if ( (page13.operation[y].secondCompType == COMPARATOR_LESS_EQUAL) && (data <= data2) ) { secondCheck = true; }
-          else if ( (page13.operation[y].secondCompType == COMPARATOR_AND) && ((data & data2) != 0) ) { secondCheck = true; }
-          else if ( (page13.operation[y].secondCompType == COMPARATOR_XOR) && ((data ^ data2) != 0) ) { secondCheck = true; }
-
-          if (page13.operation[y].bitwise == BITWISE_AND) { firstCheck &= secondCheck; }
-          if (page13.operation[y].bitwise == BITWISE_OR) { firstCheck |= secondCheck; }
-          if (page13.operation[y].bitwise == BITWISE_XOR) { firstCheck ^= secondCheck; }
-        }
-      }
+      bool firstCheck = checkRule(ioRules[y], page13, y);
 
       //If the limiting time is active(>0) and using maximum time
       if (BIT_CHECK(page13.kindOfLimiting, y))
@@ -150,12 +367,17 @@ TESTABLE_STATIC void checkProgrammableIO(statuses& current, const config13& page
   }
 }
 
-// LCOV_EXCL_START
-void checkProgrammableIO(statuses& current, const config13& page13)
+#if defined(UNIT_TEST)
+/** @brief Compile the rules using an external data source, then check them */
+void checkProgrammableIO(statuses& current, const config13& page13, int16_t (*getData)(uint16_t index))
 {
-  checkProgrammableIO(current, page13, ProgrammableIOGetData);
+  pGetExternalData = getData;
+  compileProgrammableIO(page13);
+  checkProgrammableIO(current, page13);
+  pGetExternalData = nullptr;
 }
-// LCOV_EXCL_STOP
+#endif
+
 
 /** Get single I/O data var (from current) for comparison.
  * @param index - Field index/number (?)
@@ -21,5 +21,7 @@ constexpr uint8_t BITWISE_XOR = 3;
 constexpr uint8_t REUSE_RULES = 240;
 
 void initialiseProgrammableIO(statuses& current, const config13& page13);
+/** @brief Decode the page 13 rules. Must be called whenever page 13 changes */
+void compileProgrammableIO(const config13& page13);
 void checkProgrammableIO(statuses& current, const config13& page13);
 int16_t ProgrammableIOGetData(uint16_t index);
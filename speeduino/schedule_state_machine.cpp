@@ -5,7 +5,7 @@
 BEGIN_LTO_ALWAYS_INLINE(void) defaultPendingToRunning(Schedule *schedule) {
   schedule->_pStartCallback();
   schedule->_status = RUNNING; //Set the status to be in progress (ie The start callback has been called, but not the end callback)
-  SET_COMPARE(schedule->_compare, schedule->_counter + schedule->_duration);
+  SET_COMPARE(schedule->_compare, schedule->_counter + schedule->activeParams().duration);
 }
 END_LTO_INLINE()
 
@@ -17,13 +17,16 @@ END_LTO_INLINE()
 
 BEGIN_LTO_ALWAYS_INLINE(void) defaultRunningToPending(Schedule *schedule) {
   schedule->_pEndCallback();
-  SET_COMPARE(schedule->_compare, schedule->_nextStartCompare);
+  // Take over the queued event
+  schedule->_activeParams = schedule->_activeParams ^ 1U;
+  schedule->_hasNext = false;
+  SET_COMPARE(schedule->_compare, schedule->activeParams().startCompare);
   schedule->_status = PENDING;
 }
 END_LTO_INLINE()
 
 static inline bool hasNextSchedule(const Schedule &schedule) {
-  return schedule._status==RUNNING_WITHNEXT;
+  return schedule._hasNext;
 }
 
 BEGIN_LTO_ALWAYS_INLINE(void) movetoNextState(Schedule &schedule, 
@@ -2,6 +2,7 @@
 #include "board_definition.h"
 #include "scheduledIO_direct_ign.h"
 #include "src/pins/fastOutputPin.h"
+#include "src/pins/port_pin_group.h"
 #include "preprocessor.h"
 
 // LCOV_EXCL_START
@@ -25,12 +26,45 @@ using channelFunc = void(*)(uint8_t);
 static channelFunc coilChargingFn = coilHigh;
 static channelFunc coilDischargingFn = coilLow;
 
+// Output groups for the paired coil callbacks (E.g. beginCoil1and3Charge()), indexed by the first
+// channel (1-4) and the gap to the second channel (1-4). All are built when the pins are set, so
+// the callbacks only read them.
+static constexpr uint8_t MAX_PAIR_GROUPS = 4U;
+static constexpr uint8_t MAX_PAIR_SPAN = 4U;
+static port_pin_group_t<2U> pairGroups[MAX_PAIR_GROUPS][MAX_PAIR_SPAN];
+static bool isChargeLow = false;
+
+static void initPairGroups(void)
+{
+    for (uint8_t channelA = 1U; channelA <= MAX_PAIR_GROUPS; ++channelA)
+    {
+        for (uint8_t span = 1U; span <= MAX_PAIR_SPAN; ++span)
+        {
+            port_pin_group_t<2U> &group = pairGroups[channelA-1U][span-1U];
+            group.clear();
+            if ((uint8_t)(channelA+span) <= _countof(pins))
+            {
+                group.add(pins[channelA-1U]);
+                group.add(pins[channelA+span-1U]);
+            }
+        }
+    }
+}
+
+static inline port_pin_group_t<2U>& getPairGroup(uint8_t channelA, uint8_t channelB)
+{
+    INTERNAL_TEST_ASSERT(channelA>0 && channelA<=MAX_PAIR_GROUPS && channelB>channelA && (channelB-channelA)<=MAX_PAIR_SPAN && channelB<=_countof(pins));
+    return pairGroups[channelA-1U][channelB-channelA-1U];
+}
+
 void initIgnDirectIO(const config4 &page4, const coil_pins_t &coilPins)
 {
     for (uint8_t i = 0; i < _countof(pins); i++)
     {
         pins[i].setPin(coilPins[i], OUTPUT);
     }
+    initPairGroups();
+    isChargeLow = page4.IgInv == GOING_HIGH;
     if (page4.IgInv == GOING_HIGH)
     {
         coilChargingFn = coilLow;
@@ -53,4 +87,18 @@ void coilStopCharging_DIRECT(uint8_t channel)
     coilDischargingFn(channel);
 }
 
+void coilPairCharging_DIRECT(uint8_t channelA, uint8_t channelB)
+{
+    port_pin_group_t<2U> &group = getPairGroup(channelA, channelB);
+    if (isChargeLow) { group.setPinsLow(); }
+    else { group.setPinsHigh(); }
+}
+
+void coilPairStopCharging_DIRECT(uint8_t channelA, uint8_t channelB)
+{
+    port_pin_group_t<2U> &group = getPairGroup(channelA, channelB);
+    if (isChargeLow) { group.setPinsHigh(); }
+    else { group.setPinsLow(); }
+}
+
 // LCOV_EXCL_STOP
\ No newline at end of file
@@ -6,3 +6,12 @@ void initIgnDirectIO(const config4 &page4, const coil_pins_t &coilPins);
 
 void coilCharging_DIRECT(uint8_t channel);
 void coilStopCharging_DIRECT(uint8_t channel);
+
+/**
+ * @brief Start/stop charging 2 coils together. Coils on the same port switch in a single write.
+ * 
+ * @param channelA The channel of the schedule the callback is attached to (1-4)
+ * @param channelB The paired channel
+ */
+void coilPairCharging_DIRECT(uint8_t channelA, uint8_t channelB);
+void coilPairStopCharging_DIRECT(uint8_t channelA, uint8_t channelB);
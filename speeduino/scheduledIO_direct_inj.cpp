@@ -1,6 +1,7 @@
 #include "scheduledIO_direct_inj.h"
 #include "board_definition.h"
 #include "src/pins/fastOutputPin.h"
+#include "src/pins/port_pin_group.h"
 #include "preprocessor.h"
 #include "unit_testing.h"
 
@@ -9,12 +10,43 @@
 
 static fastOutputPin_t pins[_countof(injector_pins_t::_elements)];
 
+// Output groups for the paired injector callbacks (E.g. openInjector1and3()), indexed by the first
+// channel (1-4) and the gap to the second channel (1-4). All are built when the pins are set, so
+// the callbacks only read them.
+static constexpr uint8_t MAX_PAIR_GROUPS = 4U;
+static constexpr uint8_t MAX_PAIR_SPAN = 4U;
+static port_pin_group_t<2U> pairGroups[MAX_PAIR_GROUPS][MAX_PAIR_SPAN];
+
+static void initPairGroups(void)
+{
+    for (uint8_t channelA = 1U; channelA <= MAX_PAIR_GROUPS; ++channelA)
+    {
+        for (uint8_t span = 1U; span <= MAX_PAIR_SPAN; ++span)
+        {
+            port_pin_group_t<2U> &group = pairGroups[channelA-1U][span-1U];
+            group.clear();
+            if ((uint8_t)(channelA+span) <= _countof(pins))
+            {
+                group.add(pins[channelA-1U]);
+                group.add(pins[channelA+span-1U]);
+            }
+        }
+    }
+}
+
 void initInjDirectIO(const injector_pins_t &injPins)
 {
     for (uint8_t i = 0; i < _countof(injector_pins_t::_elements); i++)
     {
         pins[i].setPin(injPins[i], OUTPUT);
     }
+    initPairGroups();
+}
+
+static inline port_pin_group_t<2U>& getPairGroup(uint8_t channelA, uint8_t channelB)
+{
+    INTERNAL_TEST_ASSERT(channelA>0 && channelA<=MAX_PAIR_GROUPS && channelB>channelA && (channelB-channelA)<=MAX_PAIR_SPAN && channelB<=_countof(pins));
+    return pairGroups[channelA-1U][channelB-channelA-1U];
 }
 
 void openInjector_DIRECT(uint8_t channel)
@@ -28,4 +60,13 @@ void closeInjector_DIRECT(uint8_t channel)
     pins[channel-1U].setPinLow();
 }
 
+void openInjectorPair_DIRECT(uint8_t channelA, uint8_t channelB)
+{
+    getPairGroup(channelA, channelB).setPinsHigh();
+}
+void closeInjectorPair_DIRECT(uint8_t channelA, uint8_t channelB)
+{
+    getPairGroup(channelA, channelB).setPinsLow();
+}
+
 // LCOV_EXCL_STOP
\ No newline at end of file
@@ -5,3 +5,12 @@ void initInjDirectIO(const injector_pins_t &injPins);
 
 void openInjector_DIRECT(uint8_t channel);
 void closeInjector_DIRECT(uint8_t channel);
+
+/**
+ * @brief Open/close 2 injectors together. Injectors on the same port switch in a single write.
+ * 
+ * @param channelA The channel of the schedule the callback is attached to (1-4)
+ * @param channelB The paired channel
+ */
+void openInjectorPair_DIRECT(uint8_t channelA, uint8_t channelB);
+void closeInjectorPair_DIRECT(uint8_t channelA, uint8_t channelB);
@@ -66,6 +66,41 @@ void endCoilCharge(uint8_t channel)
     tachoOutputOff();
 }
 
+// Paired outputs change state together: a single port write per port for direct
+// outputs, a single SPI write for the MC33810
+static inline void beginCoilPairCharge(uint8_t channelA, uint8_t channelB)
+{
+#if defined(MC33810_SUPPORT)
+    if(!controlModeDirect)
+    {
+        mc33810_batch_t batch;
+        coilCharging_MC33810(channelA);
+        coilCharging_MC33810(channelB);
+    }
+    else
+#endif
+    {
+        coilPairCharging_DIRECT(channelA, channelB);
+    }
+    tachoOutputOn();
+}
+static inline void endCoilPairCharge(uint8_t channelA, uint8_t channelB)
+{
+#if defined(MC33810_SUPPORT)
+    if(!controlModeDirect)
+    {
+        mc33810_batch_t batch;
+        coilStopCharging_MC33810(channelA);
+        coilStopCharging_MC33810(channelB);
+    }
+    else
+#endif
+    {
+        coilPairStopCharging_DIRECT(channelA, channelB);
+    }
+    tachoOutputOff();
+}
+
 void beginCoil1Charge(void) { beginCoilCharge(1U); }
 void endCoil1Charge(void) { endCoilCharge(1U); }
 
@@ -92,31 +127,31 @@ void endCoil8Charge(void) { endCoilCharge(8U); }
 
 //The below 3 calls are all part of the rotary ignition mode
 void beginTrailingCoilCharge(void) { beginCoilCharge(2U); }
-void endTrailingCoilCharge1(void) { endCoilCharge(2U); beginCoilCharge(3U); } //Sets ign3 (Trailing select) high
-void endTrailingCoilCharge2(void) { endCoilCharge(2U); endCoilCharge(3U); } //sets ign3 (Trailing select) low
+void endTrailingCoilCharge1(void) { mc33810_batch_t batch; endCoilCharge(2U); beginCoilCharge(3U); } //Sets ign3 (Trailing select) high
+void endTrailingCoilCharge2(void) { endCoilPairCharge(2U, 3U); } //sets ign3 (Trailing select) low
 
 //As above but for ignition (Wasted COP mode)
-void beginCoil1and3Charge(void) { beginCoilCharge(1U); beginCoilCharge(3U); }
-void endCoil1and3Charge(void)   { endCoilCharge(1U);  endCoilCharge(3U); }
-void beginCoil2and4Charge(void) { beginCoilCharge(2U); beginCoilCharge(4U); }
-void endCoil2and4Charge(void)   { endCoilCharge(2U);  endCoilCharge(4U); }
+void beginCoil1and3Charge(void) { beginCoilPairCharge(1U, 3U); }
+void endCoil1and3Charge(void)   { endCoilPairCharge(1U, 3U); }
+void beginCoil2and4Charge(void) { beginCoilPairCharge(2U, 4U); }
+void endCoil2and4Charge(void)   { endCoilPairCharge(2U, 4U); }
 
 //For 6cyl wasted COP mode)
-void beginCoil1and4Charge(void) { beginCoilCharge(1U); beginCoilCharge(4U); }
-void endCoil1and4Charge(void)   { endCoilCharge(1U);  endCoilCharge(4U); }
-void beginCoil2and5Charge(void) { beginCoilCharge(2U); beginCoilCharge(5U); }
-void endCoil2and5Charge(void)   { endCoilCharge(2U);  endCoilCharge(5U); }
-void beginCoil3and6Charge(void) { beginCoilCharge(3U); beginCoilCharge(6U); }
-void endCoil3and6Charge(void)   { endCoilCharge(3U); endCoilCharge(6U); }
+void beginCoil1and4Charge(void) { beginCoilPairCharge(1U, 4U); }
+void endCoil1and4Charge(void)   { endCoilPairCharge(1U, 4U); }
+void beginCoil2and5Charge(void) { beginCoilPairCharge(2U, 5U); }
+void endCoil2and5Charge(void)   { endCoilPairCharge(2U, 5U); }
+void beginCoil3and6Charge(void) { beginCoilPairCharge(3U, 6U); }
+void endCoil3and6Charge(void)   { endCoilPairCharge(3U, 6U); }
 
 //For 8cyl wasted COP mode)
-void beginCoil1and5Charge(void) { beginCoilCharge(1U); beginCoilCharge(5U); }
-void endCoil1and5Charge(void)   { endCoilCharge(1U);  endCoilCharge(5U); }
-void beginCoil2and6Charge(void) { beginCoilCharge(2U); beginCoilCharge(6U); }
-void endCoil2and6Charge(void)   { endCoilCharge(2U);  endCoilCharge(6U); }
-void beginCoil3and7Charge(void) { beginCoilCharge(3U); beginCoilCharge(7U);  }
-void endCoil3and7Charge(void)   { endCoilCharge(3U); endCoilCharge(7U); }
-void beginCoil4and8Charge(void) { beginCoilCharge(4U); beginCoilCharge(8U); }
-void endCoil4and8Charge(void)   { endCoilCharge(4U);  endCoilCharge(8U); }
+void beginCoil1and5Charge(void) { beginCoilPairCharge(1U, 5U); }
+void endCoil1and5Charge(void)   { endCoilPairCharge(1U, 5U); }
+void beginCoil2and6Charge(void) { beginCoilPairCharge(2U, 6U); }
+void endCoil2and6Charge(void)   { endCoilPairCharge(2U, 6U); }
+void beginCoil3and7Charge(void) { beginCoilPairCharge(3U, 7U); }
+void endCoil3and7Charge(void)   { endCoilPairCharge(3U, 7U); }
+void beginCoil4and8Charge(void) { beginCoilPairCharge(4U, 8U); }
+void endCoil4and8Charge(void)   { endCoilPairCharge(4U, 8U); }
 
 // LCOV_EXCL_STOP
\ No newline at end of file
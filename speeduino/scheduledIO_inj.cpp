@@ -94,33 +94,66 @@ void closeInjector7(void)  { closeInjector(7); }
 void openInjector8(void)   { openInjector(8); }
 void closeInjector8(void)  { closeInjector(8); }
 
+// Paired outputs change state together: a single port write per port for direct
+// outputs, a single SPI write for the MC33810
+static inline void openInjectorPair(uint8_t channelA, uint8_t channelB)
+{
+#if defined(MC33810_SUPPORT)
+    if(!controlModeDirect) {
+        mc33810_batch_t batch;
+        openInjector_MC33810(channelA);
+        openInjector_MC33810(channelB);
+    } else
+#endif
+    {
+        openInjectorPair_DIRECT(channelA, channelB);
+    }
+    BIT_SET(injStatusMask, (channelA)-1U);
+    BIT_SET(injStatusMask, (channelB)-1U);
+}
+static inline void closeInjectorPair(uint8_t channelA, uint8_t channelB)
+{
+#if defined(MC33810_SUPPORT)
+    if(!controlModeDirect) {
+        mc33810_batch_t batch;
+        closeInjector_MC33810(channelA);
+        closeInjector_MC33810(channelB);
+    } else
+#endif
+    {
+        closeInjectorPair_DIRECT(channelA, channelB);
+    }
+    BIT_CLEAR(injStatusMask, (channelA)-1U);
+    BIT_CLEAR(injStatusMask, (channelB)-1U);
+}
+
 // These are for Semi-Sequential and 5 Cylinder injection
 //Standard 4 cylinder pairings
-void openInjector1and3(void) { openInjector(1U); openInjector(3U); }
-void closeInjector1and3(void) { closeInjector(1U); closeInjector(3U); }
-void openInjector2and4(void) { openInjector(2U); openInjector(4U); }
-void closeInjector2and4(void) { closeInjector(2U); closeInjector(4U); }
+void openInjector1and3(void) { openInjectorPair(1U, 3U); }
+void closeInjector1and3(void) { closeInjectorPair(1U, 3U); }
+void openInjector2and4(void) { openInjectorPair(2U, 4U); }
+void closeInjector2and4(void) { closeInjectorPair(2U, 4U); }
 //Alternative output pairings
-void openInjector1and4(void) { openInjector(1U); openInjector(4U); }
-void closeInjector1and4(void) { closeInjector(1U); closeInjector(4U); }
-void openInjector2and3(void) { openInjector(2U); openInjector(3U); }
-void closeInjector2and3(void) { closeInjector(2U); closeInjector(3U); }
-
-void openInjector3and5(void) { openInjector(3U); openInjector(5U); }
-void closeInjector3and5(void) { closeInjector(3U); closeInjector(5U); }
-
-void openInjector2and5(void) { openInjector(2U); openInjector(5U); }
-void closeInjector2and5(void) { closeInjector(2U); closeInjector(5U); }
-void openInjector3and6(void) { openInjector(3U); openInjector(6U); }
-void closeInjector3and6(void) { closeInjector(3U); closeInjector(6U); }
-
-void openInjector1and5(void) { openInjector(1U); openInjector(5U); }
-void closeInjector1and5(void) { closeInjector(1U); closeInjector(5U); }
-void openInjector2and6(void) { openInjector(2U); openInjector(6U); }
-void closeInjector2and6(void) { closeInjector(2U); closeInjector(6U); }
-void openInjector3and7(void) { openInjector(3U); openInjector(7U); }
-void closeInjector3and7(void) { closeInjector(3U); closeInjector(7U); }
-void openInjector4and8(void) { openInjector(4U); openInjector(8U); }
-void closeInjector4and8(void) { closeInjector(4U); closeInjector(8U); }
+void openInjector1and4(void) { openInjectorPair(1U, 4U); }
+void closeInjector1and4(void) { closeInjectorPair(1U, 4U); }
+void openInjector2and3(void) { openInjectorPair(2U, 3U); }
+void closeInjector2and3(void) { closeInjectorPair(2U, 3U); }
+
+void openInjector3and5(void) { openInjectorPair(3U, 5U); }
+void closeInjector3and5(void) { closeInjectorPair(3U, 5U); }
+
+void openInjector2and5(void) { openInjectorPair(2U, 5U); }
+void closeInjector2and5(void) { closeInjectorPair(2U, 5U); }
+void openInjector3and6(void) { openInjectorPair(3U, 6U); }
+void closeInjector3and6(void) { closeInjectorPair(3U, 6U); }
+
+void openInjector1and5(void) { openInjectorPair(1U, 5U); }
+void closeInjector1and5(void) { closeInjectorPair(1U, 5U); }
+void openInjector2and6(void) { openInjectorPair(2U, 6U); }
+void closeInjector2and6(void) { closeInjectorPair(2U, 6U); }
+void openInjector3and7(void) { openInjectorPair(3U, 7U); }
+void closeInjector3and7(void) { closeInjectorPair(3U, 7U); }
+void openInjector4and8(void) { openInjectorPair(4U, 8U); }
+void closeInjector4and8(void) { closeInjectorPair(4U, 8U); }
 
 // LCOV_EXCL_STOP
\ No newline at end of file
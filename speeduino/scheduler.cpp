@@ -31,13 +31,16 @@ A full copy of the license may be found in the projects root directory
 #include "units.h"
 #include "schedule_state_machine.h"
 #include "unit_testing.h"
+#include "atomic_profile.h"
 
 void nullCallback(void) { return; }
 
 void Schedule::reset(void)
 {
     _status = OFF;
+    _hasNext = false;
     setCallbacks(*this, nullCallback, nullCallback);
+    clearScheduleAtTooth(*this);
 }
 
 void IgnitionSchedule::reset(void) 
@@ -46,6 +49,8 @@ void IgnitionSchedule::reset(void)
     chargeAngle = 0;
     dischargeAngle = 0;
     channelDegrees = 0;
+    chargeTooth = toothAngle_t{ 0U, 0U };
+    _isDwellLimited = false;
 }
 
 void FuelSchedule::reset(void) 
@@ -69,46 +74,142 @@ static inline uint16_t clipDuration(uint16_t duration) {
   return duration;
 }
 
-static inline void setScheduleNext(Schedule &schedule, uint32_t delay, uint16_t duration) noexcept
+#if defined(NATIVE_BOARD) && !defined(NATIVE_VIRTUAL_TIME)
+// The native board runs the timer "ISRs" on their own thread, rather than as interrupts of the
+// main loop. The lock free handover relies on the latter, so the timers are stopped instead.
+#define SCHEDULE_HANDOVER() ATOMIC()
+#else
+#define SCHEDULE_HANDOVER()
+#endif
+
+static inline COMPARE_TYPE readCounter(const Schedule &schedule) noexcept
+{
+#if defined(CORE_AVR)
+  // 16-bit timer registers are read through a temporary register that the timer ISRs also use
+  ATOMIC_PROFILED(ATOMIC_SITE_SCHEDULE) {
+    return schedule._counter;
+  }
+  return 0U; // Never reached, just to avoid compiler warning
+#else
+  return schedule._counter;
+#endif
+}
+
+/** @brief Start the delay of an OFF or PENDING schedule. Returns false if the schedule started running in the meantime. */
+static inline bool armSchedule(Schedule &schedule, COMPARE_TYPE delay, COMPARE_TYPE duration) noexcept
 {
-  //The duration of the pulsewidth cannot be longer than the maximum timer period. This is unlikely as pulse widths should never get that long, but it's here for safety
-  //Duration can safely be set here as the schedule is already running at the previous duration value already used
-  schedule._duration = uS_TO_TIMER_COMPARE(clipDuration(duration));
-  schedule._nextStartCompare = schedule._counter + uS_TO_TIMER_COMPARE(delay);
-  schedule._status = RUNNING_WITHNEXT;
+  // The ISR doesn't read the next slot unless an event has been queued, which only happens while running
+  schedule.nextParams().duration = duration;
+
+  // The slot swap, compare register & status must change together: the ISR can fire at any point
+  ATOMIC_PROFILED(ATOMIC_SITE_SCHEDULE) {
+    if (isRunning(schedule)) {
+      return false;
+    }
+    schedule._activeParams = schedule._activeParams ^ 1U;
+    COMPARE_TYPE startCompare = schedule._counter + delay;
+    schedule.activeParams().startCompare = startCompare;
+    SET_COMPARE(schedule._compare, startCompare);
+    schedule._status = PENDING; //Turn this schedule on
+  }
+  return true;
 }
 
-static inline void setScheduleRunning(Schedule &schedule, uint32_t delay, uint16_t duration) noexcept
+/** @brief Queue an event behind the running one. Returns false if the schedule stopped running in the meantime. */
+static inline bool queueSchedule(Schedule &schedule, COMPARE_TYPE delay, COMPARE_TYPE duration) noexcept
 {
-  //The following must be enclosed in the noInterupts block to avoid contention caused if the relevant interrupt fires before the state is fully set
-  //The duration of the pulsewidth cannot be longer than the maximum timer period. This is unlikely as pulse widths should never get that long, but it's here for safety
-  schedule._duration = uS_TO_TIMER_COMPARE(clipDuration(duration));
-  SET_COMPARE(schedule._compare, schedule._counter + uS_TO_TIMER_COMPARE(delay));
-  schedule._status = PENDING; //Turn this schedule on
+  // Withdraw any queued event first, so the ISR can't take the slot while it is part written
+  schedule._hasNext = false;
+  if (!isRunning(schedule)) {
+    return false;
+  }
+
+  Schedule::params_t &next = schedule.nextParams();
+  next.duration = duration;
+  next.startCompare = readCounter(schedule) + delay;
+  schedule._hasNext = true; // Hand over to the ISR
+
+  // If the running event ended before the handover, the ISR went to OFF without seeing the queued event
+  if (!isRunning(schedule) && schedule._hasNext) {
+    schedule._hasNext = false;
+    return false;
+  }
+  return true;
 }
 
 void setSchedule(Schedule &schedule, uint32_t delay, uint16_t duration, bool allowQueuedSchedule)
 {
   if((delay>0U) && (delay < MAX_TIMER_PERIOD) && (duration > 0U))
   {
-    ATOMIC() 
+    //The duration of the pulsewidth cannot be longer than the maximum timer period. This is unlikely as pulse widths should never get that long, but it's here for safety
+    COMPARE_TYPE durationTicks = uS_TO_TIMER_COMPARE(clipDuration(duration));
+    COMPARE_TYPE delayTicks = uS_TO_TIMER_COMPARE(delay);
+
+    SCHEDULE_HANDOVER()
     {
-      //Check that we're not already part way through a schedule
-      if(!isRunning(schedule)) 
-      { 
-        setScheduleRunning(schedule, delay, duration);
-      }
-      // If the schedule is already running, we can queue up the next event.
-      else if(allowQueuedSchedule)
+      // Each retry needs the ISR to change the schedule state, so this normally runs once
+      bool isSet = false;
+      while (!isSet)
       {
-        setScheduleNext(schedule, delay, duration);
-      } else {
-        // Cannot schedule next event, as it would exceed the maximum future time
+        //Check that we're not already part way through a schedule
+        if(!isRunning(schedule)) 
+        { 
+          isSet = armSchedule(schedule, delayTicks, durationTicks);
+        }
+        // If the schedule is already running, we can queue up the next event.
+        else if(allowQueuedSchedule)
+        {
+          isSet = queueSchedule(schedule, delayTicks, durationTicks);
+        } else {
+          // Cannot schedule next event, as it would exceed the maximum future time
+          isSet = true;
+        }
       }
     }
   }  
 }
 
+void setScheduleAtTooth(Schedule &schedule, const toothAngle_t &position, uint16_t duration)
+{
+  // Only the main loop writes the registration, so it can be compared without disabling interrupts.
+  // It rarely changes between loops.
+  if ((schedule._armTooth!=position.tooth) || (schedule._armResidual!=position.residual) || (schedule._armDuration!=duration))
+  {
+    // The decoder ISR reads all 3 together
+    ATOMIC_PROFILED(ATOMIC_SITE_SCHEDULE) {
+      schedule._armTooth = position.tooth;
+      schedule._armResidual = position.residual;
+      schedule._armDuration = duration;
+    }
+  }
+}
+
+void clearScheduleAtTooth(Schedule &schedule)
+{
+  if (schedule._armTooth!=0U)
+  {
+    // A 16-bit write isn't atomic on AVR & a part written tooth could match another tooth
+    ATOMIC_PROFILED(ATOMIC_SITE_SCHEDULE) {
+      schedule._armTooth = 0U;
+    }
+  }
+}
+
+// Timer ticks, 0 if overdwell protection is off. Written by the main loop, read by the ignition timer ISRs
+static volatile COMPARE_TYPE maxDwellTicks = 0U;
+
+void setMaxDwell(uint32_t maxDwell_uS)
+{
+  COMPARE_TYPE ticks = uS_TO_TIMER_COMPARE(min(maxDwell_uS, (uint32_t)(MAX_TIMER_PERIOD - 1U)));
+  // Called every loop, but only changes with the tune & cranking state
+  if (ticks!=maxDwellTicks)
+  {
+    ATOMIC_PROFILED(ATOMIC_SITE_OVERDWELL) {
+      maxDwellTicks = ticks;
+    }
+  }
+}
+
 /**
  * @defgroup fuel-schedule-ISR Fuel schedule timer ISRs 
  *   
@@ -149,6 +250,26 @@ static inline void onEndIgnitionEvent(const IgnitionSchedule *pSchedule) {
   currentStatus.actualDwell = LOW_PASS_FILTER(elapsed, DWELL_AVERAGE_ALPHA, currentStatus.actualDwell);
 }
 
+/** @brief Arm the overdwell deadline as the coil starts charging & end the charge by it */
+static inline void armDwellLimit(IgnitionSchedule &schedule) {
+  COMPARE_TYPE limit = maxDwellTicks;
+  schedule._isDwellLimited = (limit!=0U);
+  if (schedule._isDwellLimited) {
+    schedule._dwellDeadline = schedule._counter + limit;
+    if (schedule.activeParams().duration > limit) {
+      SET_COMPARE(schedule._compare, schedule._dwellDeadline);
+    }
+  }
+}
+
+/** @brief Ticks from now until the end of a running charge, no later than its overdwell deadline */
+static inline COMPARE_TYPE limitDwellTicks(const IgnitionSchedule &schedule, COMPARE_TYPE now, COMPARE_TYPE ticks) {
+  if (schedule._isDwellLimited) {
+    return min((COMPARE_TYPE)(schedule._dwellDeadline - now), ticks);
+  }
+  return ticks;
+}
+
 /** @brief Called when the supplied schedule transitions from a PENDING state to RUNNING */
 BEGIN_LTO_ALWAYS_INLINE(void) static ignitionPendingToRunning(Schedule *pSchedule) {
   defaultPendingToRunning(pSchedule);
@@ -156,6 +277,7 @@ BEGIN_LTO_ALWAYS_INLINE(void) static ignitionPendingToRunning(Schedule *pSchedul
   // cppcheck-suppress misra-c2012-11.3 ; A cast from pointer to base to pointer to derived must point to the same location
   IgnitionSchedule *pIgnition = (IgnitionSchedule *)pSchedule;
   pIgnition->_startTime = micros();
+  armDwellLimit(*pIgnition);
 }
 END_LTO_INLINE()
 
@@ -184,14 +306,15 @@ void adjustCrankAngle(const statuses &current, IgnitionSchedule &schedule, int16
   constexpr uint8_t MIN_CYCLES_FOR_CORRECTION = 6U;
 
   crankAngle = ignitionLimits(crankAngle);
-  ATOMIC() { // Prevent race conditions with the timer interrupt.
+  ATOMIC_PROFILED(ATOMIC_SITE_SCHEDULE) { // Prevent race conditions with the timer interrupt.
     // We only want to adjust the crank angle if we are running and the coil is charging or we are waiting for the timer to fire.
     if( isRunning(schedule) ) {
       if  (schedule.dischargeAngle>crankAngle) { 
         // Coil is charging so change the charge time so the spark fires at
         // the requested crank angle (this could reduce dwell time & potentially
-        // result in a weaker spark).
-        SET_COMPARE(schedule._compare, schedule._counter + angleToTimerTicks( schedule.dischargeAngle-crankAngle )); 
+        // result in a weaker spark). The charge still can't run past the dwell limit.
+        COMPARE_TYPE now = schedule._counter;
+        SET_COMPARE(schedule._compare, now + limitDwellTicks(schedule, now, angleToTimerTicks( schedule.dischargeAngle-crankAngle ))); 
       } 
     }
     else if( (schedule._status==PENDING) ) {
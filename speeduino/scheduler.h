@@ -17,6 +17,10 @@ This means that the precision of the scheduler is:
 - 16uS (+/- 8uS of target) for fuel
 - 4uS (+/- 2uS) for ignition
 
+32-bit boards can instead run the schedules on 32-bit timers with a sub-µS tick (E.g. STM32F4 with
+SCHEDULE_TIMERS_32BIT, where COMPARE_TYPE is uint32_t). The maximum delay is then effectively
+unlimited, so the schedules never need to be limited or queued because of the timer period.
+
 ## Features
 
 This differs from most other schedulers in that its calls are non-recurring (ie when you schedule an event at a certain time and once it has occurred,
@@ -44,6 +48,7 @@ See page 136 of the processors datasheet: http://www.atmel.com/Images/doc2549.pd
 #include "board_definition.h"
 #include "crankMaths.h"
 #include "preprocessor.h"
+#include "decoder_t.h"
 
 /** \enum ScheduleStatus
  * @brief The current state of a schedule
@@ -55,10 +60,8 @@ enum ScheduleStatus {
   OFF              = 0b00000000U, 
   /** The delay phase of the schedule is active */
   PENDING          = 0b00000001U,
-  /** The schedule action is running */
+  /** The schedule action is running. A next schedule may be queued up: see Schedule::_hasNext */
   RUNNING          = 0b00000010U,
-  /** The schedule is running, with a next schedule queued up */
-  RUNNING_WITHNEXT = 0b00000100U,
 }; 
 
 /** @brief A scheduler callback that does nothing */
@@ -83,6 +86,22 @@ void nullCallback(void);
  * @par Timers are modelled as registers
  * Once set, Schedule instances are usually driven externally by a timer
  * ISR calling moveToNextState() periodically to update the schedule states.
+ * 
+ * @par Double buffered timing
+ * The event timing is held in 2 slots. activeParams() belongs to the timer ISR
+ * while the schedule is PENDING or RUNNING. The main loop writes the other slot
+ * (nextParams()) and hands it over by setting _hasNext. When the running action
+ * ends, the ISR swaps the slots and starts the queued event. So an event can be
+ * queued behind a running one right up to the end of the action, without
+ * disabling interrupts.
+ *
+ * @par Angle domain scheduling
+ * Normally the main loop converts the event angle to a delay & sets the schedule,
+ * so any change in RPM before the event starts is timing error. If the decoder can
+ * place the angle against a tooth (decoder_t::getToothAngle), the event can instead
+ * be registered with setScheduleAtTooth(). The primary trigger ISR then sets the
+ * schedule on that tooth, converting only the residual angle using the latest tooth
+ * period.
  */
 struct Schedule {
   // Deduce the real types of the counter and compare registers.
@@ -106,19 +125,29 @@ struct Schedule {
   }
 
   using callback = void(*)(void);
- 
-  /**
-   * @brief Scheduled duration (timer ticks) 
-   *
-   * This captures the duration of the *next* interval to be scheduled. I.e.
-   *  * Status==PENDING: this is the duration that will be used when the schedule moves to the RUNNING state 
-   *  * Status==RUNNING_WITHNEXT: this is the duration that will be used after the current schedule finishes and the queued up scheduled starts 
-   */
-  volatile COMPARE_TYPE _duration = 0U;
-  volatile ScheduleStatus _status = OFF;  ///< Schedule status: OFF, PENDING, STAGED, RUNNING
+
+  /** @brief The timing of one event */
+  struct params_t {
+    volatile COMPARE_TYPE duration;       ///< Action duration (timer ticks)
+    volatile COMPARE_TYPE startCompare;   ///< Timer compare value that starts the action
+  };
+
+  /** @brief The timing of the pending or running event. Owned by the timer ISR unless the schedule is OFF. */
+  params_t& activeParams(void) noexcept { return _params[_activeParams]; }
+  const params_t& activeParams(void) const noexcept { return _params[_activeParams]; }
+  /** @brief The timing of the next event. Written by the main loop. */
+  params_t& nextParams(void) noexcept { return _params[_activeParams ^ 1U]; }
+  const params_t& nextParams(void) const noexcept { return _params[_activeParams ^ 1U]; }
+
+  volatile ScheduleStatus _status = OFF;  ///< Schedule status: OFF, PENDING, RUNNING
   callback _pStartCallback = &nullCallback; ///< Start Callback function for schedule
   callback _pEndCallback = &nullCallback;   ///< End Callback function for schedule
-  COMPARE_TYPE _nextStartCompare = 0U;   ///< Planned start of next schedule (when current schedule is RUNNING)
+  params_t _params[2] = {};                 ///< Double buffered event timing. See activeParams() & nextParams()
+  volatile uint8_t _activeParams = 0U;      ///< Index of the active slot in _params
+  volatile bool _hasNext = false;           ///< nextParams() holds an event queued behind the running one
+  volatile uint16_t _armTooth = 0U;         ///< The decoder ISR sets the schedule when it sees this tooth. 0 if set by time
+  volatile uint16_t _armResidual = 0U;      ///< Crank degrees from _armTooth to the start of the action
+  volatile uint16_t _armDuration = 0U;      ///< Duration of the action set from _armTooth (µS)
   
   counter_t &_counter;       ///< **Reference** to the counter register. E.g. TCNT3
   compare_t &_compare;       ///< **Reference**to the compare register. E.g. OCR3A
@@ -132,10 +161,7 @@ protected:
  * I.e. the action has started, but not finished. E.g. injector is open
  */
 static inline bool isRunning(const Schedule &schedule) noexcept {
-  // Using flags and bitwise AND (&) to check multiple states is much quicker
-  // than a logical or (||) (one less branch & 30% less instructions)
-  static constexpr uint8_t flags = RUNNING | RUNNING_WITHNEXT;
-  return ((uint8_t)schedule._status & flags)!=0U;
+  return schedule._status==RUNNING;
 }
 
 /**
@@ -155,9 +181,26 @@ void setCallbacks(Schedule &schedule, Schedule::callback pStartCallback, Schedul
  * @param delay Delay until the action starts (µS)
  * @param duration Action duration (µS)
  * @param allowQueuedSchedule true to allow a schedule to be queued up if one is currently running; false otherwise
+ * 
+ * @note Queueing behind a running schedule doesn't disable interrupts (beyond reading the timer counter
+ * on AVR). Arming an OFF or PENDING schedule writes the timer compare register, so is a short atomic section.
  */
 void setSchedule(Schedule &schedule, uint32_t delay, uint16_t duration, bool allowQueuedSchedule);
 
+/**
+ * @brief Register the next event against a decoder tooth, rather than setting it by time.
+ * 
+ * The registration stands until changed or cleared: the event is set each time the tooth is seen.
+ * 
+ * @param schedule The schedule to modify
+ * @param position Where the action starts. See decoder_t::getToothAngle
+ * @param duration Action duration (µS)
+ */
+void setScheduleAtTooth(Schedule &schedule, const toothAngle_t &position, uint16_t duration);
+
+/** @brief Remove any tooth registration, so the schedule is only set by time. */
+void clearScheduleAtTooth(Schedule &schedule);
+
 /** @brief An ignition schedule.
  *
  * Goal is to fire the spark as close to the requested angle as possible.
@@ -174,19 +217,41 @@ void setSchedule(Schedule &schedule, uint32_t delay, uint16_t duration, bool all
  * 
  * Note that dwell times use uint16_t & therefore maximum dwell is 65.535ms. 
  * This limit is imposed elsewhere in Speeduino also.
+ *
+ * Decoders that support angle domain scheduling place chargeAngle against a tooth
+ * in decoder_t::setEndTeeth (chargeTooth).
+ *
+ * @par Overdwell protection
+ * When a coil starts charging, the timer ISR arms a deadline of setMaxDwell() ticks
+ * from that moment. The end of the charge is set no later than the deadline, both
+ * when it starts & when adjustCrankAngle() moves it. So the coil is cut off by its
+ * own timer compare, to timer resolution.
  */
 struct IgnitionSchedule : public Schedule {
 
   using Schedule::Schedule;
 
-  volatile uint32_t _startTime = 0U;///< The system time (in uS) that the schedule started, used by the overdwell protection in timers.ino
+  volatile uint32_t _startTime = 0U;///< The system time (in uS) that the schedule started, used to measure the actual dwell
   int16_t chargeAngle = 0U;         ///< Angle the coil should begin charging.
   int16_t dischargeAngle = 0U;      ///< Angle the coil should discharge at. I.e. spark.
   uint16_t channelDegrees = 0U;     ///< The number of crank degrees until cylinder is at TDC  
+  toothAngle_t chargeTooth = {};    ///< chargeAngle relative to the last tooth before it. Only set by decoders that support angle scheduling
+  volatile COMPARE_TYPE _dwellDeadline = 0U; ///< Timer compare value the running charge must end by. Only valid if _isDwellLimited
+  volatile bool _isDwellLimited = false;     ///< The running charge was started with overdwell protection on
 
   void reset(void) override;
 };
 
+
+/**
+ * @brief Set the longest time any coil may charge for.
+ * 
+ * Takes effect from the next time each coil starts charging.
+ * 
+ * @param maxDwell_uS Dwell limit (µS). Limited to the timer range. 0 turns overdwell protection off
+ */
+void setMaxDwell(uint32_t maxDwell_uS);
+
 /**
  * @brief Shared ignition schedule timer ISR *implementation*. Should be called by the actual ignition timer ISRs
  * (as timed interrupts) when either the start time or the duration time are reached. See @ref schedule-state-machine
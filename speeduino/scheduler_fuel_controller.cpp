@@ -3,6 +3,8 @@
 #include "units.h"
 #include "table2d.h"
 #include "globals.h"
+#include "engine_config.h"
+#include "atomic_profile.h"
 
 FuelSchedule fuelSchedule1(FUEL1_COUNTER, FUEL1_COMPARE); //cppcheck-suppress misra-c2012-8.4
 #if (INJ_CHANNELS >= 2)
@@ -136,15 +138,15 @@ static __attribute__((optimize("Os"))) void setupCallbacks(uint8_t injLayout, ui
 
 static inline bool isSwitchableCylinderCount(const config2 &page2)
 {
-  return (page2.nCylinders==4U)
-      || (page2.nCylinders==6U)
-      || (page2.nCylinders==8U)
+  return (getEngineCylinders(page2)==4U)
+      || (getEngineCylinders(page2)==6U)
+      || (getEngineCylinders(page2)==8U)
       ;
 }
 
 TESTABLE_INLINE_STATIC bool changeToSemiSequentialInjection(const config2 &page2, const decoder_status_t &decoderStatus)
 {
-  return (page2.injLayout == INJ_SEQUENTIAL) 
+  return (getEngineInjLayout(page2) == INJ_SEQUENTIAL) 
       && isSwitchableCylinderCount(page2)
       && (decoderStatus.syncStatus==SyncStatus::Partial)
       && (CRANK_ANGLE_MAX_INJ != 360U);
@@ -152,7 +154,7 @@ TESTABLE_INLINE_STATIC bool changeToSemiSequentialInjection(const config2 &page2
 
 TESTABLE_INLINE_STATIC bool changeToFullSequentialInjection(const config2 &page2, const decoder_status_t &decoderStatus)
 {
-  return (page2.injLayout == INJ_SEQUENTIAL) 
+  return (getEngineInjLayout(page2) == INJ_SEQUENTIAL) 
       && (decoderStatus.syncStatus==SyncStatus::Full)
       && (CRANK_ANGLE_MAX_INJ!=720U);
 }
@@ -185,27 +187,27 @@ TESTABLE_INLINE_STATIC bool isAnyFuelScheduleRunning(void) {
 
 static inline void changeFuellingToFullSequential(const config2 &page2, statuses &current)
 {
-  ATOMIC() {
+  ATOMIC_PROFILED(ATOMIC_SITE_SCHEDULE_MODE) {
     if( !isAnyFuelScheduleRunning() )
     {
       CRANK_ANGLE_MAX_INJ = 720;
-      current.numPrimaryInjOutputs = page2.nCylinders;
+      current.numPrimaryInjOutputs = getEngineCylinders(page2);
       current.injLayout = INJ_SEQUENTIAL;
-      setupCallbacks(INJ_SEQUENTIAL, page2.nCylinders, 0U);
+      setupCallbacks(INJ_SEQUENTIAL, getEngineCylinders(page2), 0U);
     }
   }
 }
 
 static inline void changeFuellingToSemiSequential(const config2 &page2, const config4 &page4, statuses &current)
 {
-  ATOMIC()
+  ATOMIC_PROFILED(ATOMIC_SITE_SCHEDULE_MODE)
   {
     if( !isAnyFuelScheduleRunning() )
     {
       CRANK_ANGLE_MAX_INJ = 360;
-      current.numPrimaryInjOutputs = page2.nCylinders/2U;
+      current.numPrimaryInjOutputs = getEngineCylinders(page2)/2U;
       current.injLayout = INJ_SEMISEQUENTIAL;
-      setupCallbacks(INJ_SEMISEQUENTIAL, page2.nCylinders, page4.inj4cylPairing);
+      setupCallbacks(INJ_SEMISEQUENTIAL, getEngineCylinders(page2), page4.inj4cylPairing);
     }
   }
 }
@@ -225,7 +227,7 @@ TESTABLE_STATIC void matchFuelSchedulersToSyncState(const config2 &page2, const
       changeFuellingToSemiSequential(page2, page4, current);
     } else {
       // Injection layout matches current sync
-      current.injLayout = page2.injLayout;
+      current.injLayout = getEngineInjLayout(page2);
     }
   }
 }
@@ -304,25 +306,51 @@ TESTABLE_INLINE_STATIC uint32_t calculateInjectorTimeout(const FuelSchedule &sch
   return angleToTime((uint16_t)delta);
 }
 
-TESTABLE_INLINE_STATIC void setFuelChannelSchedule(FuelSchedule &schedule, uint8_t channel, uint16_t crankAngle, byte injChannelMask, uint16_t injAngle, injectorAngleCalcCache *pCache) noexcept
+/**
+ * @brief Set the fuel schedule for one injector channel
+ * 
+ * @param getToothAngle If the decoder can place the open angle against a tooth, the injection is
+ * registered with setScheduleAtTooth() instead of set by time. nullptr to always set by time.
+ */
+TESTABLE_INLINE_STATIC void setFuelChannelSchedule(FuelSchedule &schedule, uint8_t channel, uint16_t crankAngle, byte injChannelMask, uint16_t injAngle, injectorAngleCalcCache *pCache, decoder_t::getToothAngle_t getToothAngle) noexcept
 {
   if( (schedule.pw != 0U) && (BIT_CHECK(injChannelMask, channel-1U)) )
   {
-    uint32_t timeOut = calculateInjectorTimeout(schedule, crankAngle, 
-                                                _calculateOpenAngle(schedule, updatePwAngleCache(schedule.pw, pCache), injAngle));
-    if (timeOut>0U)
+    uint16_t openAngle = _calculateOpenAngle(schedule, updatePwAngleCache(schedule.pw, pCache), injAngle);
+    toothAngle_t openTooth = (getToothAngle!=nullptr) ? getToothAngle((int16_t)openAngle, (uint16_t)CRANK_ANGLE_MAX_INJ) : toothAngle_t{ 0U, 0U };
+    if (openTooth.tooth!=0U)
     {
-      // Only queue up the next schedule if the maximum time between squirts (Based on CRANK_ANGLE_MAX_INJ) is less than the max timer period
-      setSchedule(schedule, timeOut, schedule.pw, angleToTime((uint16_t)CRANK_ANGLE_MAX_INJ) < MAX_TIMER_PERIOD);
+      // The decoder ISR sets the schedule when it reaches the tooth
+      setScheduleAtTooth(schedule, openTooth, schedule.pw);
     }
+    else
+    {
+      clearScheduleAtTooth(schedule);
+      uint32_t timeOut = calculateInjectorTimeout(schedule, crankAngle, openAngle);
+      if (timeOut>0U)
+      {
+        // Only queue up the next schedule if the maximum time between squirts (Based on CRANK_ANGLE_MAX_INJ) is less than the max timer period
+        setSchedule(schedule, timeOut, schedule.pw, angleToTime((uint16_t)CRANK_ANGLE_MAX_INJ) < MAX_TIMER_PERIOD);
+      }
+    }
+  }
+  else
+  {
+    clearScheduleAtTooth(schedule);
   }
 }
 
-TESTABLE_INLINE_STATIC uint16_t setFuelChannelSchedules(uint16_t crankAngle, byte injChannelMask, uint16_t injAngle)
+/**
+ * @brief Set the fuel schedules for the first numChannels injector channels.
+ * 
+ * Channels above numChannels are removed at compile time, rather than checked every loop.
+ */
+template <uint8_t numChannels>
+static void setFuelChannelSchedulesUpTo(uint16_t crankAngle, byte injChannelMask, uint16_t injAngle, decoder_t::getToothAngle_t getToothAngle)
 {
   injectorAngleCalcCache angleCalcCache;
 #define SET_FUEL_CHANNEL(channel) \
-  setFuelChannelSchedule(fuelSchedule ##channel, UINT8_C(channel), crankAngle, injChannelMask, injAngle, &angleCalcCache);
+  if (numChannels>=(channel)) { setFuelChannelSchedule(fuelSchedule ##channel, UINT8_C(channel), crankAngle, injChannelMask, injAngle, &angleCalcCache, getToothAngle); }
 
   SET_FUEL_CHANNEL(1)
 #if INJ_CHANNELS >= 2
@@ -348,7 +376,40 @@ TESTABLE_INLINE_STATIC uint16_t setFuelChannelSchedules(uint16_t crankAngle, byt
 #endif
 
 #undef SET_FUEL_CHANNEL
+}
 
+using setFuelChannelSchedulesFn = void (*)(uint16_t crankAngle, byte injChannelMask, uint16_t injAngle, decoder_t::getToothAngle_t getToothAngle);
+
+/** @brief setFuelChannelSchedules() dispatch table, indexed by the number of active injector channels (primary + secondary) */
+static constexpr setFuelChannelSchedulesFn fuelChannelSchedulesDispatch[INJ_CHANNELS+1U] = {
+  setFuelChannelSchedulesUpTo<0U>,
+  setFuelChannelSchedulesUpTo<1U>,
+#if INJ_CHANNELS >= 2
+  setFuelChannelSchedulesUpTo<2U>,
+#endif
+#if INJ_CHANNELS >= 3
+  setFuelChannelSchedulesUpTo<3U>,
+#endif
+#if INJ_CHANNELS >= 4
+  setFuelChannelSchedulesUpTo<4U>,
+#endif
+#if INJ_CHANNELS >= 5
+  setFuelChannelSchedulesUpTo<5U>,
+#endif
+#if INJ_CHANNELS >= 6
+  setFuelChannelSchedulesUpTo<6U>,
+#endif
+#if INJ_CHANNELS >= 7
+  setFuelChannelSchedulesUpTo<7U>,
+#endif
+#if INJ_CHANNELS >= 8
+  setFuelChannelSchedulesUpTo<8U>,
+#endif
+};
+
+TESTABLE_INLINE_STATIC uint16_t setFuelChannelSchedules(uint16_t crankAngle, byte injChannelMask, uint16_t injAngle)
+{
+  setFuelChannelSchedulesUpTo<INJ_CHANNELS>(crankAngle, injChannelMask, injAngle, nullptr);
   return injAngle;
 }
 
@@ -360,12 +421,19 @@ TESTABLE_INLINE_STATIC uint16_t injectorLimits(uint16_t angle)
 }
 
 // LCOV_EXCL_START
-BEGIN_LTO_ALWAYS_INLINE(uint16_t) __attribute__((flatten)) setFuelChannelSchedules(const statuses &current)
+BEGIN_LTO_ALWAYS_INLINE(uint16_t) setFuelChannelSchedules(const statuses &current)
 {
-  return setFuelChannelSchedules(
+  uint16_t injAngle = lookupInjectorAngle(current);
+  // The decoders don't run the per tooth timing while cranking
+  const decoder_t::getToothAngle_t getToothAngle = current.rotationStatus!=EngineRotationStatus::Cranking ? current.decoder.getToothAngle : nullptr;
+  // The active channel count only changes when the tune is loaded or the sync state changes,
+  // so this replaces a per channel check with a single table lookup.
+  fuelChannelSchedulesDispatch[min(getTotalInjChannelCount(current), (uint8_t)INJ_CHANNELS)](
     injectorLimits(current.decoder.getCrankAngle()),
     current.schedulerCutState.fuelChannels,
-    lookupInjectorAngle(current));
+    injAngle,
+    getToothAngle);
+  return injAngle;
 }
 // LCOV_EXCL_STOP
 
@@ -37,6 +37,9 @@ extern FuelSchedule fuelSchedule8;
 /**
  * @brief Schedule all fuel channels
  * 
+ * Channels the decoder can place against a tooth are registered with setScheduleAtTooth()
+ * instead, unless cranking.
+ * 
  * @param current Current system state
  * @return The injector angle used.
  */
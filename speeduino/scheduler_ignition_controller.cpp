@@ -1,9 +1,10 @@
 #include "scheduler_ignition_controller.h"
 #include "scheduledIO_ign.h"
-#include "elapsed_time.h"
 #include "scheduledIO_ign.h"
 #include "globals.h"
 #include "unit_testing.h"
+#include "engine_config.h"
+#include "atomic_profile.h"
 
 IgnitionSchedule ignitionSchedule1(IGN1_COUNTER, IGN1_COMPARE); //cppcheck-suppress misra-c2012-8.4
 #if IGN_CHANNELS >= 2
@@ -504,45 +505,45 @@ TESTABLE_INLINE_STATIC bool isAnyIgnScheduleRunning(void) {
 
 static inline bool isSwitchableCylinderCount(const config2 &page2)
 {
-  return (page2.nCylinders==4U)
-      || (page2.nCylinders==6U)
-      || (page2.nCylinders==8U)
+  return (getEngineCylinders(page2)==4U)
+      || (getEngineCylinders(page2)==6U)
+      || (getEngineCylinders(page2)==8U)
       ;
 }
 
 static inline bool isSemiSequentialIgnition(const config2 &page2, const config4 &page4, const decoder_status_t &decoderStatus)
 {
-  return (page4.sparkMode == IGN_MODE_SEQUENTIAL) 
+  return (getEngineSparkMode(page4) == IGN_MODE_SEQUENTIAL) 
       && isSwitchableCylinderCount(page2)
       && decoderStatus.syncStatus==SyncStatus::Partial;
 }
 
 static inline bool isFullSequentialIgnition(const config4 &page4, const decoder_status_t &decoderStatus)
 {
-  return (page4.sparkMode == IGN_MODE_SEQUENTIAL) 
+  return (getEngineSparkMode(page4) == IGN_MODE_SEQUENTIAL) 
       && decoderStatus.syncStatus==SyncStatus::Full;
 }
 
 TESTABLE_STATIC void changeIgnitionToHalfSync(const config2 &page2, statuses &current)
 {
-  ATOMIC()
+  ATOMIC_PROFILED(ATOMIC_SITE_SCHEDULE_MODE)
   {
     if (!isAnyIgnScheduleRunning() && isSwitchableCylinderCount(page2)) {
       CRANK_ANGLE_MAX_IGN = 360;
-      current.maxIgnOutputs = page2.nCylinders/2U;
-      setCallbacks(IGN_MODE_WASTEDCOP, page2.nCylinders, 0U);
+      current.maxIgnOutputs = getEngineCylinders(page2)/2U;
+      setCallbacks(IGN_MODE_WASTEDCOP, getEngineCylinders(page2), 0U);
     }
   }
 }
 
 TESTABLE_STATIC void changeIgnitionToFullSequential(const config2 &page2, statuses &current)
 {
-  ATOMIC()
+  ATOMIC_PROFILED(ATOMIC_SITE_SCHEDULE_MODE)
   {
     if (!isAnyIgnScheduleRunning() && isSwitchableCylinderCount(page2)) {
       CRANK_ANGLE_MAX_IGN = 720;
-      current.maxIgnOutputs = min((uint8_t)IGN_CHANNELS, page2.nCylinders);
-      setCallbacks(IGN_MODE_SEQUENTIAL, page2.nCylinders, 0U);
+      current.maxIgnOutputs = min((uint8_t)IGN_CHANNELS, getEngineCylinders(page2));
+      setCallbacks(IGN_MODE_SEQUENTIAL, getEngineCylinders(page2), 0U);
     }
   }
 }
@@ -575,12 +576,14 @@ TESTABLE_INLINE_STATIC void calculateIgnitionAngles(IgnitionSchedule &schedule,
 {
   schedule.dischargeAngle = _calculateSparkAngle(schedule,  advance);
   schedule.chargeAngle = _calculateCoilChargeAngle(dwellAngle, schedule.dischargeAngle);
+  schedule.chargeTooth.tooth = 0U; // The decoder sets this again if it can. See decoder_t::setEndTeeth
 }
 
 TESTABLE_STATIC void calculateIgnitionTrailingRotary(IgnitionSchedule &leading, uint16_t dwellAngle, int16_t rotarySplitDegrees, IgnitionSchedule &trailing) 
 {
   trailing.dischargeAngle = (int16_t)ignitionLimits(leading.dischargeAngle + rotarySplitDegrees);
   trailing.chargeAngle = (int16_t)ignitionLimits(trailing.dischargeAngle - (int16_t)dwellAngle); 
+  trailing.chargeTooth.tooth = 0U;
 }
 
 static inline void calculateRotaryIgnitionAngles(uint16_t dwellAngle, const statuses &current)
@@ -660,7 +663,7 @@ BEGIN_LTO_ALWAYS_INLINE(void) __attribute__((flatten)) calculateIgnitionAngles(c
 
   uint16_t dwellAngle = timeToAngle(current.dwell);
 
-  if((current.maxIgnOutputs==4U) && (page4.sparkMode == IGN_MODE_ROTARY))
+  if((current.maxIgnOutputs==4U) && (getEngineSparkMode(page4) == IGN_MODE_ROTARY))
   {
     calculateRotaryIgnitionAngles(dwellAngle, current);
   }
@@ -685,16 +688,29 @@ TESTABLE_INLINE_STATIC uint32_t _calculateIgnitionTimeout(const IgnitionSchedule
   return _calculateAngularTime(schedule, schedule.channelDegrees, schedule.chargeAngle, crankAngle, CRANK_ANGLE_MAX_IGN);
 }
 
-static inline void setIgnitionChannel(IgnitionSchedule &schedule, uint16_t crankAngle, uint16_t dwellDuration, byte channelMask, uint8_t channelIdx)
+static inline void setIgnitionChannel(IgnitionSchedule &schedule, uint16_t crankAngle, uint16_t dwellDuration, byte channelMask, uint8_t channelIdx, bool allowToothSchedule)
 {
   if (BIT_CHECK(channelMask, (channelIdx)-1U)) {
-    setIgnitionScheduleDuration(schedule, _calculateIgnitionTimeout(schedule, crankAngle), dwellDuration);
+    if (allowToothSchedule && (schedule.chargeTooth.tooth!=0U)) {
+      // The decoder ISR sets the schedule when it reaches the tooth
+      setScheduleAtTooth(schedule, schedule.chargeTooth, dwellDuration);
+    } else {
+      clearScheduleAtTooth(schedule);
+      setIgnitionScheduleDuration(schedule, _calculateIgnitionTimeout(schedule, crankAngle), dwellDuration);
+    }
+  } else {
+    clearScheduleAtTooth(schedule);
   }
 }
 
-BEGIN_LTO_ALWAYS_INLINE(void) __attribute__((flatten)) setIgnitionChannels(const statuses &current, uint16_t crankAngle, uint16_t dwellTime) {
-  crankAngle = ignitionLimits(crankAngle);
-  #define SET_IGNITION_CHANNEL(channelIdx) setIgnitionChannel(ignitionSchedule ##channelIdx, crankAngle, dwellTime, current.schedulerCutState.ignitionChannels, channelIdx);
+/**
+ * @brief setIgnitionChannels() specialised for the number of active ignition outputs.
+ * 
+ * Channels above numChannels are removed at compile time, rather than checked every loop.
+ */
+template <uint8_t numChannels>
+static void setIgnitionChannelsUpTo(uint16_t crankAngle, uint16_t dwellTime, byte channelMask, bool allowToothSchedule) {
+  #define SET_IGNITION_CHANNEL(channelIdx) if (numChannels>=(channelIdx)) { setIgnitionChannel(ignitionSchedule ##channelIdx, crankAngle, dwellTime, channelMask, channelIdx, allowToothSchedule); }
 
   SET_IGNITION_CHANNEL(1)
 #if IGN_CHANNELS >= 2
@@ -721,62 +737,54 @@ BEGIN_LTO_ALWAYS_INLINE(void) __attribute__((flatten)) setIgnitionChannels(const
 
 #undef SET_IGNITION_CHANNEL
 }
-END_LTO_INLINE()
 
-TESTABLE_INLINE_STATIC void applyChannelOverDwellProtection(IgnitionSchedule &schedule, uint32_t now, uint32_t dwellLimit_uS) {
-    if (isRunning(schedule) && hasIntervalElapsed(now, schedule._startTime, dwellLimit_uS)) {
-      moveToNextState(schedule); //Call the end function to disable the spark output
-    }
-}
+using setIgnitionChannelsFn = void (*)(uint16_t crankAngle, uint16_t dwellTime, byte channelMask, bool allowToothSchedule);
 
-// LCOV_EXCL_START
-// The lower level function should be tested, so this can be excluded from coverage
-static void applyChannelOverDwellProtection(IgnitionSchedule &schedule, uint32_t dwellLimit_uS) {
-  //Check first whether each spark output is currently on. Only check it's dwell time if it is
-  ATOMIC() {
-    uint32_t now = micros(); // This **must** be inside the atomic block to avoid a race. See #1581
-    applyChannelOverDwellProtection(schedule, now, dwellLimit_uS);
-  }
-}
-// LCOV_EXCL_STOP
-
-TESTABLE_INLINE_STATIC bool isOverDwellActive(const config4 &page4, const statuses &current){
-  bool isCrankLocked = page4.ignCranklock && (current.RPM < current.crankRPM); //Dwell limiter is disabled during cranking on setups using the locked cranking timing. WE HAVE to do the RPM check here as relying on the engine cranking bit can be potentially too slow in updating
-  return (page4.useDwellLim) && !isCrankLocked;
-}
-
-// LCOV_EXCL_START
-// The lower level function should be tested, so this can be excluded from coverage
-void applyOverDwellProtection(const config4 &page4, const statuses &current)
-{
-  if (isOverDwellActive(page4, current)) {
-    uint32_t dwellLimit_uS = page4.dwellLimit * 1000U; //Convert to uS
-
-    applyChannelOverDwellProtection(ignitionSchedule1, dwellLimit_uS);
+/** @brief setIgnitionChannels() dispatch table, indexed by the number of active ignition outputs (@ref statuses.maxIgnOutputs) */
+static constexpr setIgnitionChannelsFn ignitionChannelsDispatch[IGN_CHANNELS+1U] = {
+  setIgnitionChannelsUpTo<0U>,
+  setIgnitionChannelsUpTo<1U>,
 #if IGN_CHANNELS >= 2
-    applyChannelOverDwellProtection(ignitionSchedule2, dwellLimit_uS);
+  setIgnitionChannelsUpTo<2U>,
 #endif
 #if IGN_CHANNELS >= 3
-    applyChannelOverDwellProtection(ignitionSchedule3, dwellLimit_uS);
+  setIgnitionChannelsUpTo<3U>,
 #endif
 #if IGN_CHANNELS >= 4
-    applyChannelOverDwellProtection(ignitionSchedule4, dwellLimit_uS);
+  setIgnitionChannelsUpTo<4U>,
 #endif
 #if IGN_CHANNELS >= 5
-    applyChannelOverDwellProtection(ignitionSchedule5, dwellLimit_uS);
+  setIgnitionChannelsUpTo<5U>,
 #endif
 #if IGN_CHANNELS >= 6
-    applyChannelOverDwellProtection(ignitionSchedule6, dwellLimit_uS);
+  setIgnitionChannelsUpTo<6U>,
 #endif
 #if IGN_CHANNELS >= 7
-    applyChannelOverDwellProtection(ignitionSchedule7, dwellLimit_uS);
+  setIgnitionChannelsUpTo<7U>,
 #endif
 #if IGN_CHANNELS >= 8
-    applyChannelOverDwellProtection(ignitionSchedule8, dwellLimit_uS);
+  setIgnitionChannelsUpTo<8U>,
 #endif
-  }
+};
+
+BEGIN_LTO_ALWAYS_INLINE(void) setIgnitionChannels(const statuses &current, uint16_t crankAngle, uint16_t dwellTime) {
+  // maxIgnOutputs only changes when the tune is loaded or the sync state changes,
+  // so this replaces a per channel check with a single table lookup.
+  // The decoders don't run the per tooth timing while cranking
+  const bool allowToothSchedule = current.rotationStatus!=EngineRotationStatus::Cranking;
+  ignitionChannelsDispatch[min(current.maxIgnOutputs, (uint8_t)IGN_CHANNELS)](ignitionLimits(crankAngle), dwellTime, current.schedulerCutState.ignitionChannels, allowToothSchedule);
+}
+END_LTO_INLINE()
+
+TESTABLE_INLINE_STATIC bool isOverDwellActive(const config4 &page4, const statuses &current){
+  bool isCrankLocked = page4.ignCranklock && (current.RPM < current.crankRPM); //Dwell limiter is disabled during cranking on setups using the locked cranking timing. WE HAVE to do the RPM check here as relying on the engine cranking bit can be potentially too slow in updating
+  return (page4.useDwellLim) && !isCrankLocked;
+}
+
+void applyOverDwellProtection(const config4 &page4, const statuses &current)
+{
+  setMaxDwell(isOverDwellActive(page4, current) ? page4.dwellLimit * 1000UL : 0UL); //Convert to uS
 }
-// LCOV_EXCL_STOP
 
 void __attribute__((optimize("Os"))) startIgnitionSchedulers(void)
 {
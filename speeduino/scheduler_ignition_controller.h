@@ -27,13 +27,13 @@ extern IgnitionSchedule ignitionSchedule8;
 #endif
 
 /**
- * @brief Check that no ignition channel has been charging the coil for too long
+ * @brief Set the over dwell protection limit from the tune & engine state
  * 
- * The over dwell protection system runs independently of the standard ignition 
- * schedules and monitors the time that each ignition output has been active. If the 
- * active time exceeds the tune defined amount, the output will be ended to prevent damage to coils.
+ * The ignition timer ISRs arm the limit as each coil starts charging, so the
+ * output is ended by the schedule's own timer before the tune defined amount
+ * is exceeded. This prevents damage to coils.
  * 
- * @note Must be called once per millisecond by an **external** timer.
+ * @note Call from the main loop. The limit is off while the cranking timing is locked.
  */
 void applyOverDwellProtection(const config4 &page4, const statuses &current);
 
@@ -50,6 +50,9 @@ void calculateIgnitionAngles(const config2 &page2, const config4 &page4, const c
 /**
  * @brief Schedule all ignition channels
  * 
+ * Channels the decoder has placed against a tooth are registered with setScheduleAtTooth()
+ * instead, unless cranking.
+ * 
  * @param current Current system state
  * @param crankAngle Crank angle
  * @param dwellTime Target dwell time
@@ -22,7 +22,7 @@ A full copy of the license may be found in the projects root directory
 #include "unit_testing.h"
 #include "sensors_map_structs.h"
 #include "units.h"
-#include "atomic.h"
+#include "atomic_profile.h"
 #include "board_definition.h"
 #include "preprocessor.h"
 #include "static_for.hpp"
@@ -315,7 +315,7 @@ static inline bool cycleAverageEndCycle(const statuses &current, map_cycle_avera
 }
 
 static inline bool isCycleCurrent(const statuses &current, uint32_t cycleStartIndex) {
-  ATOMIC() {
+  ATOMIC_PROFILED(ATOMIC_SITE_SENSORS) {
     return (cycleStartIndex == (uint8_t)current.startRevolutions) || ((cycleStartIndex+1U) == (uint8_t)current.startRevolutions);
   }
   return false; // Just here to avoid compiler warning.
@@ -326,7 +326,7 @@ static inline bool isCycleCurrent(const statuses &current, const map_cycle_avera
 }
 
 TESTABLE_INLINE_STATIC bool canUseCycleAverage(const statuses &current, const config2 &page2) {
-  ATOMIC() {
+  ATOMIC_PROFILED(ATOMIC_SITE_SENSORS) {
     return (current.RPMdiv100 > page2.mapSwitchPoint) && current.decoder.getStatus().syncStatus!=SyncStatus::None && (current.startRevolutions > 1U);
   }
   return false; // Just here to avoid compiler warning.
@@ -401,7 +401,7 @@ static inline bool eventAverageAccumulate(map_event_average_t &eventAverage, con
 }
 
 static inline bool isIgnitionEventValid(const map_event_average_t &eventAverage) {
-  ATOMIC() {
+  ATOMIC_PROFILED(ATOMIC_SITE_SENSORS) {
     return (eventAverage.eventStartIndex < (uint8_t)ignitionCount);
   }
   return false; // Just here to avoid compiler warning.
@@ -432,7 +432,7 @@ static inline bool eventAverageEndEvent(map_event_average_t &eventAverage, map_a
 }
 
 static inline bool isIgnitionEventCurrent(const map_event_average_t &eventAverage) {
-  ATOMIC() {
+  ATOMIC_PROFILED(ATOMIC_SITE_SENSORS) {
     return (eventAverage.eventStartIndex == (uint8_t)ignitionCount);
   }
   return false; // Just here to avoid compiler warning.
@@ -440,7 +440,7 @@ static inline bool isIgnitionEventCurrent(const map_event_average_t &eventAverag
 
 
 TESTABLE_INLINE_STATIC bool canUseEventAverage(const statuses &current, const config2 &page2) {
-  ATOMIC() {
+  ATOMIC_PROFILED(ATOMIC_SITE_SENSORS) {
     return (current.RPMdiv100 > page2.mapSwitchPoint) && (current.decoder.getStatus().syncStatus!=SyncStatus::None) && (current.startRevolutions > 1U) && (!current.engineProtect.isActive());
   }
   return false; // Just here to avoid compiler warning.
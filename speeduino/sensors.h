@@ -77,6 +77,9 @@ void initialiseCLT(void);
 /** @brief Define the baro sensor read frequency. */
 #define BARO_READ_TIMER_BIT BIT_TIMER_1HZ
 
+/** @brief Define the flex sensor read frequency (ethanol % & fuel temperature are updated once per second in oneMSInterval()). */
+#define FLEX_READ_TIMER_BIT BIT_TIMER_1HZ
+
 /** @brief Define the MAP sensor read frequency. */
 #define MAP_READ_TIMER_BIT BIT_TIMER_1KHZ
 
@@ -0,0 +1,211 @@
+#include "softPwm.h"
+#include "atomic_profile.h"
+
+void softPwmInit(softPwmEngine_t &engine)
+{
+  for (uint8_t channel=0U; channel<SOFT_PWM_MAX_CHANNELS; ++channel)
+  {
+    engine.channels[channel] = softPwmChannel_t{ {nullptr, nullptr, nullptr}, 0U, 0U, 0U, true, false };
+  }
+  engine.edgeCount = 0U;
+}
+
+void softPwmConfigure(softPwmEngine_t &engine, uint8_t channel, const softPwmOutput_t &output, uint16_t periodTicks)
+{
+  softPwmChannel_t &pwm = engine.channels[channel];
+  pwm.output = output;
+  // Edges are ordered using signed differences, so the period must fit in an int16_t
+  pwm.periodTicks = periodTicks==0U ? 1U : periodTicks>(uint16_t)INT16_MAX ? (uint16_t)INT16_MAX : periodTicks;
+}
+
+// Insert a channel into the edge list, after any channels with the same edge time
+static void insertEdge(softPwmEngine_t &engine, uint8_t channel)
+{
+  uint16_t edge = engine.channels[channel].nextEdge;
+  uint8_t index = engine.edgeCount;
+  while ( (index>0U) && ((int16_t)(edge - engine.channels[engine.edgeOrder[index-1U]].nextEdge) < 0) )
+  {
+    engine.edgeOrder[index] = engine.edgeOrder[index-1U];
+    --index;
+  }
+  engine.edgeOrder[index] = channel;
+  ++engine.edgeCount;
+}
+
+static void removeEdge(softPwmEngine_t &engine, uint8_t channel)
+{
+  uint8_t index = 0U;
+  while ( (index<engine.edgeCount) && (engine.edgeOrder[index]!=channel) ) { ++index; }
+  if (index<engine.edgeCount)
+  {
+    --engine.edgeCount;
+    for (; index<engine.edgeCount; ++index)
+    {
+      engine.edgeOrder[index] = engine.edgeOrder[index+1U];
+    }
+  }
+}
+
+bool softPwmEnable(softPwmEngine_t &engine, uint8_t channel, uint16_t nowTicks)
+{
+  softPwmChannel_t &pwm = engine.channels[channel];
+  if (pwm.isEnabled) { return false; }
+
+  pwm.isEnabled = true;
+  pwm.isPeriodStart = true;
+  pwm.nextEdge = nowTicks;
+  insertEdge(engine, channel);
+  return true;
+}
+
+void softPwmDisable(softPwmEngine_t &engine, uint8_t channel)
+{
+  softPwmChannel_t &pwm = engine.channels[channel];
+  if (pwm.isEnabled)
+  {
+    pwm.isEnabled = false;
+    removeEdge(engine, channel);
+  }
+}
+
+// Toggle the output & calculate the following edge. Edges are scheduled from the
+// previous *scheduled* edge, not the service time, so ISR latency doesn't shift the phase.
+static inline void serviceEdge(softPwmChannel_t &pwm)
+{
+  if (pwm.isPeriodStart)
+  {
+    uint16_t duty = pwm.output.pGetDuty();
+    pwm.dutyTicks = duty>pwm.periodTicks ? pwm.periodTicks : duty;
+    if (pwm.dutyTicks==0U)
+    {
+      pwm.output.pInactive();
+      pwm.nextEdge = pwm.nextEdge + pwm.periodTicks;
+    }
+    else if (pwm.dutyTicks==pwm.periodTicks)
+    {
+      pwm.output.pActive();
+      pwm.nextEdge = pwm.nextEdge + pwm.periodTicks;
+    }
+    else
+    {
+      pwm.output.pActive();
+      pwm.nextEdge = pwm.nextEdge + pwm.dutyTicks;
+      pwm.isPeriodStart = false;
+    }
+  }
+  else
+  {
+    pwm.output.pInactive();
+    pwm.nextEdge = pwm.nextEdge + (uint16_t)(pwm.periodTicks - pwm.dutyTicks);
+    pwm.isPeriodStart = true;
+  }
+}
+
+static inline bool isEdgeDue(uint16_t edge, uint16_t nowTicks)
+{
+  return (int16_t)(edge - nowTicks) <= (int16_t)SOFT_PWM_MIN_LEAD_TICKS;
+}
+
+bool softPwmService(softPwmEngine_t &engine, uint16_t nowTicks, uint16_t &nextCompare)
+{
+  if (engine.edgeCount==0U) { return false; }
+
+  uint8_t budget = (uint8_t)(engine.edgeCount * 2U);
+  while ( (budget>0U) && isEdgeDue(engine.channels[engine.edgeOrder[0]].nextEdge, nowTicks) )
+  {
+    uint8_t channel = engine.edgeOrder[0];
+    serviceEdge(engine.channels[channel]);
+    // Pop the head & re-insert in order
+    removeEdge(engine, channel);
+    insertEdge(engine, channel);
+    --budget;
+  }
+
+  uint16_t headEdge = engine.channels[engine.edgeOrder[0]].nextEdge;
+  // If we ran out of budget, come back as soon as possible for the rest
+  nextCompare = isEdgeDue(headEdge, nowTicks) ? (uint16_t)(nowTicks + SOFT_PWM_MIN_LEAD_TICKS) : headEdge;
+  return true;
+}
+
+uint32_t getAuxPwmHardwareDuty(uint16_t dutyTicks, uint16_t periodTicks, uint8_t resolutionBits, bool isActiveLow)
+{
+  uint32_t duty = dutyTicks > periodTicks ? periodTicks : dutyTicks;
+  uint32_t value = (duty << resolutionBits) / periodTicks;
+  if (isActiveLow) { value = (1UL << resolutionBits) - value; }
+  return value;
+}
+
+#if defined(SOFT_PWM_ENGINE)
+
+static_assert(AUX_PWM_CHANNEL_COUNT<=SOFT_PWM_MAX_CHANNELS, "Too many auxiliary PWM channels");
+
+static softPwmEngine_t auxPwm;
+
+// The board timer counter may be wider than 16 bits (E.g. native), so the compare
+// register is always programmed relative to the current counter value.
+static inline void setAuxPwmCompare(uint16_t nowTicks, uint16_t nextCompare)
+{
+  SET_COMPARE(SOFT_PWM_TIMER_COMPARE, SOFT_PWM_TIMER_COUNTER + (uint16_t)(nextCompare - nowTicks));
+}
+
+void configureAuxPwm(uint8_t channel, const softPwmOutput_t &output, uint16_t periodTicks)
+{
+  // auxPwm is zero initialised, so no softPwmInit() call is required.
+  ATOMIC_PROFILED(ATOMIC_SITE_AUX_PWM)
+  {
+    softPwmConfigure(auxPwm, channel, output, periodTicks);
+  }
+}
+
+void enableAuxPwm(uint8_t channelMask)
+{
+  ATOMIC_PROFILED(ATOMIC_SITE_AUX_PWM)
+  {
+    uint16_t nowTicks = (uint16_t)SOFT_PWM_TIMER_COUNTER;
+    bool isStarted = false;
+    for (uint8_t channel=0U; channel<AUX_PWM_CHANNEL_COUNT; ++channel)
+    {
+      if ( ((channelMask & AUX_PWM_BIT(channel))!=0U) && (auxPwm.channels[channel].output.pGetDuty!=nullptr) )
+      {
+        isStarted = softPwmEnable(auxPwm, channel, nowTicks) || isStarted;
+      }
+    }
+    // New channels start immediately: let the ISR pick them up
+    if (isStarted)
+    {
+      setAuxPwmCompare(nowTicks, (uint16_t)(nowTicks + SOFT_PWM_MIN_LEAD_TICKS));
+      ENABLE_SOFT_PWM_TIMER();
+    }
+  }
+}
+
+void disableAuxPwm(uint8_t channelMask)
+{
+  ATOMIC_PROFILED(ATOMIC_SITE_AUX_PWM)
+  {
+    for (uint8_t channel=0U; channel<AUX_PWM_CHANNEL_COUNT; ++channel)
+    {
+      if ((channelMask & AUX_PWM_BIT(channel))!=0U)
+      {
+        softPwmDisable(auxPwm, channel);
+      }
+    }
+    if (auxPwm.edgeCount==0U) { DISABLE_SOFT_PWM_TIMER(); }
+  }
+}
+
+void auxPwmInterrupt(void)
+{
+  uint16_t nowTicks = (uint16_t)SOFT_PWM_TIMER_COUNTER;
+  uint16_t nextCompare;
+  if (softPwmService(auxPwm, nowTicks, nextCompare))
+  {
+    setAuxPwmCompare(nowTicks, nextCompare);
+  }
+  else
+  {
+    DISABLE_SOFT_PWM_TIMER();
+  }
+}
+
+#endif
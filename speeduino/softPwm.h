@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Multi-channel software PWM, serviced from a single timer compare channel.
+ *
+ * Each channel has its own period & duty (both in timer ticks). The engine keeps the next
+ * edge of every enabled channel in a list sorted by due time, so the compare ISR only ever
+ * looks at the head of the list: it services the edges that are due, re-inserts those
+ * channels and programs the compare register for the new head. The work per interrupt is
+ * bounded by the number of channels, no matter how many outputs are enabled or how their
+ * edges line up.
+ *
+ * Duty is sampled at the start of each period, so a duty change never produces a runt pulse.
+ *
+ * @note All edges in the list must be within INT16_MAX ticks of each other, so the period is
+ * limited to INT16_MAX ticks (~0.5s with the AVR 16µS PWM timer resolution).
+ */
+
+#include <stdint.h>
+
+/** @brief Maximum number of channels in an engine */
+#define SOFT_PWM_MAX_CHANNELS 5U
+
+/** @brief Edges due within this many ticks are serviced immediately, instead of risking a compare value that has already passed */
+#define SOFT_PWM_MIN_LEAD_TICKS 2U
+
+/** @brief Output callbacks for a channel */
+struct softPwmOutput_t {
+  void (*pActive)(void);      ///< Drive the output to its active (on) level
+  void (*pInactive)(void);    ///< Drive the output to its inactive (off) level
+  uint16_t (*pGetDuty)(void); ///< The current duty in timer ticks. Sampled at the start of each period
+};
+
+/** @brief Per channel state */
+struct softPwmChannel_t {
+  softPwmOutput_t output;
+  uint16_t periodTicks;
+  uint16_t dutyTicks;   ///< The duty latched at the start of the current period
+  uint16_t nextEdge;    ///< Timer tick of the next edge
+  bool isPeriodStart;   ///< true if the next edge starts a period, false if it ends the active pulse
+  bool isEnabled;
+};
+
+/** @brief A software PWM engine */
+struct softPwmEngine_t {
+  softPwmChannel_t channels[SOFT_PWM_MAX_CHANNELS];
+  uint8_t edgeOrder[SOFT_PWM_MAX_CHANNELS]; ///< Indices of the enabled channels, sorted by next edge
+  uint8_t edgeCount;                        ///< Number of enabled channels
+};
+
+/** @brief Reset the engine: all channels are disabled & unconfigured */
+void softPwmInit(softPwmEngine_t &engine);
+
+/**
+ * @brief Set the output callbacks and period of a channel
+ *
+ * The channel enabled state is unchanged. If the channel is running, the new period takes
+ * effect at the next edge.
+ */
+void softPwmConfigure(softPwmEngine_t &engine, uint8_t channel, const softPwmOutput_t &output, uint16_t periodTicks);
+
+/**
+ * @brief Start a channel. The first period starts at nowTicks.
+ *
+ * @return true if the channel was not already enabled
+ */
+bool softPwmEnable(softPwmEngine_t &engine, uint8_t channel, uint16_t nowTicks);
+
+/** @brief Stop a channel. The output is left in its current state. */
+void softPwmDisable(softPwmEngine_t &engine, uint8_t channel);
+
+/**
+ * @brief Service all edges that are due. Call this from the compare ISR.
+ *
+ * At most 2 edges per channel are serviced in one call, which bounds the ISR time.
+ *
+ * @param nowTicks The current timer counter
+ * @param nextCompare Set to the timer tick of the next edge
+ * @return false if no channels are enabled (nextCompare is unchanged)
+ */
+bool softPwmService(softPwmEngine_t &engine, uint16_t nowTicks, uint16_t &nextCompare);
+
+/**
+ * @brief The hardware PWM duty value that gives the same output as a software PWM channel
+ *
+ * The software PWM drives the output to its active level for dutyTicks at the start of each period.
+ * Hardware PWM outputs are high for the duty value: so for an active low output, that is the inactive
+ * part of the period.
+ *
+ * @param resolutionBits The hardware duty resolution: a duty value of 1<<resolutionBits is always high
+ * @param isActiveLow true if the output is low during the active part of the period
+ */
+uint32_t getAuxPwmHardwareDuty(uint16_t dutyTicks, uint16_t periodTicks, uint8_t resolutionBits, bool isActiveLow);
+
+#if defined(SOFT_PWM_ENGINE) || defined(HW_AUX_PWM)
+/// @{
+/** @brief Channels of the engine that drives the auxiliary PWM outputs
+ *
+ * With HW_AUX_PWM, the board implements the channel API below using hardware PWM instead
+ * of the software engine.
+ */
+enum : uint8_t {
+  AUX_PWM_BOOST,
+  AUX_PWM_VVT1,
+  AUX_PWM_VVT2, ///< Also used by WMI
+  AUX_PWM_IDLE, ///< Drives both idle outputs
+  AUX_PWM_FAN,
+  AUX_PWM_CHANNEL_COUNT,
+};
+#define AUX_PWM_BIT(channel) ((uint8_t)(1U << (channel)))
+/// @}
+
+/** @brief Set the output callbacks and period of an auxiliary PWM channel. Call from the output's initialisation */
+void configureAuxPwm(uint8_t channel, const softPwmOutput_t &output, uint16_t periodTicks);
+/** @brief Start auxiliary PWM channels (E.g. AUX_PWM_BIT(AUX_PWM_BOOST)). Already running channels are unaffected */
+void enableAuxPwm(uint8_t channelMask);
+/** @brief Stop auxiliary PWM channels */
+void disableAuxPwm(uint8_t channelMask);
+#if defined(SOFT_PWM_ENGINE)
+/** @brief The auxiliary PWM compare ISR */
+void auxPwmInterrupt(void);
+#endif
+#if defined(HW_AUX_PWM)
+/**
+ * @brief Drive an auxiliary PWM channel from a hardware PWM output. Call after configureAuxPwm()
+ *
+ * If the pin has no hardware PWM (or is NOT_A_PIN), the channel is driven by the board's timer
+ * interrupt instead, using the output's interrupt routine (E.g. boostInterrupt()).
+ *
+ * @param isActiveLow true if the output is low during the active part of the period
+ * @return true if the channel is driven by hardware PWM
+ */
+bool setAuxPwmPin(uint8_t channel, uint8_t pin, bool isActiveLow);
+/** @brief Write any changed channel duty to the hardware. Call regularly from the main loop */
+void refreshAuxPwm(void);
+#endif
+#endif
@@ -62,17 +62,23 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "src/controllers/boost/boostController.h"
 #include "src/controllers/aircon/airconController.h"
 #include "src/controllers/nitrous/nitrousController.h"
+#include "polling.hpp"
+#include "static_for.hpp"
 
 #define CRANK_RUN_HYSTER    15
 
 constexpr table2D_u8_u8_10 idleTargetTable(&configPage6.iacBins, &configPage6.iacCLValues);
 
-#ifndef UNIT_TEST // Scope guard for unit testing
+// Scope guard for unit testing. In virtual time, the native board runs the real setup() & loop()
+// against a simulated engine (see test/test_engine_sim)
+#if !defined(UNIT_TEST) || defined(NATIVE_VIRTUAL_TIME)
 
 void setup(void)
 {
   currentStatus.initialisationComplete = false; //Tracks whether the initialiseAll() function has run completely
-  initialiseAll();
+  //Only initialise what's needed to start the engine here, so that the trigger is attached as soon as possible.
+  //The rest of the initialisation is run from the main loop.
+  initialiseCritical();
 }
 
 /** Lookup the current VE value from the primary 3D fuel map.
@@ -123,6 +129,37 @@ static void onPowerSourceSwitch(uint8_t originalBatteryVoltage, const statuses &
   }
 }
 
+static void idleControlTask(void)
+{
+  // Stepper idle is run every loop (see below)
+  if (!isStepperIac(configPage6)) { idleControl(); }
+}
+
+/** @brief Closed loop controllers, run at a fixed rate so that each PID has a deterministic sample period.
+ * 
+ * Deadlines that are missed completely are accumulated in @ref statuses::taskDeadlineMisses
+ */
+static void runFixedRateTasks(uint16_t nowMs)
+{
+  static fixedRateTask_t fixedRateTasks[] = {
+    //Most boost tends to run at about 30Hz, so this ensures a new target time is fetched frequently enough
+    { boostControl, BOOST_CONTROL_INTERVAL_MS, 0U, false },
+    //VVT may eventually need to be synced with the cam readings (ie run once per cam rev) but for now run at 30Hz
+    { vvtControl, VVT_CONTROL_INTERVAL_MS, 0U, false },
+    //Water methanol injection
+    { wmiControl, 33U, 0U, false },
+    //10Hz to align with the idle taper resolution of 0.1s
+    { idleControlTask, IDLE_CONTROL_INTERVAL_MS, 0U, false },
+  };
+
+  static_for<0, _countof(fixedRateTasks)>::repeat_n(executeFixedRateArrayTask, fixedRateTasks, nowMs, &currentStatus.taskDeadlineMisses);
+
+#if defined(HW_AUX_PWM)
+  //Hardware PWM outputs are only written when a controller has changed their duty
+  refreshAuxPwm();
+#endif
+}
+
 /** Speeduino main loop.
  * 
  * Main loop chores (roughly in the order that they are performed):
@@ -150,6 +187,9 @@ BEGIN_LTO_ALWAYS_INLINE(void) loop(void)
 {
   uint8_t originalBatteryVoltage = currentStatus.battery10;
 
+      //Run the non-critical initialisation, one stage per loop
+      if (!currentStatus.initialisationComplete) { (void)initialiseDeferredStage(); }
+
       if(mainLoopCount < UINT16_MAX) { mainLoopCount++; }
       currentStatus.LOOP_TIMER = getAndClearTimerMask();
 
@@ -240,13 +280,6 @@ BEGIN_LTO_ALWAYS_INLINE(void) loop(void)
     }
     if(BIT_CHECK(currentStatus.LOOP_TIMER, BIT_TIMER_30HZ)) //30 hertz
     {
-      //Most boost tends to run at about 30Hz, so placing it here ensures a new target time is fetched frequently enough
-      boostControl();
-      //VVT may eventually need to be synced with the cam readings (ie run once per cam rev) but for now run at 30Hz
-      vvtControl();
-      //Water methanol injection
-      wmiControl();
-      
       #if defined(NATIVE_CAN_AVAILABLE)
       sendCANBroadcast(30);
       #endif
@@ -277,7 +310,7 @@ BEGIN_LTO_ALWAYS_INLINE(void) loop(void)
       //And check whether the tooth log buffer is ready
       if(toothHistoryIndex > _countof(toothHistory)) { currentStatus.isToothLog1Full = true; }
     }
-    if(BIT_CHECK(currentStatus.LOOP_TIMER, BIT_TIMER_10HZ)) //10 hertz
+    if(BIT_CHECK(currentStatus.LOOP_TIMER, BIT_TIMER_10HZ) && currentStatus.initialisationComplete) //10 hertz
     {
       checkProgrammableIO(currentStatus, configPage13);
       
@@ -294,7 +327,7 @@ BEGIN_LTO_ALWAYS_INLINE(void) loop(void)
     }
     if (BIT_CHECK(currentStatus.LOOP_TIMER, BIT_TIMER_4HZ))
     {
-      nitrousControl();
+      if (currentStatus.initialisationComplete) { nitrousControl(); }
 
       //Lookup the current target idle RPM. This is aligned with coolant and so needs to be calculated at the same rate CLT is read
       if( (configPage2.idleAdvEnabled != IDLEADVANCE_MODE_OFF) || (configPage6.iacAlgorithm != IAC_ALGORITHM_NONE) )
@@ -394,10 +427,11 @@ BEGIN_LTO_ALWAYS_INLINE(void) loop(void)
 
     } //1Hz timer
 
-    // Run idlecontrol every loop for stepper idle...
-    if (isStepperIac(configPage6)
-    // ...or to be run at 10Hz to align with the idle taper resolution of 0.1s
-    || BIT_CHECK(currentStatus.LOOP_TIMER, BIT_TIMER_10HZ))
+    //The auxiliary controllers aren't initialised until the deferred initialisation is complete
+    if (currentStatus.initialisationComplete) { runFixedRateTasks((uint16_t)millis()); }
+
+    // Run idlecontrol every loop for stepper idle
+    if (isStepperIac(configPage6) && currentStatus.initialisationComplete)
     {
       idleControl(); 
     }
@@ -467,6 +501,7 @@ BEGIN_LTO_ALWAYS_INLINE(void) loop(void)
 
       //Set dwell
       currentStatus.dwell = correctionsDwell(computeDwell(currentStatus, configPage2, configPage4, dwellTable));
+      applyOverDwellProtection(configPage4, currentStatus);
 
       // Convert the dwell time to dwell angle based on the current engine speed
       calculateIgnitionAngles(configPage2, configPage4, configPage13, currentStatus);
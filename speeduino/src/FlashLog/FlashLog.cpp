@@ -0,0 +1,314 @@
+#include "FlashLog.h"
+#include <string.h>
+#include <FastCRC.h>
+
+static constexpr uint32_t REGION_MAGIC = 0x534C4F47UL; // "SLOG"
+static constexpr uint8_t RECORD_FLAG_COMMIT = 0x01U;   // Last record of a transaction
+static constexpr uint8_t ERASED_BYTE = 0xFFU;
+
+struct __attribute__((__packed__)) region_header_t {
+  uint32_t magic;
+  uint32_t generation;
+  uint32_t crc;         ///< Of the preceding fields
+};
+
+struct __attribute__((__packed__)) flash_log_t::record_header_t {
+  uint16_t address;     ///< Image address of the first data byte
+  uint8_t length;       ///< Number of data bytes following the header
+  uint8_t flags;
+  uint32_t sequence;    ///< Transaction sequence number, shared by all records in the transaction
+  uint32_t crc;         ///< Of the preceding fields & the data
+};
+
+static constexpr uint8_t RECORD_HEADER_CRC_SIZE = sizeof(uint16_t)+sizeof(uint8_t)+sizeof(uint8_t)+sizeof(uint32_t);
+static constexpr uint8_t REGION_HEADER_CRC_SIZE = sizeof(uint32_t)+sizeof(uint32_t);
+
+static inline bool isErased(const uint8_t *pFirst, const uint8_t *pLast)
+{
+  while ( (pFirst!=pLast) && (*pFirst==ERASED_BYTE) ) { ++pFirst; }
+  return pFirst==pLast;
+}
+
+flash_log_t::flash_log_t(const flash_log_device_t &device, uint8_t *pImage, uint8_t *pDirty, uint16_t imageSize)
+: _device(device)
+, _pImage(pImage)
+, _pDirty(pDirty)
+, _imageSize(imageSize)
+{
+}
+
+uint32_t flash_log_t::regionSize(void) const
+{
+  return _device.sectorSize * _device.sectorsPerRegion;
+}
+
+uint32_t flash_log_t::regionAddress(uint8_t region) const
+{
+  return _device.baseAddress + (regionSize() * region);
+}
+
+void flash_log_t::clearDirty(void)
+{
+  memset(_pDirty, 0, (_imageSize+7U)/8U);
+}
+
+bool flash_log_t::isDirty(void) const
+{
+  const uint8_t *pDirty = _pDirty;
+  const uint8_t *pEnd = _pDirty + ((_imageSize+7U)/8U);
+  while ( (pDirty!=pEnd) && (*pDirty==0U) ) { ++pDirty; }
+  return pDirty!=pEnd;
+}
+
+static inline bool isDirtyBit(const uint8_t *pDirty, uint16_t address)
+{
+  return (pDirty[address/8U] & (1U << (address%8U)))!=0U;
+}
+
+static inline uint8_t snapshotChunkLength(uint16_t imageSize, uint16_t address)
+{
+  uint16_t remaining = imageSize - address;
+  return (uint8_t)(remaining<FLASH_LOG_MAX_RECORD_DATA ? remaining : FLASH_LOG_MAX_RECORD_DATA);
+}
+
+// Find the next run of dirty bytes, at or after address. Runs are limited to one record
+static bool nextDirtyRun(const uint8_t *pDirty, uint16_t imageSize, uint16_t &address, uint8_t &length)
+{
+  while ( (address<imageSize) && !isDirtyBit(pDirty, address) ) { ++address; }
+  length = 0U;
+  while ( (address+length<imageSize) && (length<FLASH_LOG_MAX_RECORD_DATA) && isDirtyBit(pDirty, address+length) ) { ++length; }
+  return length!=0U;
+}
+
+bool flash_log_t::begin(void)
+{
+  _isMounted = true;
+  memset(_pImage, ERASED_BYTE, _imageSize);
+  clearDirty();
+
+  // The regions must be large enough to hold a full snapshot of the image
+  uint32_t chunkCount = (_imageSize + FLASH_LOG_MAX_RECORD_DATA - 1U) / FLASH_LOG_MAX_RECORD_DATA;
+  uint32_t snapshotSize = sizeof(region_header_t) + (chunkCount * (sizeof(record_header_t) + FLASH_LOG_MAX_RECORD_DATA));
+  _isUsable = (_device.regionCount>=2U) && (snapshotSize<=regionSize());
+  if (!_isUsable)
+  {
+    return false;
+  }
+
+  // Find the most recent valid region
+  bool isFound = false;
+  FastCRC32 crcCalc;
+  for (uint8_t region=0U; region<_device.regionCount; ++region)
+  {
+    region_header_t header;
+    if ( _device.read(regionAddress(region), (uint8_t*)&header, sizeof(header))
+      && (header.magic==REGION_MAGIC)
+      && (header.crc==crcCalc.crc32((const uint8_t*)&header, REGION_HEADER_CRC_SIZE))
+      && (!isFound || (header.generation>_generation)) )
+    {
+      isFound = true;
+      _activeRegion = region;
+      _generation = header.generation;
+    }
+  }
+
+  if (!isFound)
+  {
+    // Blank (or unrecognisable) flash: format by writing the empty image to the first region
+    _generation = 0U;
+    _activeRegion = _device.regionCount-1U;
+    return compact();
+  }
+  return replay();
+}
+
+bool flash_log_t::replay(void)
+{
+  const uint32_t regionStart = regionAddress(_activeRegion);
+  const uint32_t regionEnd = regionSize();
+  uint32_t offset = sizeof(region_header_t);
+  uint32_t transactionStart = offset;
+  bool isInTransaction = false;
+  bool isCorrupt = false;
+  FastCRC32 crcCalc;
+
+  while ( (offset + sizeof(record_header_t)) <= regionEnd )
+  {
+    record_header_t header;
+    if (!_device.read(regionStart + offset, (uint8_t*)&header, sizeof(header)))
+    {
+      isCorrupt = true;
+      break;
+    }
+    if (isErased((const uint8_t*)&header, (const uint8_t*)&header + sizeof(header)))
+    {
+      break; // End of the log
+    }
+
+    uint32_t next = offset + sizeof(header) + header.length;
+    uint8_t data[FLASH_LOG_MAX_RECORD_DATA];
+    if ( (header.length==0U) || (header.length>FLASH_LOG_MAX_RECORD_DATA) || (next>regionEnd)
+      || (((uint32_t)header.address + header.length)>_imageSize)
+      || !_device.read(regionStart + offset + sizeof(header), data, header.length) )
+    {
+      isCorrupt = true;
+      break;
+    }
+    (void)crcCalc.crc32((const uint8_t*)&header, RECORD_HEADER_CRC_SIZE);
+    if (header.crc!=crcCalc.crc32_upd(data, header.length))
+    {
+      isCorrupt = true;
+      break;
+    }
+
+    if (!isInTransaction || (header.sequence!=_sequence-1U))
+    {
+      // A new transaction (any earlier incomplete transaction is abandoned)
+      transactionStart = offset;
+      isInTransaction = true;
+    }
+    _sequence = header.sequence+1U;
+    if ((header.flags & RECORD_FLAG_COMMIT)!=0U)
+    {
+      applyTransaction(regionStart + transactionStart, regionStart + next);
+      isInTransaction = false;
+    }
+    offset = next;
+  }
+
+  _writeOffset = offset;
+  // Never append after a corrupt record: the flash beyond it may be partially programmed
+  return isCorrupt ? compact() : true;
+}
+
+void flash_log_t::applyTransaction(uint32_t first, uint32_t last)
+{
+  // The records have already been validated
+  while (first<last)
+  {
+    record_header_t header;
+    (void)_device.read(first, (uint8_t*)&header, sizeof(header));
+    (void)_device.read(first + sizeof(header), _pImage + header.address, header.length);
+    first = first + sizeof(header) + header.length;
+  }
+}
+
+bool flash_log_t::writeRecord(uint16_t address, uint8_t length, bool isCommit)
+{
+  uint8_t buffer[sizeof(record_header_t)+FLASH_LOG_MAX_RECORD_DATA];
+  record_header_t header = { address, length, isCommit ? RECORD_FLAG_COMMIT : (uint8_t)0U, _sequence, 0U };
+  FastCRC32 crcCalc;
+  (void)crcCalc.crc32((const uint8_t*)&header, RECORD_HEADER_CRC_SIZE);
+  header.crc = crcCalc.crc32_upd(_pImage + address, length);
+  memcpy(buffer, &header, sizeof(header));
+  memcpy(buffer + sizeof(header), _pImage + address, length);
+
+  bool isOk = _device.program(regionAddress(_activeRegion) + _writeOffset, buffer, (uint16_t)(sizeof(header) + length));
+  _writeOffset = _writeOffset + sizeof(header) + length;
+  return isOk;
+}
+
+bool flash_log_t::compact(void)
+{
+  const uint8_t target = (uint8_t)((_activeRegion + 1U) % _device.regionCount);
+  const uint32_t targetAddress = regionAddress(target);
+  bool isOk = true;
+  for (uint8_t sector=0U; isOk && (sector<_device.sectorsPerRegion); ++sector)
+  {
+    isOk = _device.eraseSector(targetAddress + (_device.sectorSize * sector));
+  }
+
+  // Snapshot the image as a single transaction. Blank chunks are skipped: replay starts from a blank image.
+  _activeRegion = target;
+  _writeOffset = sizeof(region_header_t);
+  uint16_t lastChunk = _imageSize;
+  for (uint16_t address=0U; address<_imageSize; address = address + FLASH_LOG_MAX_RECORD_DATA)
+  {
+    uint8_t length = snapshotChunkLength(_imageSize, address);
+    if (!isErased(_pImage + address, _pImage + address + length)) { lastChunk = address; }
+  }
+  for (uint16_t address=0U; isOk && (lastChunk!=_imageSize) && (address<=lastChunk); address = address + FLASH_LOG_MAX_RECORD_DATA)
+  {
+    uint8_t length = snapshotChunkLength(_imageSize, address);
+    if (!isErased(_pImage + address, _pImage + address + length))
+    {
+      isOk = writeRecord(address, length, address==lastChunk);
+    }
+  }
+  ++_sequence;
+
+  // The header is written last: until then, the previous region is still the valid one
+  if (isOk)
+  {
+    region_header_t header = { REGION_MAGIC, _generation+1U, 0U };
+    FastCRC32 crcCalc;
+    header.crc = crcCalc.crc32((const uint8_t*)&header, REGION_HEADER_CRC_SIZE);
+    isOk = _device.program(targetAddress, (const uint8_t*)&header, sizeof(header));
+    ++_generation;
+  }
+
+  clearDirty();
+  // Stop writing to flash that is failing. The RAM image remains usable.
+  _isUsable = isOk;
+  return isOk;
+}
+
+uint8_t flash_log_t::read(uint16_t address)
+{
+  if (!_isMounted) { (void)begin(); }
+  return address<_imageSize ? _pImage[address] : ERASED_BYTE;
+}
+
+int8_t flash_log_t::write(uint16_t address, uint8_t value)
+{
+  if (!_isMounted) { (void)begin(); }
+  if (address>=_imageSize) { return -1; }
+  if (_pImage[address]!=value)
+  {
+    _pImage[address] = value;
+    _pDirty[address/8U] = (uint8_t)(_pDirty[address/8U] | (1U << (address%8U)));
+  }
+  return 0;
+}
+
+bool flash_log_t::commit(void)
+{
+  if (!_isMounted) { (void)begin(); }
+  if (!isDirty()) { return true; }
+  if (!_isUsable) { return false; }
+
+  // Size the transaction: if it doesn't fit in the active region, compact instead.
+  // The snapshot includes the dirty bytes, so it is the commit.
+  uint32_t transactionSize = 0U;
+  uint16_t address = 0U;
+  uint8_t length = 0U;
+  while (nextDirtyRun(_pDirty, _imageSize, address, length))
+  {
+    transactionSize = transactionSize + sizeof(record_header_t) + length;
+    address = address + length;
+  }
+  if ((_writeOffset + transactionSize) > regionSize())
+  {
+    return compact();
+  }
+
+  // Write the records, flagging the last one as the end of the transaction
+  address = 0U;
+  bool hasRun = nextDirtyRun(_pDirty, _imageSize, address, length);
+  bool isOk = true;
+  while (isOk && hasRun)
+  {
+    uint16_t nextAddress = address + length;
+    uint8_t nextLength = 0U;
+    bool hasNext = nextDirtyRun(_pDirty, _imageSize, nextAddress, nextLength);
+    isOk = writeRecord(address, length, !hasNext);
+    address = nextAddress;
+    length = nextLength;
+    hasRun = hasNext;
+  }
+  ++_sequence;
+
+  clearDirty();
+  _isUsable = isOk;
+  return isOk;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Log structured, wear levelled EEPROM emulation for flash memory.
+ *
+ * The whole emulated EEPROM is held in RAM. Writes only update the RAM image and mark
+ * the bytes as dirty: nothing is written to flash until commit() is called. The commit
+ * appends the dirty bytes to a log in flash as a *transaction*: one or more records, the
+ * last of which is flagged as the end of the transaction.
+ *
+ * Flash layout:
+ *  - The flash is divided into regionCount regions, each sectorsPerRegion sectors long.
+ *  - Only one region is active. It starts with a header (magic number, generation & CRC).
+ *  - The rest of the region is the log: a sequence of records, each with a header (address,
+ *    length, flags, transaction sequence number & CRC) followed by the data.
+ *
+ * When the active region is full, the RAM image is written to the next region as a single
+ * transaction & that region becomes active (compaction). The regions are used round robin,
+ * so erases are spread evenly across all of them.
+ *
+ * On mount, the region with the highest generation is replayed into RAM. Only complete
+ * transactions are applied, so a page commit interrupted by power loss is discarded in
+ * full. A corrupt record (E.g. a torn write) ends the log and triggers a compaction, so
+ * that new records are never written over partially programmed flash.
+ *
+ * @note Requires flash that erases to 0xFF & can program any erased byte individually
+ * (E.g. SPI NOR flash).
+ */
+
+#include <stdint.h>
+
+/** @brief Raw flash access functions & layout */
+struct flash_log_device_t {
+  /** @brief Read bytes. Address is relative to baseAddress */
+  bool (*read)(uint32_t address, uint8_t *pBuffer, uint16_t length);
+  /** @brief Program previously erased bytes. The data may span flash page boundaries */
+  bool (*program)(uint32_t address, const uint8_t *pBuffer, uint16_t length);
+  /** @brief Erase the sector containing the address */
+  bool (*eraseSector)(uint32_t address);
+  uint32_t baseAddress;     ///< Flash address of the first region
+  uint32_t sectorSize;      ///< The smallest erasable unit
+  uint8_t sectorsPerRegion;
+  uint8_t regionCount;      ///< Must be at least 2
+};
+
+/** @brief Maximum data bytes in one log record */
+#define FLASH_LOG_MAX_RECORD_DATA 64U
+
+/** @brief The log structured store. Use FlashLogAsEEPROM to allocate the RAM image */
+class flash_log_t
+{
+public:
+  flash_log_t(const flash_log_device_t &device, uint8_t *pImage, uint8_t *pDirty, uint16_t imageSize);
+
+  /**
+   * @brief Mount the log: find the active region & replay it into RAM. Formats the flash if no valid region is found.
+   *
+   * Called automatically on first access.
+   *
+   * @return false if the flash is unusable (E.g. regions too small for the image). The RAM image
+   * is still usable, but nothing will be saved.
+   */
+  bool begin(void);
+
+  uint8_t read(uint16_t address);
+  int8_t write(uint16_t address, uint8_t value);
+  int8_t update(uint16_t address, uint8_t value) { return write(address, value); }
+  uint16_t length(void) const { return _imageSize; }
+
+  /**
+   * @brief Save all writes since the last commit to flash, as a single transaction.
+   *
+   * @return false if the flash could not be written
+   */
+  bool commit(void);
+
+  /** @brief Is there uncommitted data? */
+  bool isDirty(void) const;
+
+  /** @brief Index of the active region */
+  uint8_t activeRegion(void) const { return _activeRegion; }
+  /** @brief Number of compactions over the life of the flash (the active region generation) */
+  uint32_t generation(void) const { return _generation; }
+
+private:
+  struct record_header_t;
+  bool mount(void);
+  bool replay(void);
+  void applyTransaction(uint32_t first, uint32_t last);
+  bool compact(void);
+  bool writeRecord(uint16_t address, uint8_t length, bool isCommit);
+  uint32_t regionSize(void) const;
+  uint32_t regionAddress(uint8_t region) const;
+  bool isChunkDirty(uint16_t address, uint8_t length) const;
+  void clearDirty(void);
+
+  flash_log_device_t _device;
+  uint8_t *_pImage;
+  uint8_t *_pDirty;
+  uint16_t _imageSize;
+  uint8_t _activeRegion = 0U;
+  bool _isMounted = false;
+  bool _isUsable = false;
+  uint32_t _generation = 0U;
+  uint32_t _writeOffset = 0U;   ///< Offset of the first free byte in the active region
+  uint32_t _sequence = 0U;      ///< Transaction sequence number of the next commit
+};
+
+/** @brief EEPROM emulation using a flash log, with a RAM image of imageSize bytes */
+template <uint16_t imageSize>
+class FlashLogAsEEPROM : public flash_log_t
+{
+public:
+  explicit FlashLogAsEEPROM(const flash_log_device_t &device)
+  : flash_log_t(device, _image, _dirty, imageSize)
+  {
+  }
+
+private:
+  uint8_t _image[imageSize];
+  uint8_t _dirty[(imageSize+7U)/8U];
+};
@@ -13,12 +13,19 @@ bool integerPID::compute(uint32_t now, int32_t input, int32_t* pOutput)
    uint32_t timeChange = (now - _lastTime);
    if ((!_isActive) || (timeChange < _sampleTime)) return false;
 
+   _lastTime = now;
+   return compute(input, pOutput);
+}
+
+bool integerPID::compute(int32_t input, int32_t* pOutput)
+{
+   if (!_isActive) return false;
+
    // We are using "Derivative on Measurement" as described [here](http://brettbeauregard.com/blog/2011/04/improving-the-beginners-pid-derivative-kick/)
    *pOutput = _pidCore.compute(_feedForwardTerm, _setpoint - input, _lastInput - input) >> PID_SHIFTS;
 
    /*Remember some variables for next time*/
    _lastInput = input;
-   _lastTime = now;
 
    return true;
 }
@@ -46,6 +46,18 @@ public:
    */
   bool compute(uint32_t nowMs, int32_t input, int32_t* pOutput);
 
+  /**
+   * @brief Compute the new output on every call, for controllers run as a fixed rate task.
+   * 
+   * The sample period is then exactly the task period, regardless of any jitter in millis().
+   * The minComputeInterval passed to setTunings() must be the task period.
+   *  
+   * @param input The input value
+   * @param pOutput A correction to be applied to the input; only valid when true is returned.
+   * @return true if a calculation occurred (I.e. the controller is active), false otherwise 
+   */
+  bool compute(int32_t input, int32_t* pOutput);
+
   /** @brief (Optional) Reset the controller */
   void reset(int32_t input);
 
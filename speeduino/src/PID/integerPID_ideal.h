@@ -26,6 +26,9 @@ public:
     _sampleTime = minComputeInterval; 
     _lastTime = now-minComputeInterval;
   }
+
+  /** @brief The minimum time interval between computations, as set by setSampleTime() */
+  uint16_t getSampleTime(void) const { return _sampleTime; }
   
   /** @brief Set the PID parameters */
   void setTunings(const PidTuningParameters& params) { 
@@ -2,7 +2,7 @@
 #include "../../pins/outputPin.h"
 #include "../../../unit_testing.h"
 #include "../../../config_pages.h"
-#include "../../../atomic.h"
+#include "../../../atomic_profile.h"
 #include "../../../globals.h"
 #include "../../../units.h"
 
@@ -120,7 +120,7 @@ static inline void checkAirConRPMLockout(void)
 
 TESTABLE_STATIC void airConOn(void)
 {
-  ATOMIC() { 
+  ATOMIC_PROFILED(ATOMIC_SITE_AUX_OUTPUTS) { 
     if (configPage15.airConCompPol)
     {
       aircon_comp_pin.setPinLow();
@@ -134,7 +134,7 @@ TESTABLE_STATIC void airConOn(void)
 }
 TESTABLE_STATIC void airConOff(void)
 {
-  ATOMIC() { 
+  ATOMIC_PROFILED(ATOMIC_SITE_AUX_OUTPUTS) { 
     if (configPage15.airConCompPol)
     {
       aircon_comp_pin.setPinHigh();
@@ -148,7 +148,7 @@ TESTABLE_STATIC void airConOff(void)
 }
 static void airConFanOn(void)
 {
-  ATOMIC() { 
+  ATOMIC_PROFILED(ATOMIC_SITE_AUX_OUTPUTS) { 
     if (configPage15.airConFanPol)
     {
       aircon_fan_pin.setPinLow();
@@ -162,7 +162,7 @@ static void airConFanOn(void)
 }
 static void airConFanOff(void)
 {
-  ATOMIC() { 
+  ATOMIC_PROFILED(ATOMIC_SITE_AUX_OUTPUTS) { 
     if (configPage15.airConFanPol)
     {
       aircon_fan_pin.setPinHigh();
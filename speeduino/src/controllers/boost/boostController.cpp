@@ -1,3 +1,4 @@
+#include "boostController.h"
 #include "../../pins/boardOutputPin.h"
 #include "../../../globals.h"
 #include "../../../unit_testing.h"
@@ -9,11 +10,20 @@ TESTABLE_STATIC boardOutputPin_t boost_pin;
 TESTABLE_STATIC long boost_pwm_target_value;
 TESTABLE_STATIC volatile bool boost_pwm_state;
 TESTABLE_STATIC volatile unsigned int boost_pwm_cur_value = 0;
-static uint16_t boost_pwm_max_count; //Used for variable PWM frequency
+TESTABLE_STATIC uint16_t boost_pwm_max_count; //Used for variable PWM frequency
 static integerPID_ideal boostPID; //This is the PID object if that algorithm is used. Needs to be global as it maintains state outside of each function call
+/** @brief Number of boostControl() calls. This is the boost PID clock: boostControl() is a fixed rate task,
+ * so counting calls instead of using millis() gives the PID a deterministic sample period */
+TESTABLE_STATIC uint32_t boostControlCalls;
 
 TESTABLE_CONSTEXPR table2D_u8_s16_6 flexBoostTable(&configPage10.flexBoostBins, &configPage10.flexBoostAdj);
 
+/** @brief The boost PID sample time in boostControl() calls: the configured interval, rounded up to a whole number of calls */
+TESTABLE_INLINE_STATIC uint16_t getBoostPidSampleCalls(const config10 &page10)
+{
+  return ((uint16_t)page10.boostIntv + (BOOST_CONTROL_INTERVAL_MS - 1U)) / BOOST_CONTROL_INTERVAL_MS;
+}
+
 static __attribute__((optimize("Os"))) void setBoostPidTunings(const config2 &page2, const config6 &page6, const config10 &page10)
 {
   if(page6.boostMode == BOOST_MODE_SIMPLE)
@@ -25,16 +35,44 @@ static __attribute__((optimize("Os"))) void setBoostPidTunings(const config2 &pa
     boostPID.setTunings(PidTuningParameters(page6.boostKP, page6.boostKI, page6.boostKD));
   }
   boostPID.setOutputLimits(page2.boostMinDuty, page2.boostMaxDuty);
-  boostPID.setSampleTime(millis(), page10.boostIntv);
+  //Only restart the sample period if it has changed, so that re-reading the settings doesn't add a sample
+  uint16_t sampleCalls = getBoostPidSampleCalls(page10);
+  if (sampleCalls != boostPID.getSampleTime()) { boostPID.setSampleTime(boostControlCalls, sampleCalls); }
   boostPID.setSensitivity(page10.boostSens);
 }
 
+/** @brief true if boostInterrupt() drives the boost output low for the duty
+ * 
+ * On Teensy 4.1 the PIT timers count down & have the opposite effect on PWM. Hardware PWM uses the
+ * same polarity, so the output is the same whether or not the pin has hardware PWM.
+ */
+TESTABLE_INLINE_STATIC bool isBoostPwmActiveLow(void)
+{
+#if defined(CORE_TEENSY41)
+  return true;
+#else
+  return false;
+#endif
+}
+
+#if defined(AUX_PWM_CHANNELS)
+static void boostPwmOn(void) { boost_pin.setPinHigh(); }
+static void boostPwmOff(void) { boost_pin.setPinLow(); }
+static uint16_t getBoostPwmDuty(void) { return (uint16_t)boost_pwm_target_value; }
+#endif
+
 __attribute__((optimize("Os"))) void initialiseBoost(uint8_t boostPin)
 {
   boost_pin.setPin(boostPin, OUTPUT);
 
   setBoostPidTunings(configPage2, configPage6, configPage10);
   boost_pwm_max_count = pwmFreqToTicks(FREQUENCY.toUser(configPage6.boostFreq));
+#if defined(AUX_PWM_CHANNELS)
+  configureAuxPwm(AUX_PWM_BOOST, { boostPwmOn, boostPwmOff, getBoostPwmDuty }, boost_pwm_max_count);
+#endif
+#if defined(HW_AUX_PWM)
+  (void)setAuxPwmPin(AUX_PWM_BOOST, boostPin, isBoostPwmActiveLow());
+#endif
   currentStatus.boostDuty = 0;
   boostCounter = 0;
 }
@@ -236,8 +274,8 @@ void boostControl(void)
 
           boostPID.setSetPoint(currentStatus.boostTarget);
           boostPID.setFeedForwardTerm(get3DTableValue(&boostTableLookupDuty, currentStatus.boostTarget, currentStatus.RPM) * 100/2);
-          //Compute() returns false if the required interval has not yet passed.
-          bool PIDcomputed = boostPID.compute(millis(), 
+          //Compute() returns false if the required number of calls has not yet passed.
+          bool PIDcomputed = boostPID.compute(boostControlCalls, 
                                               currentStatus.MAP,
                                               &currentStatus.boostDuty);
           
@@ -285,30 +323,29 @@ void boostControl(void)
   }
 
   boostCounter++;
+  boostControlCalls++;
 }
 
+#if !defined(SOFT_PWM_ENGINE)
 //The interrupt to control the Boost PWM
 void boostInterrupt(void)
 {
   if (boost_pwm_state == true)
   {
-    #if defined(CORE_TEENSY41) //PIT TIMERS count down and have opposite effect on PWM
-    boost_pin.setPinHigh();
-    #else
-    boost_pin.setPinLow();  // Switch pin to low
-    #endif
+    // End of the duty
+    if (isBoostPwmActiveLow()) { boost_pin.setPinHigh(); }
+    else { boost_pin.setPinLow(); }
     SET_COMPARE(BOOST_TIMER_COMPARE, BOOST_TIMER_COUNTER + (boost_pwm_max_count - boost_pwm_cur_value) );
     boost_pwm_state = false;
   }
   else
   {
-    #if defined(CORE_TEENSY41) //PIT TIMERS count down and have opposite effect on PWM
-    boost_pin.setPinLow();
-    #else
-    boost_pin.setPinHigh();  // Switch pin high
-    #endif
+    // Start of the duty
+    if (isBoostPwmActiveLow()) { boost_pin.setPinLow(); }
+    else { boost_pin.setPinHigh(); }
     SET_COMPARE(BOOST_TIMER_COMPARE, BOOST_TIMER_COUNTER + boost_pwm_target_value);
     boost_pwm_cur_value = boost_pwm_target_value;
     boost_pwm_state = true;
   }
 }
+#endif
@@ -2,6 +2,9 @@
 
 #include <stdint.h>
 
+/** @brief boostControl() must be run at this fixed interval (in milliseconds). The boost PID sample time is a whole number of these. */
+constexpr uint8_t BOOST_CONTROL_INTERVAL_MS = 33U;
+
 void initialiseBoost(uint8_t boostPin);
 void boostControl(void);
 void boostDisable(void);
@@ -2,6 +2,7 @@
 #include "../../../units.h"
 #include "../../../unit_testing.h"
 #include "../../../globals.h"
+#include "../../../atomic_profile.h"
 
 #if defined(PWM_FAN_AVAILABLE)//PWM fan not available on Arduino MEGA
 TESTABLE_STATIC volatile bool fan_pwm_state;
@@ -15,17 +16,21 @@ TESTABLE_STATIC boardOutputPin_t fan_pin;
 
 void fanOn(void) 
 {
-  ATOMIC() { 
+  ATOMIC_PROFILED(ATOMIC_SITE_AUX_OUTPUTS) { 
     ((configPage6.fanInv) ? fan_pin.setPinLow() : fan_pin.setPinHigh()); 
   }
 }
 void fanOff(void)
 {
-  ATOMIC() { 
+  ATOMIC_PROFILED(ATOMIC_SITE_AUX_OUTPUTS) { 
     ((configPage6.fanInv) ? fan_pin.setPinHigh() : fan_pin.setPinLow()); 
   }
 }
 
+#if defined(AUX_PWM_CHANNELS)
+static uint16_t getFanPwmDuty(void) { return (uint16_t)fan_pwm_value; }
+#endif
+
 void __attribute__((optimize("Os"))) initialiseFan(uint8_t fanPin)
 {
   fan_pin.setPin(fanPin, OUTPUT);
@@ -39,6 +44,9 @@ void __attribute__((optimize("Os"))) initialiseFan(uint8_t fanPin)
   {
     fan_pwm_max_count = pwmFreqToTicks(FREQUENCY.toUser(configPage6.fanFreq));
     fan_pwm_value = 0;
+#if defined(AUX_PWM_CHANNELS)
+    configureAuxPwm(AUX_PWM_FAN, { fanOn, fanOff, getFanPwmDuty }, fan_pwm_max_count);
+#endif
   }
 #endif
 }
@@ -159,7 +167,7 @@ void fanControl(void)
 //The interrupt to control the FAN PWM. Mega2560 doesn't have enough timers, so this is only for the ARM chip ones
 void fanInterrupt(void)
 {
-#if defined(PWM_FAN_AVAILABLE)
+#if defined(PWM_FAN_AVAILABLE) && !defined(SOFT_PWM_ENGINE)
   if (fan_pwm_state == true)
   {
     fanOff();
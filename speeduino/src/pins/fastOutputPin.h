@@ -32,5 +32,6 @@ public:
 #if !defined(UNIT_TEST)
 private:
 #endif
+  template <uint8_t maxPins> friend class port_pin_group_t;
   port_pin_t _pin;
 };
\ No newline at end of file
@@ -17,6 +17,8 @@ namespace type_detection_detail {
 }
 /// @endcond
 
+template <uint8_t maxPins> class port_pin_group_t;
+
 /// @brief A structure to support direct port manipulation
 /// @see https://docs.arduino.cc/retired/hacking/software/PortManipulation/ 
 struct port_pin_t
@@ -56,6 +58,7 @@ struct port_pin_t
   void setPinLow(void) noexcept;
 
 private:
+  template <uint8_t maxPins> friend class port_pin_group_t;
 
   /** @brief The return type of a "call" to portOutputRegister() */
   using port_register_t = decltype(type_detection_detail::return_type_of(&type_detection_detail::detectPortRegisterType));
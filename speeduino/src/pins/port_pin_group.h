@@ -0,0 +1,93 @@
+#pragma once
+#include "port_pin.h"
+#include "fastOutputPin.h"
+#include "../../atomic.h"
+
+/**
+ * @brief A group of output pins that are always switched together.
+ *
+ * Pins are stored as (port, mask) pairs, with all pins on the same port merged into a single
+ * mask. Setting the group is then one read-modify-write per *port*, rather than per pin. E.g.
+ * a pair of injectors on the same port switch in the same instruction.
+ *
+ * @tparam maxPins The maximum number of pins in the group
+ */
+template <uint8_t maxPins>
+class port_pin_group_t
+{
+public:
+  /** @brief Remove all pins */
+  void clear(void) noexcept {
+    _portCount = 0U;
+#if defined(UNIT_TEST)
+    _pinCount = 0U;
+#endif
+  }
+
+  /** @brief Add a pin to the group. Unassigned pins are ignored */
+  void add(port_pin_t &pin) noexcept {
+    if (pin.isValid())
+    {
+      uint8_t index = 0U;
+      while ( (index<_portCount) && (_ports[index].port!=pin._port) ) { ++index; }
+      if (index==_portCount)
+      {
+        _ports[index] = { pin._port, pin._mask };
+        ++_portCount;
+      }
+      else
+      {
+        _ports[index].mask |= pin._mask;
+      }
+#if defined(UNIT_TEST)
+      _pins[_pinCount] = &pin;
+      ++_pinCount;
+#endif
+    }
+  }
+  void add(fastOutputPin_t &pin) noexcept {
+    add(pin._pin);
+  }
+
+  /** @brief The number of distinct ports in the group (I.e. the number of writes required to set the group) */
+  uint8_t portCount(void) const noexcept {
+    return _portCount;
+  }
+
+  // LCOV_EXCL_START
+  /** @brief Set all pins in the group high */
+  void setPinsHigh(void) noexcept {
+    ATOMIC() {
+      for (uint8_t index=0U; index<_portCount; ++index) { *_ports[index].port |= _ports[index].mask; }
+    }
+    setPinStates(HIGH);
+  }
+
+  /** @brief Set all pins in the group low */
+  void setPinsLow(void) noexcept {
+    ATOMIC() {
+      for (uint8_t index=0U; index<_portCount; ++index) { *_ports[index].port &= ~_ports[index].mask; }
+    }
+    setPinStates(LOW);
+  }
+  // LCOV_EXCL_STOP
+
+private:
+  struct port_mask_t {
+    port_pin_t::port_register_t port;
+    port_pin_t::pin_mask_t mask;
+  };
+  port_mask_t _ports[maxPins];
+  uint8_t _portCount = 0U;
+
+#if defined(UNIT_TEST)
+  // Keep the individual pin states in step, so they can be checked by tests
+  port_pin_t *_pins[maxPins];
+  uint8_t _pinCount = 0U;
+  void setPinStates(bool state) noexcept {
+    for (uint8_t index=0U; index<_pinCount; ++index) { _pins[index]->_pinState = state; }
+  }
+#else
+  void setPinStates(bool) noexcept { }
+#endif
+};
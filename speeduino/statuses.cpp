@@ -1,5 +1,5 @@
 #include "statuses.h"
-#include "atomic.h"
+#include "atomic_profile.h"
 #include "decoder_builder.h"
 
 statuses::statuses(void)
@@ -10,7 +10,7 @@ statuses::statuses(void)
 
 void statuses::setRpm(uint16_t rpm)
 {
-  ATOMIC()
+  ATOMIC_PROFILED(ATOMIC_SITE_STATUS)
   {
     this->RPM = rpm;
     this->RPMdiv100 = div100(rpm);
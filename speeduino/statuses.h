@@ -309,6 +309,7 @@ struct statuses {
   bool airconFanOn : 1;  ///< Indicates whether the A/C fan is running
   
   uint8_t systemTemp;
+  uint8_t taskDeadlineMisses; ///< Number of fixed rate task deadlines that were missed completely (saturates at 255). @see fixedRateTask_t
   uint32_t revolutionTime; //The time in uS that one revolution would take at current speed (The time tooth 1 was last seen, minus the time it was seen prior to that)
 
   uint8_t maxIgnOutputs; /**< Number of ignition outputs being used by the current tune configuration */
@@ -15,6 +15,7 @@ A full copy of the license may be found in the projects root directory
 #include "unit_testing.h"
 #include "scheduler.h"
 #include "storage_details.h"
+#include "page_crc.h"
 
 using namespace storage::details;
 
@@ -247,6 +248,86 @@ void saveAllPages(void)
   }
 }
 
+//  ================================= A/B page slots ===============================
+// AVR EEPROM is too small to hold 2 copies of the tune
+#if !defined(CORE_AVR)
+#define STORAGE_PAGE_SLOTS
+#endif
+
+#if defined(STORAGE_PAGE_SLOTS)
+// If the storage is large enough, each page has 2 slots: A is the standard location and B is
+// the standard location + SLOT_B_OFFSET. A burn writes to the inactive slot. Once the page is
+// completely written, the slot CRC and then sequence number (the commit marker) are updated,
+// making it the active slot. So a burn interrupted by power loss leaves the active slot intact.
+//
+// Each slot has metadata: a CRC32 of the page (see calculatePageCRC32()) and a sequence number.
+// On load, the slot with the newest sequence number that passes the CRC check is used.
+constexpr uint16_t SLOT_B_OFFSET = STORAGE_END+1U;
+constexpr uint16_t EEPROM_PAGES_END = EEPROM_CONFIG15_START+sizeof(configPage15);
+constexpr uint16_t SLOT_METADATA_SIZE = sizeof(uint32_t)+sizeof(uint8_t);
+constexpr uint16_t EEPROM_SLOT_METADATA = SLOT_B_OFFSET+EEPROM_PAGES_END;
+constexpr uint16_t EEPROM_SLOTS_END = EEPROM_SLOT_METADATA+(MAX_PAGE_NUM*2U*SLOT_METADATA_SIZE);
+// Must fit into the smallest storage with room for 2 slots: STM32F407 internal flash EEPROM emulation
+static_assert(EEPROM_SLOTS_END<=8188U, "Page slots do not fit in 8K storage");
+
+// Bit per page, set if slot B is active
+static uint16_t activeSlots = 0U;
+
+// Set between beginStandardPageLocations() & endStandardPageLocations()
+static bool isSlotsSuspended = false;
+
+static inline bool isPageSlotsEnabled(void)
+{
+  return !isSlotsSuspended && getStorageAPI().length()>=EEPROM_SLOTS_END;
+}
+
+static inline uint16_t getSlotOffset(uint8_t slot)
+{
+  return slot==0U ? 0U : SLOT_B_OFFSET;
+}
+
+static inline uint8_t getActiveSlot(uint8_t pageNum)
+{
+  return (uint8_t)((activeSlots >> pageNum) & 1U);
+}
+
+static inline void setActiveSlot(uint8_t pageNum, uint8_t slot)
+{
+  activeSlots = (uint16_t)((activeSlots & ~(1U << pageNum)) | ((uint16_t)slot << pageNum));
+}
+
+static inline uint16_t getSlotMetadataAddress(uint8_t pageNum, uint8_t slot)
+{
+  return EEPROM_SLOT_METADATA + ((((uint16_t)pageNum*2U)+slot)*SLOT_METADATA_SIZE);
+}
+
+static inline uint32_t loadSlotCrc(uint8_t pageNum, uint8_t slot)
+{
+  uint32_t crc;
+  return loadObject(getStorageAPI(), getSlotMetadataAddress(pageNum, slot), crc);
+}
+
+static inline uint8_t loadSlotSequence(uint8_t pageNum, uint8_t slot)
+{
+  return getStorageAPI().read(getSlotMetadataAddress(pageNum, slot)+sizeof(uint32_t));
+}
+
+// Sequence numbers wrap
+static inline bool isNewerSequence(uint8_t sequence, uint8_t other)
+{
+  return (int8_t)(uint8_t)(sequence-other) > 0;
+}
+
+static void commitSlot(uint8_t pageNum, uint8_t slot, uint32_t crc)
+{
+  uint8_t sequence = (uint8_t)(loadSlotSequence(pageNum, slot ^ 1U) + 1U);
+  uint16_t address = getSlotMetadataAddress(pageNum, slot);
+  updateObject(getStorageAPI(), crc, address);
+  (void)update(getStorageAPI(), address+sizeof(uint32_t), sequence);
+  setActiveSlot(pageNum, slot);
+}
+#endif
+
 //  ================================= Internal write support ===============================
 struct write_location{
   uint16_t address;
@@ -298,6 +379,25 @@ static inline uint16_t writeTable(table3d_t *pTable, TableType key, uint16_t add
 void savePage(uint8_t pageNum)
 {
   uint16_t writesRemaining = getStorageAPI().getMaxWriteBlockSize(currentStatus);
+  uint16_t offset = 0U;
+#if defined(STORAGE_PAGE_SLOTS)
+  const bool isSlotted = isPageSlotsEnabled();
+  uint8_t targetSlot = 0U;
+  uint32_t pageCrc = 0U;
+  if (isSlotted)
+  {
+    // Nothing to do if the active slot already holds the page
+    pageCrc = calculatePageCRC32(pageNum);
+    const uint8_t activeSlot = getActiveSlot(pageNum);
+    if (pageCrc==loadSlotCrc(pageNum, activeSlot))
+    {
+      setEepromWritePending(false);
+      return;
+    }
+    targetSlot = activeSlot ^ 1U;
+    offset = getSlotOffset(targetSlot);
+  }
+#endif
 
   switch(pageNum)
   {
@@ -306,7 +406,7 @@ void savePage(uint8_t pageNum)
       | Fuel table (See storage.h for data layout) - Page 1
       | 16x16 table itself + the 16 values along each of the axis
       -----------------------------------------------------*/
-      writesRemaining = writeTable(&fuelTable, decltype(fuelTable)::type_key, EEPROM_CONFIG1_MAP, writesRemaining);
+      writesRemaining = writeTable(&fuelTable, decltype(fuelTable)::type_key, EEPROM_CONFIG1_MAP+offset, writesRemaining);
       break;
 
     case veSetPage:
@@ -314,7 +414,7 @@ void savePage(uint8_t pageNum)
       | Config page 2 (See storage.h for data layout)
       | 64 byte long config table
       -----------------------------------------------------*/
-      writesRemaining = write_range((byte *)&configPage2, (byte *)&configPage2+sizeof(configPage2), EEPROM_CONFIG2_START, writesRemaining);
+      writesRemaining = write_range((byte *)&configPage2, (byte *)&configPage2+sizeof(configPage2), EEPROM_CONFIG2_START+offset, writesRemaining);
       break;
 
     case ignMapPage:
@@ -322,7 +422,7 @@ void savePage(uint8_t pageNum)
       | Ignition table (See storage.h for data layout) - Page 1
       | 16x16 table itself + the 16 values along each of the axis
       -----------------------------------------------------*/
-      writesRemaining = writeTable(&ignitionTable, decltype(ignitionTable)::type_key, EEPROM_CONFIG3_MAP, writesRemaining);
+      writesRemaining = writeTable(&ignitionTable, decltype(ignitionTable)::type_key, EEPROM_CONFIG3_MAP+offset, writesRemaining);
       break;
 
     case ignSetPage:
@@ -330,7 +430,7 @@ void savePage(uint8_t pageNum)
       | Config page 2 (See storage.h for data layout)
       | 64 byte long config table
       -----------------------------------------------------*/
-      writesRemaining = write_range((byte *)&configPage4, (byte *)&configPage4+sizeof(configPage4), EEPROM_CONFIG4_START, writesRemaining);
+      writesRemaining = write_range((byte *)&configPage4, (byte *)&configPage4+sizeof(configPage4), EEPROM_CONFIG4_START+offset, writesRemaining);
       break;
 
     case afrMapPage:
@@ -338,7 +438,7 @@ void savePage(uint8_t pageNum)
       | AFR table (See storage.h for data layout) - Page 5
       | 16x16 table itself + the 16 values along each of the axis
       -----------------------------------------------------*/
-      writesRemaining = writeTable(&afrTable, decltype(afrTable)::type_key, EEPROM_CONFIG5_MAP, writesRemaining);
+      writesRemaining = writeTable(&afrTable, decltype(afrTable)::type_key, EEPROM_CONFIG5_MAP+offset, writesRemaining);
       break;
 
     case afrSetPage:
@@ -346,7 +446,7 @@ void savePage(uint8_t pageNum)
       | Config page 3 (See storage.h for data layout)
       | 64 byte long config table
       -----------------------------------------------------*/
-      writesRemaining = write_range((byte *)&configPage6, (byte *)&configPage6+sizeof(configPage6), EEPROM_CONFIG6_START, writesRemaining);
+      writesRemaining = write_range((byte *)&configPage6, (byte *)&configPage6+sizeof(configPage6), EEPROM_CONFIG6_START+offset, writesRemaining);
       break;
 
     case boostvvtPage:
@@ -354,9 +454,9 @@ void savePage(uint8_t pageNum)
       | Boost and vvt tables (See storage.h for data layout) - Page 8
       | 8x8 table itself + the 8 values along each of the axis
       -----------------------------------------------------*/
-      writesRemaining = writeTable(&boostTable, decltype(boostTable)::type_key, EEPROM_CONFIG7_MAP1, writesRemaining);
-      writesRemaining = writeTable(&vvtTable, decltype(vvtTable)::type_key, EEPROM_CONFIG7_MAP2, writesRemaining);
-      writesRemaining = writeTable(&stagingTable, decltype(stagingTable)::type_key, EEPROM_CONFIG7_MAP3, writesRemaining);
+      writesRemaining = writeTable(&boostTable, decltype(boostTable)::type_key, EEPROM_CONFIG7_MAP1+offset, writesRemaining);
+      writesRemaining = writeTable(&vvtTable, decltype(vvtTable)::type_key, EEPROM_CONFIG7_MAP2+offset, writesRemaining);
+      writesRemaining = writeTable(&stagingTable, decltype(stagingTable)::type_key, EEPROM_CONFIG7_MAP3+offset, writesRemaining);
       break;
 
     case seqFuelPage:
@@ -364,7 +464,7 @@ void savePage(uint8_t pageNum)
       | Fuel trim tables (See storage.h for data layout) - Page 9
       | 6x6 tables itself + the 6 values along each of the axis
       -----------------------------------------------------*/
-#define WRITE_TRIM_TABLE(index) writeTable(&trimTables[index-1U], trimTable3d::type_key, EEPROM_CONFIG8_MAP ## index, writesRemaining)
+#define WRITE_TRIM_TABLE(index) writeTable(&trimTables[index-1U], trimTable3d::type_key, (EEPROM_CONFIG8_MAP ## index)+offset, writesRemaining)
       writesRemaining = WRITE_TRIM_TABLE(1);
 #if INJ_CHANNELS >= 2
       writesRemaining = WRITE_TRIM_TABLE(2);
@@ -394,7 +494,7 @@ void savePage(uint8_t pageNum)
       | Config page 10 (See storage.h for data layout)
       | 192 byte long config table
       -----------------------------------------------------*/
-      writesRemaining = write_range((byte *)&configPage9, (byte *)&configPage9+sizeof(configPage9), EEPROM_CONFIG9_START, writesRemaining);
+      writesRemaining = write_range((byte *)&configPage9, (byte *)&configPage9+sizeof(configPage9), EEPROM_CONFIG9_START+offset, writesRemaining);
       break;
 
     case warmupPage:
@@ -402,7 +502,7 @@ void savePage(uint8_t pageNum)
       | Config page 11 (See storage.h for data layout)
       | 192 byte long config table
       -----------------------------------------------------*/
-      writesRemaining = write_range((byte *)&configPage10, (byte *)&configPage10+sizeof(configPage10), EEPROM_CONFIG10_START, writesRemaining);
+      writesRemaining = write_range((byte *)&configPage10, (byte *)&configPage10+sizeof(configPage10), EEPROM_CONFIG10_START+offset, writesRemaining);
       break;
 
     case fuelMap2Page:
@@ -410,7 +510,7 @@ void savePage(uint8_t pageNum)
       | Fuel table 2 (See storage.h for data layout)
       | 16x16 table itself + the 16 values along each of the axis
       -----------------------------------------------------*/
-      writesRemaining = writeTable(&fuelTable2, decltype(fuelTable2)::type_key, EEPROM_CONFIG11_MAP, writesRemaining);
+      writesRemaining = writeTable(&fuelTable2, decltype(fuelTable2)::type_key, EEPROM_CONFIG11_MAP+offset, writesRemaining);
       break;
 
     case wmiMapPage:
@@ -420,16 +520,16 @@ void savePage(uint8_t pageNum)
       | 8x8 VVT2 table + the 8 values along each of the axis
       | 4x4 Dwell table itself + the 4 values along each of the axis
       -----------------------------------------------------*/
-      writesRemaining = writeTable(&wmiTable, decltype(wmiTable)::type_key, EEPROM_CONFIG12_MAP, writesRemaining);
-      writesRemaining = writeTable(&vvt2Table, decltype(vvt2Table)::type_key, EEPROM_CONFIG12_MAP2, writesRemaining);
-      writesRemaining = writeTable(&dwellTable, decltype(dwellTable)::type_key, EEPROM_CONFIG12_MAP3, writesRemaining);
+      writesRemaining = writeTable(&wmiTable, decltype(wmiTable)::type_key, EEPROM_CONFIG12_MAP+offset, writesRemaining);
+      writesRemaining = writeTable(&vvt2Table, decltype(vvt2Table)::type_key, EEPROM_CONFIG12_MAP2+offset, writesRemaining);
+      writesRemaining = writeTable(&dwellTable, decltype(dwellTable)::type_key, EEPROM_CONFIG12_MAP3+offset, writesRemaining);
       break;
       
     case progOutsPage:
       /*---------------------------------------------------
       | Config page 13 (See storage.h for data layout)
       -----------------------------------------------------*/
-      writesRemaining = write_range((byte *)&configPage13, (byte *)&configPage13+sizeof(configPage13), EEPROM_CONFIG13_START, writesRemaining);
+      writesRemaining = write_range((byte *)&configPage13, (byte *)&configPage13+sizeof(configPage13), EEPROM_CONFIG13_START+offset, writesRemaining);
       break;
     
     case ignMap2Page:
@@ -437,7 +537,7 @@ void savePage(uint8_t pageNum)
       | Ignition table (See storage.h for data layout) - Page 1
       | 16x16 table itself + the 16 values along each of the axis
       -----------------------------------------------------*/
-      writesRemaining = writeTable(&ignitionTable2, decltype(ignitionTable2)::type_key, EEPROM_CONFIG14_MAP, writesRemaining);
+      writesRemaining = writeTable(&ignitionTable2, decltype(ignitionTable2)::type_key, EEPROM_CONFIG14_MAP+offset, writesRemaining);
       break;
 
     case boostvvtPage2:
@@ -445,18 +545,29 @@ void savePage(uint8_t pageNum)
       | Boost duty cycle lookuptable (See storage.h for data layout) - Page 15
       | 8x8 table itself + the 8 values along each of the axis
       -----------------------------------------------------*/
-      writesRemaining = writeTable(&boostTableLookupDuty, decltype(boostTableLookupDuty)::type_key, EEPROM_CONFIG15_MAP, writesRemaining);
+      writesRemaining = writeTable(&boostTableLookupDuty, decltype(boostTableLookupDuty)::type_key, EEPROM_CONFIG15_MAP+offset, writesRemaining);
 
       /*---------------------------------------------------
       | Config page 15 (See storage.h for data layout)
       -----------------------------------------------------*/
-      writesRemaining = write_range((byte *)&configPage15, (byte *)&configPage15+sizeof(configPage15), EEPROM_CONFIG15_START, writesRemaining);
+      writesRemaining = write_range((byte *)&configPage15, (byte *)&configPage15+sizeof(configPage15), EEPROM_CONFIG15_START+offset, writesRemaining);
       break;
 
     default:
       break;
   }
 
+  // A non-zero remainder means the page has been fully written
+  if (writesRemaining!=0U)
+  {
+#if defined(STORAGE_PAGE_SLOTS)
+    if (isSlotted)
+    {
+      commitSlot(pageNum, targetSlot, pageCrc);
+    }
+#endif
+    commit(getStorageAPI());
+  }
   setEepromWritePending(writesRemaining==0U);
 }
 
@@ -508,89 +619,178 @@ static inline uint16_t loadTable(table3d_t *pTable, TableType key, uint16_t addr
 
 //  ================================= End internal read support ===============================
 
-void loadAllPages(void)
+/** Load one page from storage, at the given offset from it's standard location. */
+static void loadPageFrom(uint8_t pageNum, uint16_t offset)
 {
-  (void)loadTable(&fuelTable, decltype(fuelTable)::type_key, EEPROM_CONFIG1_MAP);
-  (void)load_range(EEPROM_CONFIG2_START, (byte *)&configPage2, (byte *)&configPage2+sizeof(configPage2));
-  
-  //*********************************************************************************************************************************************************************************
-  //IGNITION CONFIG PAGE (2)
+  switch(pageNum)
+  {
+    case veMapPage:
+      (void)loadTable(&fuelTable, decltype(fuelTable)::type_key, EEPROM_CONFIG1_MAP+offset);
+      break;
 
-  (void)loadTable(&ignitionTable, decltype(ignitionTable)::type_key, EEPROM_CONFIG3_MAP);
-  (void)load_range(EEPROM_CONFIG4_START, (byte *)&configPage4, (byte *)&configPage4+sizeof(configPage4));
+    case veSetPage:
+      (void)load_range(EEPROM_CONFIG2_START+offset, (byte *)&configPage2, (byte *)&configPage2+sizeof(configPage2));
+      break;
 
-  //*********************************************************************************************************************************************************************************
-  //AFR TARGET CONFIG PAGE (3)
+    case ignMapPage:
+      (void)loadTable(&ignitionTable, decltype(ignitionTable)::type_key, EEPROM_CONFIG3_MAP+offset);
+      break;
+
+    case ignSetPage:
+      (void)load_range(EEPROM_CONFIG4_START+offset, (byte *)&configPage4, (byte *)&configPage4+sizeof(configPage4));
+      break;
 
-  (void)loadTable(&afrTable, decltype(afrTable)::type_key, EEPROM_CONFIG5_MAP);
-  (void)load_range(EEPROM_CONFIG6_START, (byte *)&configPage6, (byte *)&configPage6+sizeof(configPage6));
+    case afrMapPage:
+      (void)loadTable(&afrTable, decltype(afrTable)::type_key, EEPROM_CONFIG5_MAP+offset);
+      break;
 
-  //*********************************************************************************************************************************************************************************
-  // Boost and vvt tables load
-  (void)loadTable(&boostTable, decltype(boostTable)::type_key, EEPROM_CONFIG7_MAP1);
-  (void)loadTable(&vvtTable, decltype(vvtTable)::type_key,  EEPROM_CONFIG7_MAP2);
-  (void)loadTable(&stagingTable, decltype(stagingTable)::type_key, EEPROM_CONFIG7_MAP3);
+    case afrSetPage:
+      (void)load_range(EEPROM_CONFIG6_START+offset, (byte *)&configPage6, (byte *)&configPage6+sizeof(configPage6));
+      break;
 
-  //*********************************************************************************************************************************************************************************
-  // Fuel trim tables load
-#define LOAD_TRIM_TABLE(index) (void)loadTable(&trimTables[index-1U], trimTable3d::type_key, EEPROM_CONFIG8_MAP ## index)
-  LOAD_TRIM_TABLE(1);
+    case boostvvtPage:
+      (void)loadTable(&boostTable, decltype(boostTable)::type_key, EEPROM_CONFIG7_MAP1+offset);
+      (void)loadTable(&vvtTable, decltype(vvtTable)::type_key,  EEPROM_CONFIG7_MAP2+offset);
+      (void)loadTable(&stagingTable, decltype(stagingTable)::type_key, EEPROM_CONFIG7_MAP3+offset);
+      break;
+
+    case seqFuelPage:
+#define LOAD_TRIM_TABLE(index) (void)loadTable(&trimTables[index-1U], trimTable3d::type_key, (EEPROM_CONFIG8_MAP ## index)+offset)
+      LOAD_TRIM_TABLE(1);
 #if INJ_CHANNELS >= 2
-  LOAD_TRIM_TABLE(2);
+      LOAD_TRIM_TABLE(2);
 #endif
 #if INJ_CHANNELS >= 3
-  LOAD_TRIM_TABLE(3);
+      LOAD_TRIM_TABLE(3);
 #endif
 #if INJ_CHANNELS >= 4
-  LOAD_TRIM_TABLE(4);
+      LOAD_TRIM_TABLE(4);
 #endif
 #if INJ_CHANNELS >= 5
-  LOAD_TRIM_TABLE(5);
+      LOAD_TRIM_TABLE(5);
 #endif
 #if INJ_CHANNELS >= 6
-  LOAD_TRIM_TABLE(6);
+      LOAD_TRIM_TABLE(6);
 #endif
 #if INJ_CHANNELS >= 7
-  LOAD_TRIM_TABLE(7);
+      LOAD_TRIM_TABLE(7);
 #endif
 #if INJ_CHANNELS >= 8
-  LOAD_TRIM_TABLE(8);
+      LOAD_TRIM_TABLE(8);
 #endif
+      break;
 
-  //*********************************************************************************************************************************************************************************
-  //canbus control page load
-  (void)load_range(EEPROM_CONFIG9_START, (byte *)&configPage9, (byte *)&configPage9+sizeof(configPage9));
+    case canbusPage:
+      (void)load_range(EEPROM_CONFIG9_START+offset, (byte *)&configPage9, (byte *)&configPage9+sizeof(configPage9));
+      break;
 
-  //*********************************************************************************************************************************************************************************
+    case warmupPage:
+      (void)load_range(EEPROM_CONFIG10_START+offset, (byte *)&configPage10, (byte *)&configPage10+sizeof(configPage10));
+      break;
 
-  //CONFIG PAGE (10)
-  (void)load_range(EEPROM_CONFIG10_START, (byte *)&configPage10, (byte *)&configPage10+sizeof(configPage10));
+    case fuelMap2Page:
+      (void)loadTable(&fuelTable2, decltype(fuelTable2)::type_key, EEPROM_CONFIG11_MAP+offset);
+      break;
 
-  //*********************************************************************************************************************************************************************************
-  //Fuel table 2 (See storage.h for data layout)
-  (void)loadTable(&fuelTable2, decltype(fuelTable2)::type_key, EEPROM_CONFIG11_MAP);
+    case wmiMapPage:
+      (void)loadTable(&wmiTable, decltype(wmiTable)::type_key, EEPROM_CONFIG12_MAP+offset);
+      (void)loadTable(&vvt2Table, decltype(vvt2Table)::type_key, EEPROM_CONFIG12_MAP2+offset);
+      (void)loadTable(&dwellTable, decltype(dwellTable)::type_key, EEPROM_CONFIG12_MAP3+offset);
+      break;
 
-  //*********************************************************************************************************************************************************************************
-  // WMI, VVT2 and Dwell table load
-  (void)loadTable(&wmiTable, decltype(wmiTable)::type_key, EEPROM_CONFIG12_MAP);
-  (void)loadTable(&vvt2Table, decltype(vvt2Table)::type_key, EEPROM_CONFIG12_MAP2);
-  (void)loadTable(&dwellTable, decltype(dwellTable)::type_key, EEPROM_CONFIG12_MAP3);
+    case progOutsPage:
+      (void)load_range(EEPROM_CONFIG13_START+offset, (byte *)&configPage13, (byte *)&configPage13+sizeof(configPage13));
+      break;
 
-  //*********************************************************************************************************************************************************************************
-  //CONFIG PAGE (13)
-  (void)load_range(EEPROM_CONFIG13_START, (byte *)&configPage13, (byte *)&configPage13+sizeof(configPage13));
+    case ignMap2Page:
+      (void)loadTable(&ignitionTable2, decltype(ignitionTable2)::type_key, EEPROM_CONFIG14_MAP+offset);
+      break;
 
-  //*********************************************************************************************************************************************************************************
-  //SECOND IGNITION CONFIG PAGE (14)
+    case boostvvtPage2:
+      (void)loadTable(&boostTableLookupDuty, decltype(boostTableLookupDuty)::type_key, EEPROM_CONFIG15_MAP+offset);
+      (void)load_range(EEPROM_CONFIG15_START+offset, (byte *)&configPage15, (byte *)&configPage15+sizeof(configPage15));
+      break;
 
-  (void)loadTable(&ignitionTable2, decltype(ignitionTable2)::type_key, EEPROM_CONFIG14_MAP);
+    default:
+      break;
+  }
+}
 
-  //*********************************************************************************************************************************************************************************
-  //CONFIG PAGE (15) + boost duty lookup table (LUT)
-  (void)loadTable(&boostTableLookupDuty, decltype(boostTableLookupDuty)::type_key, EEPROM_CONFIG15_MAP);
-  (void)load_range(EEPROM_CONFIG15_START, (byte *)&configPage15, (byte *)&configPage15+sizeof(configPage15));  
+#if defined(STORAGE_PAGE_SLOTS)
+/** Load the newest slot that passes the CRC check */
+static void loadSlottedPage(uint8_t pageNum)
+{
+  uint8_t slot = isNewerSequence(loadSlotSequence(pageNum, 1U), loadSlotSequence(pageNum, 0U)) ? 1U : 0U;
+  for (uint8_t attempt=0U; attempt<2U; ++attempt)
+  {
+    loadPageFrom(pageNum, getSlotOffset(slot));
+    if (calculatePageCRC32(pageNum)==loadSlotCrc(pageNum, slot))
+    {
+      setActiveSlot(pageNum, slot);
+      return;
+    }
+    slot = slot ^ 1U;
+  }
 
-  //*********************************************************************************************************************************************************************************
+  // Neither slot is valid. E.g. the tune was saved before slots were introduced, so use the
+  // standard location. The next burn of the page will then write a valid slot.
+  loadPageFrom(pageNum, getSlotOffset(0U));
+  setActiveSlot(pageNum, 0U);
+}
+#endif
+
+void loadPage(uint8_t pageNum)
+{
+#if defined(STORAGE_PAGE_SLOTS)
+  if (isPageSlotsEnabled())
+  {
+    loadSlottedPage(pageNum);
+  }
+  else
+#endif
+  {
+    loadPageFrom(pageNum, 0U);
+  }
+}
+
+void loadAllPages(void)
+{
+  for (uint8_t pageNum=MIN_PAGE_NUM; pageNum<MAX_PAGE_NUM; ++pageNum)
+  {
+    loadPage(pageNum);
+  }
+}
+
+void beginStandardPageLocations(void)
+{
+#if defined(STORAGE_PAGE_SLOTS)
+  if (isPageSlotsEnabled())
+  {
+    isSlotsSuspended = true;
+    // The active copy may be in slot B
+    saveAllPages();
+  }
+#endif
+}
+
+void endStandardPageLocations(void)
+{
+#if defined(STORAGE_PAGE_SLOTS)
+  if (isSlotsSuspended)
+  {
+    saveAllPages();
+    isSlotsSuspended = false;
+    // If throttled, slot A isn't complete: leave the existing slots as they are
+    if (!isEepromWritePending())
+    {
+      for (uint8_t pageNum=MIN_PAGE_NUM; pageNum<MAX_PAGE_NUM; ++pageNum)
+      {
+        commitSlot(pageNum, 0U, calculatePageCRC32(pageNum));
+      }
+      commit(getStorageAPI());
+    }
+  }
+#endif
 }
 
 void loadAllCalibrationTables(void)
@@ -641,6 +841,7 @@ void saveCalibrationTable(SensorCalibrationTable sensor)
   } else {
     // Unknown sensor identifier - do nothing but keep MISRA checker happy
   }
+  commit(getStorageAPI());
 }
 
 // LCOV_EXCL_START
@@ -648,6 +849,7 @@ void saveCalibrationTable(SensorCalibrationTable sensor)
 void saveCalibrationCrc(SensorCalibrationTable sensor, uint32_t calibrationCRC)
 {
   updateObject(getStorageAPI(), calibrationCRC, getSensorCalibrationAddress(sensor, SensorCalibrationTableElement::Crc));
+  commit(getStorageAPI());
 }
 
 /** Retrieves and returns the 4 byte CRC32 checksum for a given calibration page from EEPROM. */
@@ -669,7 +871,10 @@ uint8_t loadLastBaro(void)
 }
 void saveLastBaro(uint8_t newValue)
 { 
-  (void)update(getStorageAPI(), EEPROM_LAST_BARO, newValue); 
+  if (update(getStorageAPI(), EEPROM_LAST_BARO, newValue))
+  {
+    commit(getStorageAPI());
+  }
 }
 // LCOV_EXCL_STOP
 
@@ -681,7 +886,10 @@ uint8_t loadEEPROMVersion(void)
 }
 void saveEEPROMVersion(uint8_t newVersion)
 { 
-  (void)update(getStorageAPI(), EEPROM_DATA_VERSION, newVersion); 
+  if (update(getStorageAPI(), EEPROM_DATA_VERSION, newVersion))
+  {
+    commit(getStorageAPI());
+  }
 }
 // LCOV_EXCL_STOP
 
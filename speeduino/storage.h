@@ -52,9 +52,35 @@ void saveAllPages(void);
  */
 void savePage(uint8_t pageNum);
 
-/** @brief Load all pages from durable storage. I.e. load the tune */
+/** @brief Load all pages from durable storage. I.e. load the tune
+ * 
+ * If the storage is large enough to hold 2 copies of each page (A/B slots), the newest copy that passes
+ * its CRC check is loaded. So a burn interrupted by power loss falls back to the previous copy.
+ */
 void loadAllPages(void);
 
+/** @brief Load one page from durable storage
+ * 
+ * Same as loadAllPages(), but for a single page. Allows the pages needed to start the engine to be
+ * loaded first.
+ */
+void loadPage(uint8_t pageNum);
+
+/** @brief Use only the standard page locations until endStandardPageLocations()
+ *
+ * For code that reads or moves page data in storage directly (E.g. tune updates), which only knows
+ * the standard locations. The tune in RAM is written to the standard locations (A/B slot A) first.
+ * Does nothing if the storage does not have A/B slots.
+ */
+void beginStandardPageLocations(void);
+
+/** @brief Finish beginStandardPageLocations()
+ *
+ * Saves the tune in RAM to the standard locations and makes them the newest copy of each page,
+ * so an older copy in slot B can't replace them on the next load.
+ */
+void endStandardPageLocations(void);
+
 /**
  * @brief Do we have page data that needs to be written to durable storage?
  * 
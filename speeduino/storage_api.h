@@ -33,8 +33,22 @@ struct storage_api_t {
 
     /** @brief The maximum number of write operations that will be performed in one go. */
     uint16_t (*getMaxWriteBlockSize)(const statuses &current);
+
+    /** @brief Optional function to make all writes since the previous call durable, as one atomic operation.
+     * 
+     * Called once a complete page (or other logical unit) has been written. Storage that buffers
+     * writes (E.g. a flash log) uses this to save the page in one go. nullptr if not required.
+     */
+    void (*commit)(void) = nullptr;
 };
 
+/** @brief Commit buffered writes, if the storage requires it. See storage_api_t::commit */
+static inline void commit(const storage_api_t &api) {
+    if (api.commit!=nullptr) {
+        api.commit();
+    }
+}
+
 /**
  * @brief Conditionally write a byte to storage if it differs from the one already saved.
  * 
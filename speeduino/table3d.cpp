@@ -7,6 +7,7 @@
 struct row_begin_visitor {
     template <typename TTable>
     table_value_iterator visit(TTable &table) {
+        static_assert(sizeof(typename TTable::value_t::value_type)==sizeof(table3d_value_t), "Only 8-bit table values can be iterated as bytes");
         return table.values.begin();
     }
 };
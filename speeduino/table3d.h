@@ -49,7 +49,7 @@
 #include "table3d_axes.h"
 #include "table3d_values.h"
 
-#define TO_TYPE_KEY(size, xDom, yDom) table3d ## size ## xDom ## yDom ## _key
+#define TO_TYPE_KEY(size, xDom, yDom, vType) CONCAT(TABLE3D_TYPENAME_BASE(size, xDom, yDom, vType), _key)
 
 /**
  * @brief Table \b type identifiers. Limited compile time RTTI
@@ -69,7 +69,7 @@
 enum class TableType : uint8_t {
     table_type_None,
 /// @cond
-    #define TABLE3D_GEN_TYPEKEY(size, xDom, yDom) TO_TYPE_KEY(size, xDom, yDom),
+    #define TABLE3D_GEN_TYPEKEY(size, xDom, yDom, vType) TO_TYPE_KEY(size, xDom, yDom, vType),
     TABLE3D_GENERATOR(TABLE3D_GEN_TYPEKEY)
 /// @endcond
 };
@@ -80,19 +80,19 @@ struct table3d_t
 };
 
 // Generate the 3D table types
-#define TABLE3D_GEN_TYPE(size, xDom, yDom) \
-    /** @brief A 3D table with size x size dimensions, xDom x-axis and yDom y-axis */ \
-    struct TABLE3D_TYPENAME_BASE(size, xDom, yDom) : public table3d_t \
+#define TABLE3D_GEN_TYPE(size, xDom, yDom, vType) \
+    /** @brief A 3D table with size x size dimensions, xDom x-axis, yDom y-axis and vType values */ \
+    struct TABLE3D_TYPENAME_BASE(size, xDom, yDom, vType) : public table3d_t \
     { \
         typedef TABLE3D_TYPENAME_AXIS(size) xaxis_t; \
         typedef TABLE3D_TYPENAME_AXIS(size) yaxis_t; \
-        typedef TABLE3D_TYPENAME_VALUE(size, xDom, yDom) value_t; \
+        typedef TABLE3D_TYPENAME_VALUE(size, xDom, yDom, vType) value_t; \
         /* This will take up zero space unless we take the address somewhere */ \
-        static constexpr TableType type_key = TableType::TO_TYPE_KEY(size, xDom, yDom); \
+        static constexpr TableType type_key = TableType::TO_TYPE_KEY(size, xDom, yDom, vType); \
         static constexpr AxisDomain XDomain = AxisDomain::xDom; \
         static constexpr AxisDomain YDomain = AxisDomain::yDom; \
         \
-        mutable table3DGetValueCache get_value_cache; \
+        mutable table3DValueCache<value_t::value_type> get_value_cache; \
         value_t values; \
         xaxis_t axisX; \
         yaxis_t axisY; \
@@ -102,13 +102,13 @@ TABLE3D_GENERATOR(TABLE3D_GEN_TYPE)
 // LCOV_EXCL_STOP
 
 // Generate get3DTableValue() functions
-#define TABLE3D_GEN_GET_TABLE_VALUE(size, xDom, yDom) \
-    static inline table3d_value_t get3DTableValue(const TABLE3D_TYPENAME_BASE(size, xDom, yDom) *pTable, const uint16_t y, const uint16_t x) \
+#define TABLE3D_GEN_GET_TABLE_VALUE(size, xDom, yDom, vType) \
+    static inline TABLE3D_VALUE_TYPE(vType) get3DTableValue(const TABLE3D_TYPENAME_BASE(size, xDom, yDom, vType) *pTable, const uint16_t y, const uint16_t x) \
     { \
       constexpr uint16_t xFactor = getConversionFactor(AxisDomain::xDom); \
       constexpr uint16_t yFactor = getConversionFactor(AxisDomain::yDom); \
       return get3DTableValue<xFactor, yFactor>( &pTable->get_value_cache, \
-                              TABLE3D_TYPENAME_BASE(size, xDom, yDom)::value_t::row_size, \
+                              TABLE3D_TYPENAME_BASE(size, xDom, yDom, vType)::value_t::row_size, \
                               pTable->values.values, \
                               pTable->axisX.axis, \
                               pTable->axisY.axis, \
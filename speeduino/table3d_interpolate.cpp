@@ -98,47 +98,28 @@ table3d_dim_t find_bin_max(
 /// 
 /// @see https://en.wikipedia.org/wiki/Q_(number_format).
 ///
-/// This is specialised for the number range 0..1 - a generic fixed point
-/// class would miss some important optimisations. Specifically, we can avoid
-/// type promotion during multiplication. 
-typedef uint16_t QU1X8_t;
+/// This is the raw value of a UQ8_8_t, specialised for the number range 0..1.
+/// A generic fixed point multiply would miss some important optimisations. Specifically,
+/// we can avoid type promotion during multiplication (see UQ8_8_t::mulUnit()). 
+typedef UQ8_8_t::storage_t QU1X8_t;
 
 /** @brief Integer shift to convert to/from QU1X8_t. */
-constexpr QU1X8_t QU1X8_INTEGER_SHIFT = 8;
+constexpr QU1X8_t QU1X8_INTEGER_SHIFT = UQ8_8_t::FRACTIONAL_BITS;
 
-static constexpr QU1X8_t toQU1X8(uint16_t base) {
-  return base << QU1X8_INTEGER_SHIFT;
-}
 static constexpr uint16_t fromQU1X8(QU1X8_t base) {
   return base >> QU1X8_INTEGER_SHIFT;
 }
 
 /** @brief Precomputed value of 1 in QU1X8_t. */
-TESTABLE_CONSTEXPR QU1X8_t QU1X8_ONE = toQU1X8(1U);
-
-/** @brief Precomputed value of 0.5 in QU1X8_t. */
-TESTABLE_CONSTEXPR QU1X8_t QU1X8_HALF = QU1X8_ONE/2U;
+TESTABLE_CONSTEXPR QU1X8_t QU1X8_ONE = UQ8_8_t::fromInteger(1U).raw();
 
 /** @brief Multiply two QU1X8_t values. */
 TESTABLE_INLINE_STATIC QU1X8_t mulQU1X8(QU1X8_t a, QU1X8_t b)
 {
-    // 1x1 == 1....but the real reason for this is to avoid 16-bit multiplication overflow.
-    //
-    // We are using uint16_t as our underlying fixed point type. If we follow the regular
-    // code path, we'd need to promote to uint32_t to avoid overflow.
-    //
-    // The overflow can only happen when *both* the X & Y inputs
-    // are at the edge of a bin. 
-    //
-    // This is a rare condition, so most of the time we can use 16-bit multiplication and gain performance
-    if (a==QU1X8_ONE && b==QU1X8_ONE)
-    {
-        return QU1X8_ONE;
-    }
-  // Add the equivalent of 0.5 to the final calculation pre-rounding.
-  // This will have the effect of rounding to the nearest integer, rather
-  // than always rounding down.
-  return fromQU1X8((a * b) + QU1X8_HALF);
+  // The overflow can only happen when *both* the X & Y inputs
+  // are at the edge of a bin. This is a rare condition, so
+  // most of the time we can use 16-bit multiplication and gain performance
+  return UQ8_8_t::mulUnit(UQ8_8_t::fromRaw(a), UQ8_8_t::fromRaw(b)).raw();
 }
 
 /// @}
@@ -236,6 +217,54 @@ TESTABLE_INLINE_STATIC table3d_value_t bilinear_interpolation( const table3d_val
   return fromQU1X8( (tl * m) + (tr * n) + (bl * o) + (br * r) );
 }
 
+/**
+ * @brief 2d interpolation of 16-bit values
+ *
+ * As bilinear_interpolation(table3d_value_t...), except the weighted sum needs
+ * 32-bit accumulation. Kept separate so that 8-bit tables keep the cheaper
+ * 16-bit arithmetic.
+ * 
+ * @tparam TValue The table value type
+ * @tparam TAccumulator The weighted sum type: must hold TValue's range * QU1X8_ONE
+ */
+template <typename TValue, typename TAccumulator>
+static inline TValue bilinear_interpolation_wide( const TValue &tl,
+                                                  const TValue &tr,
+                                                  const TValue &bl,
+                                                  const TValue &br,
+                                                  const QU1X8_t &dx,
+                                                  const QU1X8_t &dy) {
+  const QU1X8_t m = mulQU1X8(QU1X8_ONE-dx, dy);
+  const QU1X8_t n = mulQU1X8(dx, dy);
+  const QU1X8_t o = mulQU1X8(QU1X8_ONE-dx, QU1X8_ONE-dy);
+  const QU1X8_t r = mulQU1X8(dx, QU1X8_ONE-dy);
+  const TAccumulator sum = ((TAccumulator)tl * (TAccumulator)m) 
+                         + ((TAccumulator)tr * (TAccumulator)n) 
+                         + ((TAccumulator)bl * (TAccumulator)o)
+                         + ((TAccumulator)br * (TAccumulator)r);
+  return (TValue)(sum >> QU1X8_INTEGER_SHIFT);
+}
+
+/** @copydoc bilinear_interpolation_wide */
+static inline table3d_value16_t bilinear_interpolation( const table3d_value16_t &tl,
+                                                        const table3d_value16_t &tr,
+                                                        const table3d_value16_t &bl,
+                                                        const table3d_value16_t &br,
+                                                        const QU1X8_t &dx,
+                                                        const QU1X8_t &dy) {
+  return bilinear_interpolation_wide<table3d_value16_t, uint32_t>(tl, tr, bl, br, dx, dy);
+}
+
+/** @copydoc bilinear_interpolation_wide */
+static inline table3d_svalue16_t bilinear_interpolation( const table3d_svalue16_t &tl,
+                                                         const table3d_svalue16_t &tr,
+                                                         const table3d_svalue16_t &bl,
+                                                         const table3d_svalue16_t &br,
+                                                         const QU1X8_t &dx,
+                                                         const QU1X8_t &dy) {
+  return bilinear_interpolation_wide<table3d_svalue16_t, int32_t>(tl, tr, bl, br, dx, dy);
+}
+
 /**
  * @brief Interpolate a table value from axis bins & values.
  * 
@@ -247,12 +276,13 @@ TESTABLE_INLINE_STATIC table3d_value_t bilinear_interpolation( const table3d_val
  * @param xMultiplier The x-axis multiplier
  * @param pYAxis The y-axis
  * @param yMultiplier The y-axis multiplier
- * @return table3d_value_t 
+ * @return The interpolated value
  */
-table3d_value_t interpolate_3d_value(const xy_pair_t &lookUpValues, 
+template <typename TValue>
+static inline TValue interpolate_3d_value_impl(const xy_pair_t &lookUpValues, 
                     const xy_coord2d &upperBinIndices,
                     const table3d_dim_t &axisSize,
-                    const table3d_value_t *pValues,
+                    const TValue *pValues,
                     const table3d_axis_t *pXAxis,
                     const uint16_t xMultiplier,
                     const table3d_axis_t *pYAxis,
@@ -287,10 +317,10 @@ table3d_value_t interpolate_3d_value(const xy_pair_t &lookUpValues,
   Note that the values are stored in a 1D array, so we need to calculate the indices 
   appropriately based on the array layout.
   */
-  table3d_value_t A = pValues[tr.row + bl.col];
-  table3d_value_t B = pValues[tr.row + tr.col];
-  table3d_value_t C = pValues[bl.row + bl.col];
-  table3d_value_t D = pValues[bl.row + tr.col];  
+  TValue A = pValues[tr.row + bl.col];
+  TValue B = pValues[tr.row + tr.col];
+  TValue C = pValues[bl.row + bl.col];
+  TValue D = pValues[bl.row + tr.col];  
   
   //Check that all values aren't just the same (This regularly happens with things like the fuel trim maps)
   if( (A == B) && (A == C) && (A == D) ) 
@@ -307,4 +337,40 @@ table3d_value_t interpolate_3d_value(const xy_pair_t &lookUpValues,
   }
 }
 
-/// @}
\ No newline at end of file
+table3d_value_t interpolate_3d_value(const xy_pair_t &lookUpValues, 
+                    const xy_coord2d &upperBinIndices,
+                    const table3d_dim_t &axisSize,
+                    const table3d_value_t *pValues,
+                    const table3d_axis_t *pXAxis,
+                    const uint16_t xMultiplier,
+                    const table3d_axis_t *pYAxis,
+                    const uint16_t yMultiplier)
+{
+  return interpolate_3d_value_impl(lookUpValues, upperBinIndices, axisSize, pValues, pXAxis, xMultiplier, pYAxis, yMultiplier);
+}
+
+table3d_value16_t interpolate_3d_value(const xy_pair_t &lookUpValues, 
+                    const xy_coord2d &upperBinIndices,
+                    const table3d_dim_t &axisSize,
+                    const table3d_value16_t *pValues,
+                    const table3d_axis_t *pXAxis,
+                    const uint16_t xMultiplier,
+                    const table3d_axis_t *pYAxis,
+                    const uint16_t yMultiplier)
+{
+  return interpolate_3d_value_impl(lookUpValues, upperBinIndices, axisSize, pValues, pXAxis, xMultiplier, pYAxis, yMultiplier);
+}
+
+table3d_svalue16_t interpolate_3d_value(const xy_pair_t &lookUpValues, 
+                    const xy_coord2d &upperBinIndices,
+                    const table3d_dim_t &axisSize,
+                    const table3d_svalue16_t *pValues,
+                    const table3d_axis_t *pXAxis,
+                    const uint16_t xMultiplier,
+                    const table3d_axis_t *pYAxis,
+                    const uint16_t yMultiplier)
+{
+  return interpolate_3d_value_impl(lookUpValues, upperBinIndices, axisSize, pValues, pXAxis, xMultiplier, pYAxis, yMultiplier);
+}
+
+/// @}
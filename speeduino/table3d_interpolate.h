@@ -30,8 +30,12 @@ struct xy_coord2d
   table3d_dim_t y;
 };
 
-/** @brief Cache structure for 3D table value lookups. */
-struct table3DGetValueCache {
+/** @brief Cache structure for 3D table value lookups.
+ * 
+ * @tparam TValue The table value type
+ */
+template <typename TValue>
+struct table3DValueCache {
   // Store the upper *index* of the X and Y axis bins that were last hit.
   // This is used to make the next check faster since very likely the x & y values have
   // only changed by a small amount & are in the same bin (or an adjacent bin).
@@ -49,11 +53,15 @@ struct table3DGetValueCache {
 
   //Store the last input and output values, again for caching purposes
   xy_pair_t last_lookup = { UINT16_MAX, UINT16_MAX };
-  table3d_value_t lastOutput;
+  TValue lastOutput;
 };
 
+/** @brief Cache for 3D tables of table3d_value_t */
+using table3DGetValueCache = table3DValueCache<table3d_value_t>;
+
 /** @brief Invalidate the cache by resetting the last lookup values. */
-static inline void invalidate_cache(table3DGetValueCache *pCache)
+template <typename TValue>
+static inline void invalidate_cache(table3DValueCache<TValue> *pCache)
 {
     pCache->last_lookup.x = UINT16_MAX;
 }
@@ -67,6 +75,7 @@ extern table3d_dim_t find_bin_max(
   table3d_dim_t length,
   table3d_dim_t lastBinMax);
 
+// One per value type: the interpolation is specialised per value width
 extern table3d_value_t interpolate_3d_value(const xy_pair_t &lookUpValues, 
                     const xy_coord2d &axisCoords,
                     const table3d_dim_t &axisSize,
@@ -75,6 +84,22 @@ extern table3d_value_t interpolate_3d_value(const xy_pair_t &lookUpValues,
                     const uint16_t xMultiplier,
                     const table3d_axis_t *pYAxis,
                     const uint16_t yMultiplier);
+extern table3d_value16_t interpolate_3d_value(const xy_pair_t &lookUpValues, 
+                    const xy_coord2d &axisCoords,
+                    const table3d_dim_t &axisSize,
+                    const table3d_value16_t *pValues,
+                    const table3d_axis_t *pXAxis,
+                    const uint16_t xMultiplier,
+                    const table3d_axis_t *pYAxis,
+                    const uint16_t yMultiplier);
+extern table3d_svalue16_t interpolate_3d_value(const xy_pair_t &lookUpValues, 
+                    const xy_coord2d &axisCoords,
+                    const table3d_dim_t &axisSize,
+                    const table3d_svalue16_t *pValues,
+                    const table3d_axis_t *pXAxis,
+                    const uint16_t xMultiplier,
+                    const table3d_axis_t *pYAxis,
+                    const uint16_t yMultiplier);
 
 /// @endcond
 
@@ -112,6 +137,7 @@ extern table3d_value_t interpolate_3d_value(const xy_pair_t &lookUpValues,
  * 
  * @tparam xFactor The factor used to scale the lookup value to/from the same units as the axis values.
  * @tparam yFactor The factor for the Y axis values.
+ * @tparam TValue The table value type: table3d_value_t, table3d_value16_t or table3d_svalue16_t
  * @param pValueCache Pointer to the value cache structure.
  * @param axisSize The size of the axis.
  * @param pValues Pointer to the table values.
@@ -120,10 +146,10 @@ extern table3d_value_t interpolate_3d_value(const xy_pair_t &lookUpValues,
  * @param lookupValues The X axis and Y axis values to look up.
  * @return The interpolated value from the table.
  */
-template <uint16_t xFactor, uint16_t yFactor>
-table3d_value_t get3DTableValue(struct table3DGetValueCache *pValueCache, 
+template <uint16_t xFactor, uint16_t yFactor, typename TValue>
+TValue get3DTableValue(table3DValueCache<TValue> *pValueCache, 
                     const table3d_dim_t axisSize,
-                    const table3d_value_t *pValues,
+                    const TValue *pValues,
                     const table3d_axis_t *pXAxis,
                     const table3d_axis_t *pYAxis,
                     const xy_pair_t &lookupValues) {
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stdint.h>
+#include "preprocessor.h"
 
 /** @brief Encodes the \b length of the axes */
 using table3d_dim_t = uint8_t;
@@ -24,23 +25,51 @@ using table3d_dim_t = uint8_t;
 /** @brief The type of each table value */
 using table3d_value_t = uint8_t;
 
+/** @brief The type of each table value, for tables that need more than 8-bit resolution (E.g. 0.1% VE) */
+using table3d_value16_t = uint16_t;
+
+/** @brief The type of each table value, for tables with negative values (E.g. spark advance without an offset) */
+using table3d_svalue16_t = int16_t;
+
 /** @brief The type of each axis value */
 using table3d_axis_t = uint8_t;
 
 /** @brief Core 3d table generation macro
  * 
  * We have a fixed number of table types: they are defined by this macro.
- * GENERATOR is expected to be another macros that takes at least 3 arguments:
- *    axis length, x-axis domain, y-axis domain
+ * GENERATOR is expected to be another macros that takes at least 4 arguments:
+ *    axis length, x-axis domain, y-axis domain, value type
+ * 
+ * The value type is one of:
+ *    - U8: table3d_value_t
+ *    - U16: table3d_value16_t
+ *    - S16: table3d_svalue16_t
+ * 
+ * @note The tune storage & TunerStudio page code is byte oriented, so only
+ * supports U8 tables at the moment.
  */
 #define TABLE3D_GENERATOR(GENERATOR, ...) \
-    GENERATOR(6, Rpm, Load, ##__VA_ARGS__) \
-    GENERATOR(4, Rpm, Load, ##__VA_ARGS__) \
-    GENERATOR(8, Rpm, Load, ##__VA_ARGS__) \
-    GENERATOR(16, Rpm, Load, ##__VA_ARGS__)
+    GENERATOR(6, Rpm, Load, U8, ##__VA_ARGS__) \
+    GENERATOR(4, Rpm, Load, U8, ##__VA_ARGS__) \
+    GENERATOR(8, Rpm, Load, U8, ##__VA_ARGS__) \
+    GENERATOR(16, Rpm, Load, U8, ##__VA_ARGS__)
+
+/// @cond
+// Map the TABLE3D_GENERATOR value type to a C++ type & a type name suffix.
+// 8-bit tables have no suffix.
+#define TABLE3D_VALUE_TYPE_U8 table3d_value_t
+#define TABLE3D_VALUE_TYPE_U16 table3d_value16_t
+#define TABLE3D_VALUE_TYPE_S16 table3d_svalue16_t
+#define TABLE3D_VALUE_SUFFIX_U8
+#define TABLE3D_VALUE_SUFFIX_U16 U16
+#define TABLE3D_VALUE_SUFFIX_S16 S16
+/// @endcond
+
+/** @brief The C++ type of a TABLE3D_GENERATOR value type */
+#define TABLE3D_VALUE_TYPE(vType) TABLE3D_VALUE_TYPE_ ## vType
 
-// Each 3d table is given a distinct type based on size & axis domains
+// Each 3d table is given a distinct type based on size, axis domains & value type
 // This encapsulates the generation of the type name
-#define TABLE3D_TYPENAME_BASE(size, xDom, yDom) table3d ## size ## xDom ## yDom
+#define TABLE3D_TYPENAME_BASE(size, xDom, yDom, vType) CONCAT(table3d ## size ## xDom ## yDom, TABLE3D_VALUE_SUFFIX_ ## vType)
 
 /** @} */
\ No newline at end of file
@@ -16,9 +16,12 @@
 
 /**  @brief Iterate through a table row. I.e. constant Y, changing X 
  * 
- * Instances of this class are normally created via a table_value_iterator instance.
+ * Instances of this class are normally created via a table_value_iterator_t instance.
+ * 
+ * @tparam TValue The table value type
 */
-class table_row_iterator {
+template <typename TValue>
+class table_row_iterator_t {
 public:
 
     /** 
@@ -26,29 +29,29 @@ public:
      * @param pRowStart Pointer to the 1st element in the row
      * @param rowWidth The number of elements to in the row
     */
-    table_row_iterator(const table3d_value_t *pRowStart, table3d_dim_t rowWidth)
+    table_row_iterator_t(const TValue *pRowStart, table3d_dim_t rowWidth)
         : pValue(pRowStart), pEnd(pRowStart+rowWidth)  //cppcheck-suppress misra-c2012-10.4
     {
     }
 
     // LCOV_EXCL_START
     /** @brief Pointer to the end of the row */
-    const table3d_value_t* end(void) const { return pEnd; }
-    /** @copydoc table_row_iterator::end() const */
-    table3d_value_t* end(void) { return const_cast<table3d_value_t *>(pEnd); }
+    const TValue* end(void) const { return pEnd; }
+    /** @copydoc table_row_iterator_t::end() const */
+    TValue* end(void) { return const_cast<TValue *>(pEnd); }
     // LCOV_EXCL_STOP
 
     /** @brief Advance the iterator
      * @param steps The number of elements to move the iterator
     */
-    table_row_iterator& advance(table3d_dim_t steps)
+    table_row_iterator_t& advance(table3d_dim_t steps)
     { 
         pValue  = pValue + steps;
         return *this;
     }
 
     /** @brief Increment the iterator by one element*/
-    table_row_iterator& operator++(void)
+    table_row_iterator_t& operator++(void)
     {
         return advance(1);
     }
@@ -61,14 +64,14 @@ public:
 
     // LCOV_EXCL_START
     /** @brief Dereference the iterator */
-    const table3d_value_t& operator*(void) const
+    const TValue& operator*(void) const
     {
         return *pValue;
     }
-    /** @copydoc table_row_iterator::operator*() const */
-    table3d_value_t& operator*(void)
+    /** @copydoc table_row_iterator_t::operator*() const */
+    TValue& operator*(void)
     {
-        return *const_cast<table3d_value_t *>(pValue);
+        return *const_cast<TValue *>(pValue);
     }
     // LCOV_EXCL_STOP
 
@@ -76,14 +79,18 @@ public:
     table3d_dim_t size(void) const { return pEnd-pValue; }
 
 private:
-    const table3d_value_t *pValue;
-    const table3d_value_t *pEnd;
+    const TValue *pValue;
+    const TValue *pEnd;
 };
 
 // ========================= INTER-ROW ITERATION ========================= 
 
-/**  @brief Iterate through a tables values, row by row. */
-class table_value_iterator
+/**  @brief Iterate through a tables values, row by row.
+ * 
+ * @tparam TValue The table value type
+*/
+template <typename TValue>
+class table_value_iterator_t
 {
 public:
 
@@ -92,7 +99,7 @@ public:
      * @param pValues Pointer to the 1st value in a 1-d array
      * @param axisSize The number of columns & elements per row (square tables only)
     */
-    table_value_iterator(const table3d_value_t *pValues, table3d_dim_t axisSize)
+    table_value_iterator_t(const TValue *pValues, table3d_dim_t axisSize)
         : pRowsStart(pValues + (axisSize*(axisSize-1U))),  //cppcheck-suppress misra-c2012-10.4
         pRowsEnd(pValues - axisSize),
         rowWidth(axisSize)
@@ -113,27 +120,27 @@ public:
     /** @brief Advance the iterator
      * @param rows The number of \b rows to move
     */
-    table_value_iterator& advance(table3d_dim_t rows)
+    table_value_iterator_t& advance(table3d_dim_t rows)
     {
         pRowsStart = pRowsStart - (rowWidth * rows);
         return *this;
     }
 
     /** @brief Increment the iterator by one \b row */
-    table_value_iterator& operator++(void)
+    table_value_iterator_t& operator++(void)
     {
         return advance(1U);
     }
 
     /** @brief Dereference the iterator to access a row of data */
-    table_row_iterator operator*(void) const
+    table_row_iterator_t<TValue> operator*(void) const
     {
-        return table_row_iterator(pRowsStart, rowWidth);
+        return table_row_iterator_t<TValue>(pRowsStart, rowWidth);
     }
-    /** @copydoc table_value_iterator::operator*() const */
-    table_row_iterator operator*(void)
+    /** @copydoc table_value_iterator_t::operator*() const */
+    table_row_iterator_t<TValue> operator*(void)
     {
-        return table_row_iterator(pRowsStart, rowWidth);
+        return table_row_iterator_t<TValue>(pRowsStart, rowWidth);
     }    
 
     /** @brief Test for end of iteration */
@@ -143,16 +150,24 @@ public:
     }
 
 private:
-    const table3d_value_t *pRowsStart;
-    const table3d_value_t *pRowsEnd;
+    const TValue *pRowsStart;
+    const TValue *pRowsEnd;
     table3d_dim_t rowWidth;
 };
 
-#define TABLE3D_TYPENAME_VALUE(size, xDom, yDom) CONCAT(TABLE3D_TYPENAME_BASE(size, xDom, yDom), _values)
+/** @brief Iterate through a table row of table3d_value_t */
+using table_row_iterator = table_row_iterator_t<table3d_value_t>;
+
+/** @brief Iterate through the rows of a table of table3d_value_t */
+using table_value_iterator = table_value_iterator_t<table3d_value_t>;
+
+#define TABLE3D_TYPENAME_VALUE(size, xDom, yDom, vType) CONCAT(TABLE3D_TYPENAME_BASE(size, xDom, yDom, vType), _values)
 
-#define TABLE3D_GEN_VALUES(size, xDom, yDom) \
-    /** @brief The values for a 3D table with size x size dimensions, xDom x-axis and yDom y-axis */ \
-    struct TABLE3D_TYPENAME_VALUE(size, xDom, yDom) { \
+#define TABLE3D_GEN_VALUES(size, xDom, yDom, vType) \
+    /** @brief The values for a 3D table with size x size dimensions, xDom x-axis, yDom y-axis and vType values */ \
+    struct TABLE3D_TYPENAME_VALUE(size, xDom, yDom, vType) { \
+        /** @brief The type of each value */ \
+        typedef TABLE3D_VALUE_TYPE(vType) value_type; \
         /** @brief The number of items in a row. I.e. it's length  */ \
         static constexpr table3d_dim_t row_size = (size); \
         /** @brief The number of rows */ \
@@ -164,12 +179,12 @@ private:
          (normal cartesian coordinates) has this layout:<br> \
          6, 7, 8, 3, 4, 5, 0, 1, 2 \
         */ \
-        table3d_value_t values[(uint16_t)row_size*num_rows]; \
+        value_type values[(uint16_t)row_size*num_rows]; \
         \
         /** @brief Iterate over the values */ \
-        table_value_iterator begin(void) \
+        table_value_iterator_t<value_type> begin(void) \
         {  \
-            return table_value_iterator(values, row_size); \
+            return table_value_iterator_t<value_type>(values, row_size); \
         } \
         \
         /** \
@@ -190,7 +205,7 @@ private:
          This limits us to 16x16 tables. If we need bigger and move to 16-bit \
          operations, consider using libdivide. <br> \
          */ \
-        table3d_value_t& value_at(table3d_dim_t linear_index) \
+        value_type& value_at(table3d_dim_t linear_index) \
         { \
             static_assert(row_size<17U, "Table is too big"); \
             static_assert(num_rows<17U, "Table is too big"); \
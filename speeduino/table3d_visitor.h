@@ -30,9 +30,9 @@ static inline TReturn visitTable3d(table3d_t &table, TableType key, TConcreteVis
         case TableType::table_type_None:
         // LCOV_EXCL_STOP
 /// @cond
-        #define VISIT_CASE(size, xDom, yDom) \
-            case TableType::TO_TYPE_KEY(size, xDom, yDom): \
-                return visitor.visit(static_cast<TABLE3D_TYPENAME_BASE(size, xDom, yDom) &>(table)); 
+        #define VISIT_CASE(size, xDom, yDom, vType) \
+            case TableType::TO_TYPE_KEY(size, xDom, yDom, vType): \
+                return visitor.visit(static_cast<TABLE3D_TYPENAME_BASE(size, xDom, yDom, vType) &>(table)); 
 /// @endcond
 
         TABLE3D_GENERATOR(VISIT_CASE)
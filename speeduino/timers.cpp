@@ -24,6 +24,7 @@ Timers are typically low resolution (Compared to Schedulers), with maximum frequ
 #include "src/pins/boardOutputPin.h"
 #include "src/controllers/fuelPump/fuelPumpController.h"
 #include "src/controllers/fan/fanController.h"
+#include "atomic_profile.h"
 
 TESTABLE_STATIC volatile uint16_t lastRPM_100ms; //Need to record this for rpmDOT calculation
 TESTABLE_STATIC volatile byte loop5ms;
@@ -55,7 +56,7 @@ TESTABLE_STATIC volatile uint8_t TIMER_mask;
 
 uint8_t getAndClearTimerMask(void)
 {
-  ATOMIC() {
+  ATOMIC_PROFILED(ATOMIC_SITE_TIMER_MASK) {
     uint8_t mask = TIMER_mask;
     TIMER_mask = 0U;
     return mask;
@@ -95,8 +96,6 @@ void oneMSInterval(void)
   loop250ms++;
   loopSec++;
 
-  applyOverDwellProtection(configPage4, currentStatus);
-
   //Tacho is flagged as being ready for a pulse by the ignition outputs, or the sweep interval upon startup
 
   // See if we're in power-on sweep mode
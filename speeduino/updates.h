@@ -4,6 +4,7 @@
 #include "table3d.h"
 
 void doUpdates(void);
+bool isUpdateRequired(void); //True if the stored data version differs from this firmware. I.e. doUpdates() has work to do
 void multiplyTableLoad(table3d_t *pTable, TableType key, uint8_t multiplier); //Added 202201 - to update the table Y axis as TPS now works at 0.5% increments. Multiplies the load axis values by 4 (most tables) or by 2 (VVT table)
 void divideTableLoad(table3d_t *pTable, TableType key, uint8_t divisor); //Added 202201 - to update the table Y axis as TPS now works at 0.5% increments. This should only be needed by the VVT tables when using MAP as load. 
 void multiplyTableValue(uint8_t pageNum, uint8_t multiplier); //Added to update the table values. Multiplies the value by the multiplier
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__AVR__)
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#endif
+
+/**
+ * @brief Measure the CPU cycles taken by a function.
+ *
+ * On AVR, Timer4 is clocked directly from the CPU clock (no prescaler) for the duration of the
+ * measurement. simavr models the timers cycle accurately, so under the simulator (and on a real
+ * Mega) the count is exact & repeatable. Interrupts are disabled while measuring, so ISRs don't
+ * pollute the count. The call overhead is measured once & subtracted.
+ *
+ * Other platforms have no cycle counter: the function is still called, but the count is always 0.
+ */
+class cycle_counter {
+public:
+    using function_t = void(*)(void);
+
+    /** @brief A measurement that took longer than the 16-bit counter can measure */
+    static constexpr uint32_t OVERFLOW_CYCLES = UINT32_MAX;
+
+    static constexpr bool isAvailable(void) {
+#if defined(__AVR__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /** @brief Call the function once & return the cycles it took. It must take less than 65536 cycles. */
+    static uint32_t measure(function_t func) {
+        static uint32_t overhead = OVERFLOW_CYCLES;
+        if (overhead==OVERFLOW_CYCLES) {
+            overhead = measureRaw(emptyFunction);
+        }
+        uint32_t cycles = measureRaw(func);
+        return cycles==OVERFLOW_CYCLES ? cycles : cycles - overhead;
+    }
+
+private:
+    static void emptyFunction(void) {
+        __asm__ __volatile__ ("" ::: "memory");
+    }
+
+    // Not inlined, so every measurement has the same call overhead
+    static __attribute__((noinline)) uint32_t measureRaw(function_t func) {
+#if defined(__AVR__)
+        uint8_t oldSREG = SREG;
+        cli();
+        uint8_t oldTCCR4A = TCCR4A;
+        uint8_t oldTCCR4B = TCCR4B;
+        TCCR4A = 0U;
+        TCCR4B = _BV(CS40);
+        TIFR4 = _BV(TOV4);
+
+        uint16_t start = TCNT4;
+        func();
+        uint16_t end = TCNT4;
+
+        // A single overflow is handled by the unsigned subtraction. More than that can't be measured.
+        bool isOverflow = ((TIFR4 & _BV(TOV4))!=0U) && (end >= start);
+        TCCR4A = oldTCCR4A;
+        TCCR4B = oldTCCR4B;
+        SREG = oldSREG;
+        return isOverflow ? OVERFLOW_CYCLES : (uint16_t)(end - start);
+#else
+        func();
+        return 0U;
+#endif
+    }
+};
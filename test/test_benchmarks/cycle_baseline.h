@@ -0,0 +1,32 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Checked in AVR cycle counts for the benchmarks, recorded under simavr (env:megaatmega2560_sim_unittest)
+ *
+ * simavr is cycle accurate, so a benchmark fails if its count differs from the baseline by more
+ * than BASELINE_TOLERANCE_CYCLES, in either direction. After an intentional change (or a compiler
+ * upgrade), copy the cycle counts reported by the benchmarks into this file.
+ *
+ * A baseline of 0 hasn't been recorded yet. That benchmark reports its cycle count & fails, until
+ * the count is recorded here.
+ */
+
+#include <stdint.h>
+#include "decoder_init.h"
+
+/** @brief Allowed difference from a baseline, in cycles. 0: the count must match exactly */
+constexpr uint32_t BASELINE_TOLERANCE_CYCLES = 0U;
+
+constexpr uint32_t BASELINE_GET3DTABLEVALUE = 0U;
+constexpr uint32_t BASELINE_TABLE2D_GETVALUE = 0U;
+constexpr uint32_t BASELINE_CORRECTIONSFUEL = 0U;
+constexpr uint32_t BASELINE_COMPUTEPULSEWIDTHS = 0U;
+constexpr uint32_t BASELINE_ANGLETOTIME = 0U;
+
+/** @brief Primary trigger ISR, indexed by decoder number (see decoder_init.h) */
+constexpr uint32_t BASELINE_DECODER_PRIMARY_ISR[DECODER_MAX] = {
+  0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, // 0-9
+  0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, // 10-19
+  0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U,     // 20-28
+};
@@ -0,0 +1,11 @@
+#include "../test_harness_device.h"
+#include "../test_harness_native.h"
+
+void runAllBenchmarks(void)
+{
+  extern void testBenchmarks(void);
+
+  testBenchmarks();
+}
+
+TEST_HARNESS(runAllBenchmarks)
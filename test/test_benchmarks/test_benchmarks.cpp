@@ -0,0 +1,158 @@
+#include <unity.h>
+#include "../test_utils.h"
+#include "../cycle_counter.hpp"
+#include "../test_fuel/pw_test_context.h"
+#include "cycle_baseline.h"
+#include "globals.h"
+#include "table3d.h"
+#include "corrections.h"
+#include "sensors.h"
+#include "units.h"
+#include "fuel_calcs.h"
+#include "crankMaths.h"
+#include "decoder_init.h"
+
+// Each benchmark measures a single call, from a fixed starting state. So under the simulator
+// the cycle count is exactly repeatable: any change is due to a code (or compiler) change.
+
+extern table2D_u8_u8_9 IATDensityCorrectionTable;
+extern table2D_u8_u8_8 baroFuelTable;
+
+static volatile uint32_t resultSink; // Stop the compiler optimising away the benchmarked calls
+
+static void checkCycles(const char *name, uint32_t cycles, uint32_t baseline)
+{
+  if (!cycle_counter::isAvailable())
+  {
+    TEST_IGNORE_MESSAGE("Cycle counts are only available on AVR");
+  }
+
+  char szMsg[96];
+  snprintf(szMsg, _countof(szMsg)-1, "Cycles %s: %" PRIu32 " (baseline %" PRIu32 ")", name, cycles, baseline);
+  TEST_MESSAGE(szMsg);
+  TEST_ASSERT_NOT_EQUAL_UINT32_MESSAGE(cycle_counter::OVERFLOW_CYCLES, cycles, "Too long to measure");
+  TEST_ASSERT_NOT_EQUAL_UINT32_MESSAGE(0U, baseline, "No baseline recorded in cycle_baseline.h");
+  TEST_ASSERT_UINT32_WITHIN_MESSAGE(BASELINE_TOLERANCE_CYCLES, baseline, cycles, "Cycle count differs from the baseline");
+}
+
+static uint16_t benchLoad;
+static uint16_t benchRpm;
+static void lookupFuelTable(void) { resultSink = get3DTableValue(&fuelTable, benchLoad, benchRpm); }
+
+static void test_benchmark_get3DTableValue(void)
+{
+  table3d_axis_t value = 5;
+  for (table_axis_iterator it = fuelTable.axisX.begin(); !it.at_end(); ++it) { *it = value; value += 5; }
+  value = 10;
+  for (table_axis_iterator it = fuelTable.axisY.begin(); !it.at_end(); ++it) { *it = value; value += 10; }
+  fill_table_values(fuelTable, 80);
+
+  // Prime the cache in one cell, then measure a lookup that must move to another cell
+  benchLoad = 125U;
+  benchRpm = 6250U;
+  lookupFuelTable();
+  benchLoad = 55U;
+  benchRpm = 2250U;
+
+  checkCycles("get3DTableValue", cycle_counter::measure(lookupFuelTable), BASELINE_GET3DTABLEVALUE);
+}
+
+static void lookupIatTable(void) { resultSink = table2D_getValue(&IATDensityCorrectionTable, (uint8_t)65U); }
+
+static void test_benchmark_table2D_getValue(void)
+{
+  static constexpr uint8_t bins[] = { 10, 30, 50, 70, 90, 110, 130, 150, 170 };
+  static constexpr uint8_t values[] = { 120, 115, 110, 105, 100, 95, 90, 85, 80 };
+  populate_2dtable(&IATDensityCorrectionTable, values, bins); // Also invalidates the cache
+
+  checkCycles("table2D_getValue", cycle_counter::measure(lookupIatTable), BASELINE_TABLE2D_GETVALUE);
+}
+
+static void runCorrectionsFuel(void) { resultSink = correctionsFuel(); }
+
+static void test_benchmark_correctionsFuel(void)
+{
+  initialiseCorrections();
+  populate_2dtable(&IATDensityCorrectionTable, (uint8_t)110, (uint8_t)100);
+  populate_2dtable(&baroFuelTable, (uint8_t)100, (uint8_t)100);
+  currentStatus.IAT = temperatureRemoveOffset(100);
+
+  // Worst case: every sensor was read, so the sensor rate corrections are recomputed
+  currentStatus.LOOP_TIMER = 0U;
+  BIT_SET(currentStatus.LOOP_TIMER, CLT_READ_TIMER_BIT);
+  BIT_SET(currentStatus.LOOP_TIMER, IAT_READ_TIMER_BIT);
+  BIT_SET(currentStatus.LOOP_TIMER, BARO_READ_TIMER_BIT);
+  BIT_SET(currentStatus.LOOP_TIMER, FLEX_READ_TIMER_BIT);
+
+  checkCycles("correctionsFuel", cycle_counter::measure(runCorrectionsFuel), BASELINE_CORRECTIONSFUEL);
+}
+
+static ComputePulseWidthsContext pwContext;
+static void runComputePulseWidths(void)
+{
+  resultSink = computePulseWidths(pwContext.page2, pwContext.page6, pwContext.page10, pwContext.current).primary;
+}
+
+static void test_benchmark_computePulseWidths(void)
+{
+  pwContext = getBasicPwContext();
+  pwContext.page2.injOpen = 10;
+  pwContext.page2.reqFuel = 11;
+  pwContext.page2.multiplyMAP = MULTIPLY_MAP_MODE_100;
+  pwContext.current.MAP = 94;
+  pwContext.current.VE = 130U;
+  pwContext.current.corrections = 113U;
+  pwContext.current.batCorrection = 95U;
+
+  checkCycles("computePulseWidths", cycle_counter::measure(runComputePulseWidths), BASELINE_COMPUTEPULSEWIDTHS);
+}
+
+static void runAngleToTime(void) { resultSink = angleToTime(137U); }
+
+static void test_benchmark_angleToTime(void)
+{
+  setAngleConverterRevolutionTime(20000U); // 3000 RPM
+
+  checkCycles("angleToTime", cycle_counter::measure(runAngleToTime), BASELINE_ANGLETOTIME);
+}
+
+static uint8_t decoderToBenchmark;
+static void test_benchmark_decoder_primary_isr(void)
+{
+  pinNumbers.pinTrigger = 18;
+  pinNumbers.pinTrigger2 = 19;
+  pinNumbers.pinTrigger3 = 20;
+  configPage4.TrigEdge = 1;
+  configPage4.triggerTeeth = 31;
+  configPage4.triggerAngle = 77;
+  configPage4.TrigAngMul = 3;
+  configPage4.triggerFilter = 0; // Every call is processed as a tooth
+  configPage2.nCylinders = 4;
+  currentStatus.initialisationComplete = false;
+  currentStatus.decoder = buildDecoder(decoderToBenchmark);
+  currentStatus.decoder.reset();
+
+  // Measure the 2nd tooth after a reset: the 1st only starts the tooth timing
+  currentStatus.decoder.primary.callback();
+
+  char szName[32];
+  snprintf(szName, _countof(szName)-1, "decoder %" PRIu8 " primary ISR", decoderToBenchmark);
+  checkCycles(szName, cycle_counter::measure(currentStatus.decoder.primary.callback), BASELINE_DECODER_PRIMARY_ISR[decoderToBenchmark]);
+}
+
+void testBenchmarks(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_benchmark_get3DTableValue);
+    RUN_TEST_P(test_benchmark_table2D_getValue);
+    RUN_TEST_P(test_benchmark_correctionsFuel);
+    RUN_TEST_P(test_benchmark_computePulseWidths);
+    RUN_TEST_P(test_benchmark_angleToTime);
+    for (decoderToBenchmark = 0U; decoderToBenchmark < DECODER_MAX; ++decoderToBenchmark)
+    {
+      char szPostfix[8];
+      snprintf(szPostfix, _countof(szPostfix)-1, "_%" PRIu8, decoderToBenchmark);
+      RUN_TEST_POSTFIX_P(test_benchmark_decoder_primary_isr, szPostfix);
+    }
+  }
+}
@@ -11,6 +11,7 @@ extern long boost_pwm_target_value;
 extern volatile bool boost_pwm_state;
 extern volatile unsigned int boost_pwm_cur_value;
 extern table2D_u8_s16_6 flexBoostTable;
+extern uint16_t getBoostPidSampleCalls(const config10 &page10);
 
 static void test_boost_disabled(void)
 {
@@ -253,6 +254,46 @@ static void test_cl_boost_control_fixed(void)
   TEST_ASSERT_NOT_EQUAL(0, currentStatus.boostDuty);
 }
 
+static void test_cl_boost_pid_sample_calls(void)
+{
+  configPage10.boostIntv = 0;
+  TEST_ASSERT_EQUAL_UINT16(0U, getBoostPidSampleCalls(configPage10));
+  configPage10.boostIntv = BOOST_CONTROL_INTERVAL_MS;
+  TEST_ASSERT_EQUAL_UINT16(1U, getBoostPidSampleCalls(configPage10));
+  configPage10.boostIntv = BOOST_CONTROL_INTERVAL_MS+1U;
+  TEST_ASSERT_EQUAL_UINT16(2U, getBoostPidSampleCalls(configPage10));
+  configPage10.boostIntv = 100U;
+  TEST_ASSERT_EQUAL_UINT16(4U, getBoostPidSampleCalls(configPage10));
+  configPage10.boostIntv = UINT8_MAX;
+  TEST_ASSERT_EQUAL_UINT16(8U, getBoostPidSampleCalls(configPage10));
+}
+
+static void test_cl_boost_pid_computes_every_nth_call(void)
+{
+  setup_boost_tune(false, VSS_MODE_EXTERNAL_MI, CLOSED_LOOP_BOOST, BOOST_BY_GEAR_OFF);
+  configPage10.boostIntv = BOOST_CONTROL_INTERVAL_MS*2U;
+  configPage15.boostControlEnable = EN_BOOST_CONTROL_FIXED;
+  currentStatus.MAP = 50;
+  configPage15.boostControlEnableThreshold = currentStatus.MAP - 10;
+  initialiseBoost(TEST_BOOST_PIN);
+
+  // The PID computes on every 2nd call, including across the periodic re-read of the PID settings.
+  // The PID output is never the marker value, so the marker is only replaced when the PID computes
+  constexpr uint16_t NOT_COMPUTED = 9999U;
+  uint8_t computeCount = 0U;
+  bool lastComputed = false;
+  for (uint8_t call = 0U; call < 48U; ++call)
+  {
+    currentStatus.boostDuty = NOT_COMPUTED;
+    boostControl();
+    bool computed = currentStatus.boostDuty != NOT_COMPUTED;
+    if (call != 0U) { TEST_ASSERT_NOT_EQUAL(lastComputed, computed); }
+    lastComputed = computed;
+    computeCount = computeCount + (computed ? 1U : 0U);
+  }
+  TEST_ASSERT_EQUAL_UINT8(24U, computeCount);
+}
+
 static void run_cl_tests(void)
 {
   RUN_TEST_P(test_boost_cl_target_clamp);
@@ -260,6 +301,8 @@ static void run_cl_tests(void)
   RUN_TEST_P(test_cl_boost_constant_gear);
   RUN_TEST_P(test_cl_boost_control_baro);
   RUN_TEST_P(test_cl_boost_control_fixed);
+  RUN_TEST_P(test_cl_boost_pid_sample_calls);
+  RUN_TEST_P(test_cl_boost_pid_computes_every_nth_call);
 }
 
 void testBoostControl(void)
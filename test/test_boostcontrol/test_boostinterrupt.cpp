@@ -3,9 +3,13 @@
 #include "src/controllers/boost/boostController.h"
 #include "shared.h"
 #include "src/pins/boardOutputPin.h"
+#include "softPwm.h"
 
 extern volatile bool boost_pwm_state;
 extern boardOutputPin_t boost_pin;
+extern long boost_pwm_target_value;
+extern uint16_t boost_pwm_max_count;
+extern bool isBoostPwmActiveLow(void);
 
 static void test_on_to_off(void)
 {
@@ -31,11 +35,31 @@ static void test_off_to_on(void)
     TEST_ASSERT_TRUE(boost_pwm_state);
 }
 
+static void test_hardware_pwm_matches_interrupt(void)
+{
+    pinNumbers.pinBoost = TEST_BOOST_PIN;
+    initialiseBoost(TEST_BOOST_PIN);
+    boost_pwm_max_count = 1000U;
+    boost_pwm_target_value = 250;
+
+    // One period of the interrupt: the duty, then the rest of the period
+    boost_pwm_state = false;
+    boostInterrupt();
+    uint32_t highTicks = boost_pin._pin.isPinHigh() ? 250U : 0U;
+    boostInterrupt();
+    highTicks += boost_pin._pin.isPinHigh() ? 750U : 0U;
+
+    // Hardware PWM is high for the same part of the period
+    constexpr uint8_t RESOLUTION = 15U;
+    TEST_ASSERT_EQUAL_UINT32((highTicks << RESOLUTION) / 1000U, getAuxPwmHardwareDuty(250U, 1000U, RESOLUTION, isBoostPwmActiveLow()));
+}
+
 void testBoostInterrupt(void)
 {
   SET_UNITY_FILENAME()
   {
     RUN_TEST_P(test_on_to_off);
     RUN_TEST_P(test_off_to_on);
+    RUN_TEST_P(test_hardware_pwm_matches_interrupt);
   }
 }
\ No newline at end of file
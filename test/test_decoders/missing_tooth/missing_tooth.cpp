@@ -4,6 +4,7 @@
 #include "scheduler.h"
 #include "../../test_utils.h"
 #include "scheduler_ignition_controller.h"
+#include "scheduler_fuel_controller.h"
 
 static decoder_t test_setup_36_1()
 {
@@ -332,6 +333,200 @@ void test_missingtooth_newIgn_60_2_trig181_2()
     TEST_ASSERT_EQUAL(58, ignitionEndTeeth[1]);
 }
 
+//************************************** Charge tooth (angle domain scheduling) tests **************************************
+
+static void assert_charge_tooth(uint16_t tooth, uint16_t residual)
+{
+    TEST_ASSERT_EQUAL_UINT16(tooth, ignitionSchedule1.chargeTooth.tooth);
+    TEST_ASSERT_EQUAL_UINT16(residual, ignitionSchedule1.chargeTooth.residual);
+}
+
+static void test_missingtooth_chargeTooth_36_1_wasted(void)
+{
+    decoder_t decoder = test_setup_36_1();
+    configPage2.perToothIgn = true;
+    configPage4.sparkMode = IGN_MODE_WASTED;
+    configPage4.triggerAngle = 0;
+    int16_t oldMaxAngle = CRANK_ANGLE_MAX_IGN;
+    CRANK_ANGLE_MAX_IGN = 360;
+
+    ignitionSchedule1.chargeAngle = 305;
+    decoder.setEndTeeth();
+    assert_charge_tooth(31, 5);
+
+    // An angle on a tooth is set from the tooth before
+    ignitionSchedule1.chargeAngle = 300;
+    decoder.setEndTeeth();
+    assert_charge_tooth(30, 10);
+
+    // Tooth 36 is missing
+    ignitionSchedule1.chargeAngle = 355;
+    decoder.setEndTeeth();
+    assert_charge_tooth(35, 15);
+    ignitionSchedule1.chargeAngle = 0;
+    decoder.setEndTeeth();
+    assert_charge_tooth(35, 20);
+
+    configPage4.triggerAngle = 90;
+    ignitionSchedule1.chargeAngle = 50;
+    decoder.setEndTeeth();
+    assert_charge_tooth(32, 10);
+
+    CRANK_ANGLE_MAX_IGN = oldMaxAngle;
+}
+
+static void test_missingtooth_chargeTooth_36_1_sequential(void)
+{
+    decoder_t decoder = test_setup_36_1();
+    configPage2.perToothIgn = true;
+    configPage4.sparkMode = IGN_MODE_SEQUENTIAL;
+    configPage2.strokes = FOUR_STROKE;
+    configPage4.triggerAngle = 0;
+    int16_t oldMaxAngle = CRANK_ANGLE_MAX_IGN;
+    CRANK_ANGLE_MAX_IGN = 720;
+
+    // 2nd revolution teeth are numbered on from the 1st
+    ignitionSchedule1.chargeAngle = 500;
+    decoder.setEndTeeth();
+    assert_charge_tooth(50, 10);
+
+    // The teeth only cover 360° of a 720° cycle
+    configPage4.sparkMode = IGN_MODE_WASTED;
+    decoder.setEndTeeth();
+    assert_charge_tooth(0, 0);
+
+    CRANK_ANGLE_MAX_IGN = oldMaxAngle;
+}
+
+static void test_missingtooth_getToothAngle(void)
+{
+    decoder_t decoder = test_setup_36_1();
+    configPage2.perToothIgn = true;
+    configPage4.sparkMode = IGN_MODE_WASTED;
+    configPage4.triggerAngle = 0;
+
+    // E.g. a paired injection open angle
+    toothAngle_t position = decoder.getToothAngle(125, 360U);
+    TEST_ASSERT_EQUAL_UINT16(13U, position.tooth);
+    TEST_ASSERT_EQUAL_UINT16(5U, position.residual);
+
+    // The teeth don't cover a 720° sequential injection cycle without sequential ignition
+    TEST_ASSERT_EQUAL_UINT16(0U, decoder.getToothAngle(125, 720U).tooth);
+
+    // The primary trigger doesn't run the per tooth timing
+    configPage2.perToothIgn = false;
+    TEST_ASSERT_EQUAL_UINT16(0U, decoder.getToothAngle(125, 360U).tooth);
+}
+
+//************************************** Tooth registered schedules (trigger ISR) tests **************************************
+
+extern volatile unsigned long toothLastToothTime;
+extern volatile unsigned long toothLastMinusOneToothTime;
+extern volatile unsigned long triggerFilterTime;
+extern volatile uint16_t toothCurrentCount;
+extern volatile uint16_t triggerToothAngle;
+extern decoder_status_t decoderStatus;
+
+static constexpr uint32_t TOOTH_GAP_US = 1111U; // 36-1 at 1500 RPM
+
+// A 36-1 wheel running in full sync, with the given tooth the last one seen
+static decoder_t setup_36_1_running(uint16_t lastTooth)
+{
+    decoder_t decoder = test_setup_36_1();
+    configPage4.sparkMode = IGN_MODE_WASTED;
+    configPage2.injLayout = INJ_PAIRED;
+    configPage4.triggerAngle = 0;
+    configPage4.triggerFilter = 0;
+    configPage2.perToothIgn = true;
+    currentStatus.rotationStatus = EngineRotationStatus::Running;
+    currentStatus.setRpm(3000U); // Only looks for the missing tooth in the last quarter of the wheel
+    fixedCrankingOverride = 0;
+    memset(ignitionEndTeeth, 0, sizeof(ignitionEndTeeth));
+    ignitionSchedule1.reset();
+    fuelSchedule1.reset();
+
+    decoderStatus.syncStatus = SyncStatus::Full;
+    decoderStatus.toothAngleIsCorrect = true;
+    triggerFilterTime = 0;
+    toothCurrentCount = lastTooth;
+    toothLastToothTime = micros() - TOOTH_GAP_US;
+    toothLastMinusOneToothTime = toothLastToothTime - TOOTH_GAP_US;
+    return decoder;
+}
+
+// Run the ISR as if the next tooth arrived gapUs after the last one.
+// The tooth times are set directly instead of waiting, so the gap doesn't depend on delay jitter
+static void triggerToothAfter(decoder_t &decoder, uint32_t gapUs)
+{
+    uint32_t lastGap = toothLastToothTime - toothLastMinusOneToothTime;
+    toothLastToothTime = micros() - gapUs;
+    toothLastMinusOneToothTime = toothLastToothTime - lastGap;
+    decoder.primary.callback();
+}
+
+// The schedule counter keeps running, so the ISR set the schedule from a counter value
+// between counterBeforeTooth and the current counter
+static void assert_set_from_tooth(Schedule &schedule, COMPARE_TYPE counterBeforeTooth, uint32_t delay, uint16_t duration)
+{
+    TEST_ASSERT_EQUAL(PENDING, schedule._status);
+    TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(duration), schedule.activeParams().duration);
+    COMPARE_TYPE counterAtTooth = schedule._compare - uS_TO_TIMER_COMPARE(delay);
+    COMPARE_TYPE counterNow = schedule._counter;
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32((COMPARE_TYPE)(counterNow - counterBeforeTooth), (COMPARE_TYPE)(counterAtTooth - counterBeforeTooth));
+}
+
+// The delay from a tooth, using the gap the ISR just measured
+static uint32_t residualToTime(uint16_t residual)
+{
+    return ((uint32_t)residual * (toothLastToothTime - toothLastMinusOneToothTime)) / triggerToothAngle;
+}
+
+static void test_missingtooth_toothSchedule_isr_sets_schedule(void)
+{
+    decoder_t decoder = setup_36_1_running(3U);
+
+    setScheduleAtTooth(ignitionSchedule1, toothAngle_t{ 5U, 4U }, 3000U);
+    setScheduleAtTooth(fuelSchedule1, toothAngle_t{ 6U, 7U }, 4000U);
+
+    // Nothing happens before the registered tooth
+    triggerToothAfter(decoder, TOOTH_GAP_US);
+    TEST_ASSERT_EQUAL_UINT16(4U, toothCurrentCount);
+    TEST_ASSERT_EQUAL(OFF, ignitionSchedule1._status);
+    TEST_ASSERT_EQUAL(OFF, fuelSchedule1._status);
+
+    COMPARE_TYPE counterBeforeTooth = ignitionSchedule1._counter;
+    triggerToothAfter(decoder, TOOTH_GAP_US);
+    TEST_ASSERT_EQUAL_UINT16(5U, toothCurrentCount);
+    TEST_ASSERT_TRUE(decoder.getStatus().toothAngleIsCorrect);
+    assert_set_from_tooth(ignitionSchedule1, counterBeforeTooth, residualToTime(4U), 3000U);
+    TEST_ASSERT_EQUAL(OFF, fuelSchedule1._status);
+
+    counterBeforeTooth = fuelSchedule1._counter;
+    triggerToothAfter(decoder, TOOTH_GAP_US);
+    TEST_ASSERT_EQUAL_UINT16(6U, toothCurrentCount);
+    assert_set_from_tooth(fuelSchedule1, counterBeforeTooth, residualToTime(7U), 4000U);
+
+    ignitionSchedule1.reset();
+    fuelSchedule1.reset();
+}
+
+static void test_missingtooth_toothSchedule_isr_missing_tooth_gap(void)
+{
+    decoder_t decoder = setup_36_1_running(35U);
+    // Deliberately not the speed the teeth are fed at
+    setAngleConverterRevolutionTime(100000UL);
+
+    setScheduleAtTooth(ignitionSchedule1, toothAngle_t{ 1U, 5U }, 3000U);
+
+    // The gap spans the missing tooth, so can't be used to convert the residual angle
+    COMPARE_TYPE counterBeforeTooth = ignitionSchedule1._counter;
+    triggerToothAfter(decoder, TOOTH_GAP_US * 2U);
+    TEST_ASSERT_EQUAL_UINT16(1U, toothCurrentCount);
+    TEST_ASSERT_FALSE(decoder.getStatus().toothAngleIsCorrect);
+    assert_set_from_tooth(ignitionSchedule1, counterBeforeTooth, angleToTime(5U), 3000U);
+
+    ignitionSchedule1.reset();
+}
 
 void test_missingtooth_newIgn_2()
 {
@@ -370,6 +565,12 @@ void testMissingTooth()
   RUN_TEST_P(test_missingtooth_newIgn_36_1_trigNeg270_2);
   RUN_TEST_P(test_missingtooth_newIgn_36_1_trigNeg360_2);
 
+  RUN_TEST_P(test_missingtooth_chargeTooth_36_1_wasted);
+  RUN_TEST_P(test_missingtooth_chargeTooth_36_1_sequential);
+  RUN_TEST_P(test_missingtooth_getToothAngle);
+  RUN_TEST_P(test_missingtooth_toothSchedule_isr_sets_schedule);
+  RUN_TEST_P(test_missingtooth_toothSchedule_isr_missing_tooth_gap);
+
   //RUN_TEST_P(test_missingtooth_newIgn_60_2_trig181_2);
   //RUN_TEST_P(test_missingtooth_newIgn_60_2_trig182_2);
    }
@@ -10,7 +10,7 @@ extern volatile unsigned long toothOneTime;
 extern volatile unsigned long toothOneMinusOneTime;
 extern volatile unsigned long toothLastToothTime;
 extern volatile unsigned long toothLastMinusOneToothTime;
-extern uint16_t toothCurrentCount;
+extern volatile uint16_t toothCurrentCount;
 extern unsigned long MAX_STALL_TIME;
 
 static void test_primary_trigger(decoder_t &decoder, uint8_t decoderNum)
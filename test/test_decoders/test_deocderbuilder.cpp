@@ -13,6 +13,7 @@ static void assert_decoder_builder(const decoder_builder_t& builder)
     TEST_ASSERT_NOT_NULL(decoder.getRPM);
     TEST_ASSERT_NOT_NULL(decoder.getCrankAngle);
     TEST_ASSERT_NOT_NULL(decoder.setEndTeeth);
+    TEST_ASSERT_NOT_NULL(decoder.getToothAngle);
     TEST_ASSERT_NOT_NULL(decoder.reset);
     TEST_ASSERT_NOT_NULL(decoder.getStatus);
     TEST_ASSERT_NOT_NULL(decoder.getFeatures);
@@ -24,6 +25,7 @@ static void assert_decoder_builder(const decoder_builder_t& builder)
     decoder.getRPM();
     decoder.getCrankAngle();
     decoder.setEndTeeth();
+    decoder.getToothAngle(0, 360U);
     decoder.reset();
     decoder.getStatus();
     decoder.getFeatures();
@@ -136,6 +138,27 @@ static void test_setSetEndTeeth(void)
     assert_decoder_builder( builder );
 }
 
+static toothAngle_t incrementGetToothAngle(int16_t angle, uint16_t maxAngle)
+{
+    counter++;
+    return toothAngle_t{ (uint16_t)angle, maxAngle };
+}
+
+static void test_setGetToothAngle(void)
+{
+    auto builder = decoder_builder_t().setGetToothAngle( incrementGetToothAngle );
+
+    counter = 0;
+    TEST_ASSERT_EQUAL_UINT16( 7, builder.build().getToothAngle(7, 360U).tooth );
+    TEST_ASSERT_EQUAL_UINT8( 1, counter );
+
+    assert_decoder_builder( builder );
+
+    builder.setGetToothAngle( nullptr );
+    assert_decoder_builder( builder );
+    TEST_ASSERT_EQUAL_UINT16( 0, builder.build().getToothAngle(7, 360U).tooth );
+}
+
 static void test_setReset(void)
 {
     auto builder = decoder_builder_t().setReset( triggerHandlerIncrement );
@@ -217,6 +240,7 @@ void testDecoderBuilder(void)
     RUN_TEST_P( test_setGetRPM );
     RUN_TEST_P( test_setGetCrankAngle );
     RUN_TEST_P( test_setSetEndTeeth );
+    RUN_TEST_P( test_setGetToothAngle );
     RUN_TEST_P( test_setReset );
     RUN_TEST_P( test_setIsEngineRunning );
     RUN_TEST_P( test_setGetStatus );
@@ -0,0 +1,323 @@
+#if defined(NATIVE_VIRTUAL_TIME)
+
+#include <Arduino.h>
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include "engine_plant.h"
+#include "globals.h"
+#include "decoders.h"
+#include "sensors.h"
+#include "timers.h"
+#include "crankMaths.h"
+#include "scheduledIO_inj.h"
+#include "scheduler_fuel_controller.h"
+#include "scheduler_ignition_controller.h"
+#include "src/pins/pinMapping.h"
+#include "../../lib/ArduinoFake/FakeMega.h"
+#include "../../lib/ArduinoFake/SoftwareTimer.h"
+
+// The firmware entry points (speeduino.ino)
+extern void setup(void);
+extern void loop(void);
+
+// ============================ Sensor models ============================
+
+// Linear sensor calibrations: the value at the top of the 10-bit ADC range
+static constexpr uint16_t ADC_MAX = 1023U;
+static constexpr uint16_t MAP_FULL_SCALE = 250U;  // kPa
+static constexpr int16_t TEMP_MIN = -40;          // °C
+static constexpr int16_t TEMP_FULL_SCALE = 200;   // °C
+static constexpr uint8_t AFR_MIN = 100U;          // AFR x10
+static constexpr uint8_t AFR_FULL_SCALE = 100U;   // AFR x10
+static constexpr uint8_t BATTERY_FULL_SCALE = 245U; // Volts x10
+
+static constexpr uint8_t BARO = 100U;             // kPa
+static constexpr uint8_t BATTERY = 140U;          // Volts x10
+static constexpr int8_t AIR_TEMP = 25;            // °C
+static constexpr uint8_t MIN_MAP = 30U;           // kPa, throttle closed
+
+static inline int toADC(int32_t value, int32_t fullScale)
+{
+  return (int)constrain(((value*(int32_t)ADC_MAX) + (fullScale/2))/fullScale, 0, (int32_t)ADC_MAX);
+}
+
+static engine_conditions_t conditions;
+static uint16_t afrReading = AFR_MIN + AFR_FULL_SCALE; // Lean until there is fuel
+
+static uint8_t getMAP(void)
+{
+  if (conditions.rpm==0U) { return BARO; }
+  return MIN_MAP + (uint8_t)(((BARO - MIN_MAP) * (uint16_t)conditions.throttle) / 100U);
+}
+
+static int readSensor(uint8_t pin)
+{
+  if (pin==pinNumbers.pinMAP) { return toADC(getMAP(), MAP_FULL_SCALE); }
+  if (pin==pinNumbers.pinTPS) { return toADC(conditions.throttle, 100); }
+  if (pin==pinNumbers.pinCLT) { return toADC(conditions.coolant - TEMP_MIN, TEMP_FULL_SCALE); }
+  if (pin==pinNumbers.pinIAT) { return toADC(AIR_TEMP - TEMP_MIN, TEMP_FULL_SCALE); }
+  if (pin==pinNumbers.pinO2) { return toADC(afrReading - AFR_MIN, AFR_FULL_SCALE); }
+  if (pin==pinNumbers.pinBat) { return toADC(BATTERY, BATTERY_FULL_SCALE); }
+  return 0;
+}
+
+template <typename axis_t, typename value_t, uint8_t sizeT>
+static void calibrateLinear(table2D<axis_t, value_t, sizeT> &table, uint16_t valueMin, uint16_t valueMax)
+{
+  for (uint8_t index=0U; index<sizeT; ++index)
+  {
+    (axis_t&)table.axis[index] = (axis_t)((ADC_MAX * index) / (sizeT-1U));
+    (value_t&)table.values[index] = (value_t)(valueMin + (((valueMax-valueMin) * index) / (sizeT-1U)));
+  }
+  table.cache.cacheTime = UINT8_MAX;
+}
+
+void engineSimCalibrateSensors(void)
+{
+  // Temperatures are stored offset by 40°C
+  calibrateLinear(cltCalibrationTable, TEMP_MIN + 40, TEMP_MIN + 40 + TEMP_FULL_SCALE);
+  calibrateLinear(iatCalibrationTable, TEMP_MIN + 40, TEMP_MIN + 40 + TEMP_FULL_SCALE);
+  calibrateLinear(o2CalibrationTable, AFR_MIN, AFR_MIN + AFR_FULL_SCALE);
+  configPage2.mapMin = 0;
+  configPage2.mapMax = MAP_FULL_SCALE;
+  configPage2.tpsMin = 0U;
+  configPage2.tpsMax = UINT8_MAX;
+  configPage6.egoType = EGO_TYPE_WIDE;
+}
+
+// ============================ Crank wheel ============================
+
+static uint64_t crankTimeRef;      // Virtual time of the crank position reference
+static double crankAngleRef;       // Continuous crank angle (never wraps) at the reference time
+static uint64_t nextEdge;          // Half tooth count, from tooth #1 on the first revolution
+
+static inline double degreesPerMicro(void)
+{
+  return (conditions.rpm * 360.0) / 60000000.0;
+}
+
+static inline double getCrankAngle(uint64_t time)
+{
+  return crankAngleRef + ((double)(time - crankTimeRef) * degreesPerMicro());
+}
+
+static inline double halfToothAngle(void)
+{
+  return 180.0 / configPage4.triggerTeeth;
+}
+
+// Tooth #1 is at the trigger angle
+static inline double getEdgeAngle(uint64_t edge)
+{
+  return (configPage4.triggerAngle - 360.0) + ((double)edge * halfToothAngle());
+}
+
+static uint64_t getNextEdgeTime(void)
+{
+  if (conditions.rpm==0U) { return UINT64_MAX; }
+  // The next edge may be up to 1µS behind the crank reference, after a speed change
+  return crankTimeRef + (uint64_t)std::max(0.0, ceil((getEdgeAngle(nextEdge) - crankAngleRef) / degreesPerMicro()));
+}
+
+static void fireEdge(void)
+{
+  uint16_t halfTooth = (uint16_t)(nextEdge % (configPage4.triggerTeeth * 2U));
+  bool isRising = (halfTooth % 2U)==0U;
+  bool isMissing = (halfTooth / 2U) >= (uint16_t)(configPage4.triggerTeeth - configPage4.triggerMissingTeeth);
+  ++nextEdge;
+
+  if (!isMissing)
+  {
+    interrupt_t &trigger = currentStatus.decoder.primary;
+    if (isRising) { trigger._pin._pin.setPinHigh(); }
+    else { trigger._pin._pin.setPinLow(); }
+    if (trigger.isTriggered()) { trigger.callback(); }
+  }
+}
+
+static void setCrankSpeed(uint16_t rpm)
+{
+  uint64_t now = virtualMicros();
+  crankAngleRef = getCrankAngle(now);
+  crankTimeRef = now;
+  conditions.rpm = rpm;
+}
+
+// ============================ Outputs ============================
+
+static IgnitionSchedule* const ignitionSchedules[] = {
+  &ignitionSchedule1,
+#if IGN_CHANNELS >= 2
+  &ignitionSchedule2,
+#endif
+#if IGN_CHANNELS >= 3
+  &ignitionSchedule3,
+#endif
+#if IGN_CHANNELS >= 4
+  &ignitionSchedule4,
+#endif
+#if IGN_CHANNELS >= 5
+  &ignitionSchedule5,
+#endif
+#if IGN_CHANNELS >= 6
+  &ignitionSchedule6,
+#endif
+#if IGN_CHANNELS >= 7
+  &ignitionSchedule7,
+#endif
+#if IGN_CHANNELS >= 8
+  &ignitionSchedule8,
+#endif
+};
+
+static uint8_t lastInjectorStatus;
+static uint64_t injectorOpenTime[8];
+static bool isCoilCharging[_countof(ignitionSchedules)];
+static engine_sim_stats_t stats;
+
+// Fuel, in µS of injector open time (excluding the opening time)
+static double cycleFuel;
+static double runFuel;
+static double cycleStartAngle;
+static double runStartAngle;
+
+static inline double getRequiredFuel(double crankDegrees)
+{
+  // Required fuel (configPage2.reqFuel) is per cylinder per cycle, at 100% VE & 100kPa. A cycle is 720°.
+  return (configPage2.reqFuel * 100.0) * (conditions.trueVE / 100.0) * (getMAP() / 100.0)
+        * configPage2.nCylinders * (crankDegrees / 720.0);
+}
+
+static inline uint16_t getAFR(double fuel, double crankDegrees)
+{
+  if (fuel<=0.0) { return AFR_MIN + AFR_FULL_SCALE; }
+  return (uint16_t)lround((configPage2.stoich * getRequiredFuel(crankDegrees)) / fuel);
+}
+
+static void onInjectorClose(uint64_t now, uint8_t injector)
+{
+  uint32_t openTime = (uint32_t)(now - injectorOpenTime[injector]);
+  uint16_t pwError = (uint16_t)abs((int32_t)openTime - (int32_t)fuelSchedule1.pw);
+  stats.maxPwError = std::max(stats.maxPwError, pwError);
+  ++stats.squirts;
+
+  double fuel = std::max(0.0, (double)openTime - (configPage2.injOpen * 100.0));
+  cycleFuel = cycleFuel + fuel;
+  runFuel = runFuel + fuel;
+}
+
+static void onSpark(uint64_t now, const IgnitionSchedule &schedule)
+{
+  // Both the measured & target angles relative to TDC #1, in the firmware's ignition cycle
+  double sparkAngle = fmod(getCrankAngle(now), CRANK_ANGLE_MAX_IGN);
+  double targetAngle = (double)schedule.channelDegrees - currentStatus.advance;
+  double error = fmod(sparkAngle - targetAngle + (CRANK_ANGLE_MAX_IGN * 2.5), CRANK_ANGLE_MAX_IGN) - (CRANK_ANGLE_MAX_IGN / 2.0);
+  int16_t error10 = (int16_t)lround(error * 10.0);
+  if (abs(error10)>abs(stats.maxSparkError)) { stats.maxSparkError = error10; }
+  ++stats.sparks;
+}
+
+static void captureOutputs(void)
+{
+  uint64_t now = virtualMicros();
+
+  uint8_t injectorStatus = (uint8_t)getInjectorStatus();
+  for (uint8_t injector=0U; injector<_countof(injectorOpenTime); ++injector)
+  {
+    bool isOpen = BIT_CHECK(injectorStatus, injector);
+    if (isOpen!=BIT_CHECK(lastInjectorStatus, injector))
+    {
+      if (isOpen) { injectorOpenTime[injector] = now; }
+      else { onInjectorClose(now, injector); }
+    }
+  }
+  lastInjectorStatus = injectorStatus;
+
+  for (uint8_t channel=0U; channel<_countof(ignitionSchedules); ++channel)
+  {
+    bool isCharging = isRunning(*ignitionSchedules[channel]);
+    if (isCoilCharging[channel] && !isCharging) { onSpark(now, *ignitionSchedules[channel]); }
+    isCoilCharging[channel] = isCharging;
+  }
+
+  // The O2 sensor reads the AFR of the last complete engine cycle
+  double crankDegrees = getCrankAngle(now) - cycleStartAngle;
+  if (crankDegrees>=720.0)
+  {
+    afrReading = constrain(getAFR(cycleFuel, crankDegrees), AFR_MIN, AFR_MIN + AFR_FULL_SCALE);
+    cycleFuel = 0.0;
+    cycleStartAngle = getCrankAngle(now);
+  }
+}
+
+// ============================ Simulation ============================
+
+static uint16_t simLoopTime;
+static uint64_t nextMsTick;
+
+// Run the interrupts (timers, 1ms tick, crank edges) in time order, up to the target time
+static void advanceTo(uint64_t target)
+{
+  while (virtualMicros()<target)
+  {
+    uint64_t nextEdgeTime = getNextEdgeTime();
+    uint64_t next = std::min(target, std::min(nextMsTick, nextEdgeTime));
+    while (runNextTimerEvent(next)) { captureOutputs(); }
+    advanceVirtualTime(next - virtualMicros());
+
+    if (next==nextMsTick)
+    {
+      nextMsTick = nextMsTick + 1000U;
+      oneMSInterval();
+    }
+    if (next==nextEdgeTime) { fireEdge(); }
+    captureOutputs();
+  }
+}
+
+void engineSimBegin(uint16_t loopTime)
+{
+  fakeAnalogSource(readSensor);
+  setup();
+
+  simLoopTime = loopTime;
+  conditions = { 0U, 0U, 20, 100U };
+  setCrankSpeed(0U);
+  // The next edge after the current crank position
+  nextEdge = (uint64_t)floor((crankAngleRef - getEdgeAngle(0U)) / halfToothAngle()) + 1U;
+  nextMsTick = virtualMicros() + 1000U;
+  lastInjectorStatus = 0U;
+  for (uint8_t channel=0U; channel<_countof(isCoilCharging); ++channel) { isCoilCharging[channel] = false; }
+  afrReading = AFR_MIN + AFR_FULL_SCALE;
+  cycleFuel = 0.0;
+  cycleStartAngle = getCrankAngle(virtualMicros());
+}
+
+engine_sim_stats_t engineSimRun(const engine_conditions_t &newConditions, uint32_t duration)
+{
+  setCrankSpeed(newConditions.rpm);
+  conditions = newConditions;
+
+  stats = engine_sim_stats_t();
+  runFuel = 0.0;
+  runStartAngle = getCrankAngle(virtualMicros());
+
+  uint64_t hostNanos = 0U;
+  const uint64_t end = virtualMicros() + (duration * 1000ULL);
+  while (virtualMicros()<end)
+  {
+    auto start = std::chrono::steady_clock::now();
+    loop();
+    hostNanos = hostNanos + (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    ++stats.loops;
+    captureOutputs();
+    advanceTo(virtualMicros() + simLoopTime);
+  }
+
+  stats.loopHostNanos = (uint32_t)(hostNanos / std::max(stats.loops, (uint32_t)1U));
+  stats.afr = getAFR(runFuel, getCrankAngle(virtualMicros()) - runStartAngle);
+  return stats;
+}
+
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+
+/**
+ * @file
+ * @brief A simple engine plant model, to run the real firmware loop() closed loop in virtual time.
+ *
+ * The plant:
+ * - holds the crank at a set speed (like an engine dyno) & generates the crank wheel edges for the
+ *   configured trigger pattern. Only the missing tooth wheel (no cam) is supported.
+ * - models the MAP, TPS, CLT, IAT, O2 & battery sensors. The O2 sensor reads the AFR delivered by the
+ *   injectors over the last engine cycle, against the air drawn in by an engine with the set VE.
+ * - captures the injector & coil outputs, measuring the spark angle & pulse width errors.
+ * - drives the 1ms timer interrupt.
+ *
+ * The sensors are calibrated linearly: see engineSimCalibrateSensors().
+ */
+
+#include <stdint.h>
+
+/** @brief The engine operating point */
+struct engine_conditions_t {
+  uint16_t rpm;
+  uint8_t throttle;     ///< %
+  int8_t coolant;       ///< °C
+  uint8_t trueVE;       ///< The volumetric efficiency of the simulated engine, %. Compare with the fuel table.
+};
+
+/** @brief Measurements over a simulation run */
+struct engine_sim_stats_t {
+  uint32_t loops;           ///< Main loop iterations
+  uint32_t loopHostNanos;   ///< Average host CPU time for one main loop, nS
+  uint32_t sparks;
+  int16_t maxSparkError;    ///< Worst spark angle error vs. the firmware advance, 0.1°. Positive is retarded.
+  uint32_t squirts;         ///< Injector pulses
+  uint16_t maxPwError;      ///< Worst injector pulse width error vs. the scheduled pulse width, µS
+  uint16_t afr;             ///< AFR delivered over the run, x10
+};
+
+/**
+ * @brief Set the sensor calibration tables & tune settings that the plant's sensor models assume
+ *
+ * Call after setting the tune, before engineSimBegin()
+ */
+void engineSimCalibrateSensors(void);
+
+/**
+ * @brief Start the firmware (setup()) with the plant attached & the engine stopped
+ *
+ * @param loopTime Simulated MCU time for one main loop, µS
+ */
+void engineSimBegin(uint16_t loopTime);
+
+/**
+ * @brief Run the firmware loop() against the plant
+ *
+ * @param conditions The engine operating point for the run
+ * @param duration Run time, mS
+ * @return Measurements over the run
+ */
+engine_sim_stats_t engineSimRun(const engine_conditions_t &conditions, uint32_t duration);
@@ -0,0 +1,11 @@
+#include "../test_harness_device.h"
+#include "../test_harness_native.h"
+
+void runAllEngineSimTests(void)
+{
+  extern void testEngineSim(void);
+
+  testEngineSim();
+}
+
+TEST_HARNESS(runAllEngineSimTests)
@@ -0,0 +1,152 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "globals.h"
+#include "pages.h"
+#include "decoder_init.h"
+#include "engine_plant.h"
+#include "units.h"
+
+#if defined(NATIVE_VIRTUAL_TIME)
+
+static constexpr uint8_t TUNE_VE = 80U;
+static constexpr int8_t TUNE_ADVANCE = 15;
+
+// Fill an axis with evenly spaced bins
+static void populate_table_axis_linear(table_axis_iterator it, uint8_t bins, table3d_axis_t min, table3d_axis_t max)
+{
+  for (table3d_axis_t bin=0U; !it.at_end(); ++it, ++bin)
+  {
+    *it = (table3d_axis_t)(min + (((max - min) * bin) / (bins - 1U)));
+  }
+}
+
+template <typename table3d_t>
+static void populate_flat_table(table3d_t &table, table3d_value_t value)
+{
+  populate_table_axis_linear(table.axisX.begin(), decltype(table.axisX)::length, 5U, 80U);   // 500-8000 RPM
+  populate_table_axis_linear(table.axisY.begin(), decltype(table.axisY)::length, 10U, 125U); // 20-250kPa
+  fill_table_values(table, value);
+}
+
+// A 4 cylinder, 36-1 crank wheel, semi-sequential & wasted spark with no corrections
+static void setReferenceTune(void)
+{
+  setTuneToEmpty();
+  configPage2.pinMapping = 3;
+  configPage2.nCylinders = 4;
+  configPage2.strokes = FOUR_STROKE;
+  configPage2.injLayout = INJ_SEMISEQUENTIAL;
+  configPage2.nInjectors = 4;
+  configPage2.reqFuel = 80;
+  configPage2.injOpen = 10;
+  configPage2.dutyLim = 90;
+  configPage2.stoich = 147;
+  configPage2.multiplyMAP = MULTIPLY_MAP_MODE_100;
+  configPage2.fuelAlgorithm = LOAD_SOURCE_MAP;
+  configPage2.ignAlgorithm = LOAD_SOURCE_MAP;
+  configPage4.TrigPattern = DECODER_MISSING_TOOTH;
+  configPage4.triggerTeeth = 36;
+  configPage4.triggerMissingTeeth = 1;
+  configPage4.triggerAngle = 0;
+  configPage4.sparkMode = IGN_MODE_WASTED;
+  configPage4.dwellRun = 30;
+  configPage4.dwellCrank = 40;
+  configPage4.sparkDur = 10;
+  configPage4.crankRPM = 40;
+  configPage4.floodClear = 180;
+
+  populate_flat_table(fuelTable, TUNE_VE);
+  populate_flat_table(ignitionTable, IGNITION_ADVANCE_LARGE.toRaw(TUNE_ADVANCE));
+  memset(configPage2.wueValues, 100, sizeof(configPage2.wueValues));
+  memset(configPage10.crankingEnrichValues, CRANKING_ENRICHMENT.toRaw(100U), sizeof(configPage10.crankingEnrichValues));
+  memset(configPage6.injVoltageCorrectionValues, 100, sizeof(configPage6.injVoltageCorrectionValues));
+  memset(configPage4.dwellCorrectionValues, 100, sizeof(configPage4.dwellCorrectionValues));
+  memset(configPage6.airDenRates, 100, sizeof(configPage6.airDenRates));
+  memset(configPage4.baroFuelValues, 100, sizeof(configPage4.baroFuelValues));
+  memset(configPage4.cltAdvValues, IGNITION_ADVANCE_SMALL.toRaw(0), sizeof(configPage4.cltAdvValues));
+  engineSimCalibrateSensors();
+}
+
+// Simulated MCU time for one main loop
+static constexpr uint16_t LOOP_TIME = 250U;
+static constexpr int8_t WARM = 80;
+static constexpr uint8_t STOICH = 147U;
+
+static void startEngine(void)
+{
+  setReferenceTune();
+  engineSimBegin(LOOP_TIME);
+  (void)engineSimRun({ 250U, 0U, WARM, TUNE_VE }, 1000U);
+}
+
+static void assert_running_at(uint16_t rpm)
+{
+  TEST_ASSERT_TRUE(currentStatus.decoder.getStatus().syncStatus==SyncStatus::Full);
+  TEST_ASSERT_UINT16_WITHIN(rpm/100U, rpm, currentStatus.RPM);
+}
+
+static void test_engine_sim_cranking(void)
+{
+  setReferenceTune();
+  engineSimBegin(LOOP_TIME);
+  engine_sim_stats_t stats = engineSimRun({ 250U, 0U, WARM, TUNE_VE }, 2000U);
+
+  assert_running_at(250U);
+  TEST_ASSERT_TRUE(currentStatus.rotationStatus==EngineRotationStatus::Cranking);
+  TEST_ASSERT_GREATER_THAN_UINT32(0U, stats.sparks);
+  TEST_ASSERT_GREATER_THAN_UINT32(0U, stats.squirts);
+
+  (void)engineSimRun({ 1000U, 0U, WARM, TUNE_VE }, 500U);
+  assert_running_at(1000U);
+  TEST_ASSERT_TRUE(currentStatus.rotationStatus==EngineRotationStatus::Running);
+}
+
+static void test_engine_sim_rpm_sweep(void)
+{
+  startEngine();
+
+  for (uint16_t rpm=1000U; rpm<=7000U; rpm = rpm + 1000U)
+  {
+    // Let the decoder & sensors settle after the speed change
+    (void)engineSimRun({ rpm, 30U, WARM, TUNE_VE }, 500U);
+    engine_sim_stats_t stats = engineSimRun({ rpm, 30U, WARM, TUNE_VE }, 1000U);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%" PRIu16 "RPM: %" PRIu32 " loops, %" PRIu32 "nS per loop, spark error %" PRId16 " (0.1 deg), PW error %" PRIu16 "uS, AFR %" PRIu16 " (x10)",
+              rpm, stats.loops, stats.loopHostNanos, stats.maxSparkError, stats.maxPwError, stats.afr);
+    TEST_MESSAGE(msg);
+
+    assert_running_at(rpm);
+    // Wasted spark: 2 sparks per revolution
+    TEST_ASSERT_UINT32_WITHIN(1U, (rpm*2U)/60U, stats.sparks);
+    TEST_ASSERT_INT16_WITHIN(10, 0, stats.maxSparkError);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(1U, stats.maxPwError);
+    TEST_ASSERT_UINT16_WITHIN(3U, STOICH, stats.afr);
+  }
+}
+
+static void test_engine_sim_ve_error_shows_in_afr(void)
+{
+  startEngine();
+
+  // The engine breathes 10% better than the tune expects: it runs lean by the same ratio
+  static constexpr uint8_t TRUE_VE = TUNE_VE + (TUNE_VE/10U);
+  (void)engineSimRun({ 3000U, 30U, WARM, TRUE_VE }, 500U);
+  engine_sim_stats_t stats = engineSimRun({ 3000U, 30U, WARM, TRUE_VE }, 1000U);
+
+  TEST_ASSERT_UINT16_WITHIN(3U, (STOICH*TRUE_VE)/TUNE_VE, stats.afr);
+}
+
+#endif
+
+void testEngineSim(void)
+{
+#if defined(NATIVE_VIRTUAL_TIME)
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_engine_sim_cranking);
+    RUN_TEST_P(test_engine_sim_rpm_sweep);
+    RUN_TEST_P(test_engine_sim_ve_error_shows_in_afr);
+  }
+#endif
+}
@@ -1739,9 +1739,60 @@ static void test_corrections_correctionsFuel_clip_limit(void) {
   TEST_ASSERT_EQUAL(1500U, correctionsFuel());
 }
 
+static void test_corrections_correctionsFuel_sensor_rate(void) {
+  initialiseCorrections();
+  populate_2dtable(&IATDensityCorrectionTable, (uint8_t)110, (uint8_t)100);
+  populate_2dtable(&baroFuelTable, (uint8_t)100, (uint8_t)100);
+  currentStatus.IAT = temperatureRemoveOffset(100);
+  currentStatus.LOOP_TIMER = 0;
+  BIT_SET(currentStatus.LOOP_TIMER, IAT_READ_TIMER_BIT);
+  (void)correctionsFuel();
+  TEST_ASSERT_EQUAL(110, currentStatus.iatCorrection);
+
+  // Sensor not read, so the table change should be ignored
+  populate_2dtable(&IATDensityCorrectionTable, (uint8_t)120, (uint8_t)100);
+  currentStatus.LOOP_TIMER = 0;
+  (void)correctionsFuel();
+  TEST_ASSERT_EQUAL(110, currentStatus.iatCorrection);
+
+  // Sensor read, so the change should be picked up
+  BIT_SET(currentStatus.LOOP_TIMER, IAT_READ_TIMER_BIT);
+  (void)correctionsFuel();
+  TEST_ASSERT_EQUAL(120, currentStatus.iatCorrection);
+}
+
+#include "../timer.hpp"
+
+static void test_corrections_correctionsFuel_perf(void) {
+  test_corrections_correctionsFuel_sensor_rate();
+  
+  constexpr uint16_t iters = 1000;
+  // Every sensor read on every loop (worst case: the sensor rate corrections are always recomputed)
+  auto allSensorsRead = [] (uint8_t, uint32_t &checkSum) { 
+    currentStatus.LOOP_TIMER = 0U;
+    BIT_SET(currentStatus.LOOP_TIMER, CLT_READ_TIMER_BIT);
+    BIT_SET(currentStatus.LOOP_TIMER, IAT_READ_TIMER_BIT);
+    BIT_SET(currentStatus.LOOP_TIMER, BARO_READ_TIMER_BIT);
+    BIT_SET(currentStatus.LOOP_TIMER, FLEX_READ_TIMER_BIT);
+    checkSum += correctionsFuel();
+  };
+  // No sensors read (the typical loop: the cached sensor rate corrections are reused)
+  auto noSensorsRead = [] (uint8_t, uint32_t &checkSum) { 
+    currentStatus.LOOP_TIMER = 0U;
+    checkSum += correctionsFuel();
+  };
+  auto comparison = compare_executiontime<uint8_t, uint32_t>(iters, 0, 10, 1, allSensorsRead, noSensorsRead);
+
+  // Both loops should produce the same result, since the inputs aren't changing
+  TEST_ASSERT_EQUAL_UINT32(comparison.timeA.result, comparison.timeB.result);
+  TEST_ASSERT_LESS_THAN(comparison.timeA.durationMicros, comparison.timeB.durationMicros);
+}
+
 static void test_corrections_correctionsFuel(void) {
   RUN_TEST_P(test_corrections_correctionsFuel_ae_modes);
   RUN_TEST_P(test_corrections_correctionsFuel_clip_limit);
+  RUN_TEST_P(test_corrections_correctionsFuel_sensor_rate);
+  RUN_TEST_P(test_corrections_correctionsFuel_perf);
 }
 
 void testCorrections()
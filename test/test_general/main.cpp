@@ -5,9 +5,13 @@ void runAllTests(void)
 {
     extern void testPinMapping(void);
     extern void testResetControl(void);
+    extern void testPortPinGroup(void);
+    extern void testAtomicProfile(void);
 
     testPinMapping();
     testResetControl();
+    testPortPinGroup();
+    testAtomicProfile();
 }
 
 TEST_HARNESS(runAllTests)
@@ -0,0 +1,99 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "atomic_profile.h"
+#include "logger.h"
+
+#if defined(ATOMIC_PROFILING)
+
+static void profiledSection(atomicSite_t site, uint16_t duration)
+{
+  ATOMIC_PROFILED(site) {
+    delayMicroseconds(duration);
+  }
+}
+
+static uint8_t profiledSectionWithReturn(uint16_t duration)
+{
+  ATOMIC_PROFILED(ATOMIC_SITE_DECODER) {
+    delayMicroseconds(duration);
+    return 1U;
+  }
+  return 0U;
+}
+
+static void test_atomic_profile_reset(void)
+{
+  profiledSection(ATOMIC_SITE_SENSORS, 50U);
+  resetAtomicProfile();
+
+  TEST_ASSERT_EQUAL_UINT16(0U, getAtomicProfile().maxDuration);
+  TEST_ASSERT_EQUAL_UINT8(ATOMIC_SITE_NONE, getAtomicProfile().maxSite);
+}
+
+static void test_atomic_profile_records_longest(void)
+{
+  resetAtomicProfile();
+
+  profiledSection(ATOMIC_SITE_SENSORS, 500U);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT16(500U, getAtomicProfile().maxDuration);
+  TEST_ASSERT_EQUAL_UINT8(ATOMIC_SITE_SENSORS, getAtomicProfile().maxSite);
+
+  // A shorter section elsewhere doesn't replace it
+  profiledSection(ATOMIC_SITE_AUX_PWM, 10U);
+  TEST_ASSERT_EQUAL_UINT8(ATOMIC_SITE_SENSORS, getAtomicProfile().maxSite);
+
+  // A longer one does
+  profiledSection(ATOMIC_SITE_STATUS, 2000U);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT16(2000U, getAtomicProfile().maxDuration);
+  TEST_ASSERT_EQUAL_UINT8(ATOMIC_SITE_STATUS, getAtomicProfile().maxSite);
+}
+
+static void test_atomic_profile_return_from_section(void)
+{
+  resetAtomicProfile();
+
+  TEST_ASSERT_EQUAL_UINT8(1U, profiledSectionWithReturn(500U));
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT16(500U, getAtomicProfile().maxDuration);
+  TEST_ASSERT_EQUAL_UINT8(ATOMIC_SITE_DECODER, getAtomicProfile().maxSite);
+}
+
+static void test_atomic_profile_saturates(void)
+{
+  resetAtomicProfile();
+
+  ATOMIC() {
+    recordAtomicSection(ATOMIC_SITE_SCHEDULE, 100000UL);
+  }
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, getAtomicProfile().maxDuration);
+}
+
+static void test_atomic_profile_live_data(void)
+{
+  resetAtomicProfile();
+  ATOMIC() {
+    recordAtomicSection(ATOMIC_SITE_OVERDWELL, 0x1234U);
+  }
+
+  TEST_ASSERT_TRUE(is2ByteEntry(140U));
+  TEST_ASSERT_EQUAL_UINT8(0x34U, getTSLogEntry(140U));
+  TEST_ASSERT_EQUAL_UINT8(0x12U, getTSLogEntry(141U));
+  TEST_ASSERT_EQUAL_UINT8(ATOMIC_SITE_OVERDWELL, getTSLogEntry(142U));
+  TEST_ASSERT_EQUAL_INT16(0x1234, getReadableLogEntry(100U));
+  TEST_ASSERT_EQUAL_INT16(ATOMIC_SITE_OVERDWELL, getReadableLogEntry(101U));
+}
+
+#endif
+
+void testAtomicProfile(void)
+{
+#if defined(ATOMIC_PROFILING)
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_atomic_profile_reset);
+    RUN_TEST_P(test_atomic_profile_records_longest);
+    RUN_TEST_P(test_atomic_profile_return_from_section);
+    RUN_TEST_P(test_atomic_profile_saturates);
+    RUN_TEST_P(test_atomic_profile_live_data);
+  }
+#endif
+}
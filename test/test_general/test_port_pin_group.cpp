@@ -0,0 +1,63 @@
+#include "../test_utils.h"
+#include "src/pins/port_pin_group.h"
+
+static void test_port_pin_group_merges_same_port(void)
+{
+    port_pin_t pinA(8U, OUTPUT);
+    port_pin_t pinB(9U, OUTPUT);
+    TEST_ASSERT_EQUAL(digitalPinToPort(8U), digitalPinToPort(9U));
+
+    port_pin_group_t<2U> group;
+    group.add(pinA);
+    group.add(pinB);
+    TEST_ASSERT_EQUAL_UINT8(1U, group.portCount());
+
+    group.setPinsHigh();
+    TEST_ASSERT_TRUE(pinA.isPinHigh());
+    TEST_ASSERT_TRUE(pinB.isPinHigh());
+    group.setPinsLow();
+    TEST_ASSERT_FALSE(pinA.isPinHigh());
+    TEST_ASSERT_FALSE(pinB.isPinHigh());
+}
+
+static void test_port_pin_group_multiple_ports(void)
+{
+    port_pin_t pinA(8U, OUTPUT);
+    port_pin_t pinB(40U, OUTPUT);
+    port_pin_t pinC(9U, OUTPUT);
+    TEST_ASSERT_NOT_EQUAL(digitalPinToPort(8U), digitalPinToPort(40U));
+
+    port_pin_group_t<3U> group;
+    group.add(pinA);
+    group.add(pinB);
+    group.add(pinC);
+    TEST_ASSERT_EQUAL_UINT8(2U, group.portCount());
+
+    group.setPinsHigh();
+    TEST_ASSERT_TRUE(pinA.isPinHigh());
+    TEST_ASSERT_TRUE(pinB.isPinHigh());
+    TEST_ASSERT_TRUE(pinC.isPinHigh());
+}
+
+static void test_port_pin_group_ignores_unassigned(void)
+{
+    port_pin_t pinA(8U, OUTPUT);
+    port_pin_t unassigned;
+
+    port_pin_group_t<2U> group;
+    group.add(pinA);
+    group.add(unassigned);
+    TEST_ASSERT_EQUAL_UINT8(1U, group.portCount());
+
+    group.clear();
+    TEST_ASSERT_EQUAL_UINT8(0U, group.portCount());
+}
+
+void testPortPinGroup(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_port_pin_group_merges_same_port);
+        RUN_TEST_P(test_port_pin_group_multiple_ports);
+        RUN_TEST_P(test_port_pin_group_ignores_unassigned);
+    }
+}
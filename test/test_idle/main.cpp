@@ -7,10 +7,12 @@ void runAllTests(void)
     extern void testInitialiseIdle(void);
     extern void testDisableIdle(void);
     extern void testIdleControl(void);
+    extern void testIdleInterrupt(void);
 
     testInitialiseIdle();
     testDisableIdle();
     testIdleControl();
+    testIdleInterrupt();
 }
 
 TEST_HARNESS(runAllTests)
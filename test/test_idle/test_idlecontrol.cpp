@@ -68,6 +68,24 @@ static void test_idleControl_step_cl_reachesHelper(void)
   TEST_ASSERT_EQUAL(0U, currentStatus.idleLoad);
 }
 
+static void test_idleControl_pwm_cl_computes_every_call(void)
+{
+  // PWM idle is a fixed rate task, so the PID computes on every call no matter
+  // how little time has passed. The sentinel is only replaced when it computes.
+  prepare_idle(IAC_ALGORITHM_PWM_CL);
+  configPage6.idleFreq = 100U;
+  currentStatus.rotationStatus = EngineRotationStatus::Running;
+  currentStatus.setRpm(700U);
+  initialiseIdle(false);
+
+  for (uint8_t call = 0U; call < 3U; call++)
+  {
+    currentStatus.idleLoad = 0xFFU;
+    idleControl();
+    TEST_ASSERT_NOT_EQUAL(0xFFU, currentStatus.idleLoad);
+  }
+}
+
 void testIdleControl(void)
 {
   SET_UNITY_FILENAME()
@@ -75,5 +93,6 @@ void testIdleControl(void)
     RUN_TEST(test_idleControl_step_ol_clamp_directResolution);
     RUN_TEST(test_idleControl_step_ol_clamp_halfResolution);
     RUN_TEST(test_idleControl_step_cl_reachesHelper);
+    RUN_TEST(test_idleControl_pwm_cl_computes_every_call);
   }
 }
@@ -0,0 +1,50 @@
+#include "../test_utils.h"
+#include "idle.h"
+#include "prepare_idle.h"
+#include "softPwm.h"
+#include "src/pins/fastOutputPin.h"
+
+extern volatile bool idle_pwm_state;
+extern uint16_t idle_pwm_max_count;
+extern uint32_t idle_pwm_target_value;
+extern fastOutputPin_t idle_pin;
+extern bool isIdlePwmActiveLow(const config6 &page6);
+
+static void assert_hardware_pwm_matches_interrupt(uint8_t iacPWMdir)
+{
+  prepare_idle(IAC_ALGORITHM_PWM_OL);
+  configPage6.iacPWMdir = iacPWMdir;
+  initialiseIdle(true);
+  idle_pwm_max_count = 1000U;
+  idle_pwm_target_value = 250U;
+
+  // One period of the interrupt: the duty, then the rest of the period
+  idle_pwm_state = false;
+  idleInterrupt();
+  uint32_t highTicks = idle_pin._pin.isPinHigh() ? 250U : 0U;
+  idleInterrupt();
+  highTicks += idle_pin._pin.isPinHigh() ? 750U : 0U;
+
+  // Hardware PWM is high for the same part of the period
+  constexpr uint8_t RESOLUTION = 15U;
+  TEST_ASSERT_EQUAL_UINT32((highTicks << RESOLUTION) / 1000U, getAuxPwmHardwareDuty(250U, 1000U, RESOLUTION, isIdlePwmActiveLow(configPage6)));
+}
+
+static void test_idle_hardware_pwm_matches_interrupt_normal(void)
+{
+  assert_hardware_pwm_matches_interrupt(0U);
+}
+
+static void test_idle_hardware_pwm_matches_interrupt_reversed(void)
+{
+  assert_hardware_pwm_matches_interrupt(1U);
+}
+
+void testIdleInterrupt(void)
+{
+  SET_UNITY_FILENAME()
+  {
+    RUN_TEST_P(test_idle_hardware_pwm_matches_interrupt_normal);
+    RUN_TEST_P(test_idle_hardware_pwm_matches_interrupt_reversed);
+  }
+}
@@ -30,11 +30,13 @@ void runAllInitTests(void)
     extern void testFuelScheduleInit(void);
     extern void testIgnitionScheduleInit(void);
     extern void testPinMapping(void);
+    extern void testStagedInit(void);
 
     testInitialisation();
     testFuelScheduleInit();
     testIgnitionScheduleInit();
     testPinMapping();
+    testStagedInit();
 }
 
 TEST_HARNESS(runAllInitTests)
@@ -0,0 +1,132 @@
+#include <unity.h>
+#include "globals.h"
+#include "init.h"
+#include "storage.h"
+#include "updates.h"
+#include "pages.h"
+#include "src/pins/pinMapping.h"
+#include "../test_utils.h"
+
+extern void prepareForInitialiseAll(uint8_t boardId);
+extern bool isUnitTestTuneLoaded;
+
+// A RAM backed EEPROM holding the tune
+static byte tuneStorage[4096];
+static byte tuneStorageRead(uint16_t address) { return tuneStorage[address]; }
+static void tuneStorageWrite(uint16_t address, byte value) { tuneStorage[address] = value; }
+static uint16_t tuneStorageLength(void) { return sizeof(tuneStorage); }
+static uint16_t tuneStorageBlockSize(const statuses&) { return sizeof(tuneStorage); }
+
+// A value in each of the deferred pages, plus the CAN bus page (which isn't deferred)
+static constexpr uint8_t CANBUS_PAGE_MARKER = 101U;
+static constexpr uint16_t PROGOUTS_PAGE_MARKER = 102U;
+static constexpr uint8_t BOOSTVVT2_PAGE_MARKER = 103U;
+// Selected by a deferred page
+static constexpr uint8_t AIRCON_COMP_PIN = 20U;
+
+static void assert_deferred_pages(bool isLoaded)
+{
+  TEST_ASSERT_EQUAL_UINT8(CANBUS_PAGE_MARKER, configPage9.egoMAPMax);
+  TEST_ASSERT_EQUAL_UINT16(isLoaded ? PROGOUTS_PAGE_MARKER : 0U, configPage13.candID[0]);
+  TEST_ASSERT_EQUAL_UINT8(isLoaded ? BOOSTVVT2_PAGE_MARKER : 0U, configPage15.boostDCWhenDisabled);
+  TEST_ASSERT_EQUAL_UINT8(isLoaded ? pinTranslate(AIRCON_COMP_PIN) : NOT_A_PIN, pinNumbers.pinAirConComp);
+}
+
+// Save the tune to storage & clear it from memory, so the initialisation has to load it
+static void prepareStoredTune(uint8_t boardId)
+{
+  prepareForInitialiseAll(boardId);
+  configPage9.egoMAPMax = CANBUS_PAGE_MARKER;
+  configPage13.candID[0] = PROGOUTS_PAGE_MARKER;
+  configPage15.boostDCWhenDisabled = BOOSTVVT2_PAGE_MARKER;
+  configPage15.airConCompPin = AIRCON_COMP_PIN;
+
+  memset(tuneStorage, 0, sizeof(tuneStorage));
+  setStorageAPI({ .read = tuneStorageRead, .write = tuneStorageWrite, .length = tuneStorageLength, .getMaxWriteBlockSize = tuneStorageBlockSize });
+  saveAllPages();
+  saveAllCalibrationTables();
+  saveEEPROMVersion(27U);
+  TEST_ASSERT_FALSE(isUpdateRequired());
+
+  setTuneToEmpty();
+  isUnitTestTuneLoaded = true;
+}
+
+static void test_staged_init_engine_ready_before_deferred(void)
+{
+  prepareStoredTune(9);
+  initialiseCritical();
+
+  // The engine can be started...
+  TEST_ASSERT_FALSE(currentStatus.initialisationComplete);
+  TEST_ASSERT_EQUAL_UINT8(9U, configPage2.pinMapping);
+  TEST_ASSERT_TRUE(currentStatus.decoder.primary.isValid());
+  TEST_ASSERT_GREATER_THAN_UINT8(0U, currentStatus.maxIgnOutputs);
+  // ...before the pages it doesn't need are loaded
+  assert_deferred_pages(false);
+
+  // The rest of the initialisation is spread across several main loops, starting
+  // with the deferred pages
+  TEST_ASSERT_FALSE(initialiseDeferredStage());
+  assert_deferred_pages(true);
+  uint8_t stages = 2U;
+  while (!initialiseDeferredStage())
+  {
+    TEST_ASSERT_FALSE(currentStatus.initialisationComplete);
+    ++stages;
+  }
+  TEST_ASSERT_EQUAL_UINT8(3U, stages);
+  TEST_ASSERT_TRUE(currentStatus.initialisationComplete);
+
+  // Further calls do nothing
+  TEST_ASSERT_TRUE(initialiseDeferredStage());
+  TEST_ASSERT_TRUE(currentStatus.initialisationComplete);
+
+  isUnitTestTuneLoaded = false;
+}
+
+static void test_staged_init_update_loads_all_pages(void)
+{
+  // Updates can touch any page, so every page is loaded up front
+  prepareStoredTune(9);
+  saveEEPROMVersion(26U);
+  initialiseCritical();
+  assert_deferred_pages(true);
+
+  while (!initialiseDeferredStage()) { }
+  TEST_ASSERT_FALSE(isUpdateRequired());
+
+  isUnitTestTuneLoaded = false;
+}
+
+static void test_staged_init_time_to_first_spark(void)
+{
+  prepareStoredTune(3);
+
+  // Time to first spark is the time until the trigger is attached: the first
+  // tooth can then be decoded & the ignition scheduled. Both times include loading
+  // the pages they need.
+  uint32_t start = micros();
+  initialiseCritical();
+  uint32_t firstSparkTime = micros() - start;
+  TEST_ASSERT_TRUE(currentStatus.decoder.primary.isValid());
+  assert_deferred_pages(false);
+
+  while (!initialiseDeferredStage()) { }
+  uint32_t completeTime = micros() - start;
+  isUnitTestTuneLoaded = false;
+
+  char szMsg[64];
+  snprintf(szMsg, _countof(szMsg)-1, "First spark %" PRIu32 "us, complete %" PRIu32 "us", firstSparkTime, completeTime);
+  TEST_MESSAGE(szMsg);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(completeTime, firstSparkTime);
+}
+
+void testStagedInit(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_staged_init_engine_ready_before_deferred);
+    RUN_TEST_P(test_staged_init_update_loads_all_pages);
+    RUN_TEST_P(test_staged_init_time_to_first_spark);
+  }
+}
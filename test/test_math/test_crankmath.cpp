@@ -2,6 +2,17 @@
 #include "../test_utils.h"
 
 extern uint16_t injectorLimits(uint16_t angle);
+extern uint32_t angleToFixedTime(uint16_t angle) noexcept;
+extern uint32_t fixedTimeToTicks(uint32_t fixedTime, uint8_t ticksPerUs) noexcept;
+
+// As board_stm32_official.h with SCHEDULE_TIMERS_32BIT
+static constexpr uint8_t STM32_TICKS_PER_US = 4U;
+
+// The UQ24.8 conversion, without any risk of overflow
+static uint32_t expectedTicks(uint32_t fixedTime, uint8_t ticksPerUs)
+{
+    return (uint32_t)((((uint64_t)fixedTime * ticksPerUs) + 128U) >> 8U);
+}
 
 static void test_ignitionLimits_within_range(void)
 {
@@ -35,6 +46,34 @@ static void test_angleToTimerTicks_matches_uS_conversion(void)
     TEST_ASSERT_EQUAL(expectedTicks, angleToTimerTicks(angle));
 }
 
+static void test_fixedTimeToTicks_keeps_fraction(void)
+{
+    // 1000uS per revolution: 2.78uS per degree
+    setAngleConverterRevolutionTime(1000UL);
+
+    const uint32_t fixedTime = angleToFixedTime(1U);
+    TEST_ASSERT_EQUAL_UINT32(expectedTicks(fixedTime, STM32_TICKS_PER_US), fixedTimeToTicks(fixedTime, STM32_TICKS_PER_US));
+    // Converting the rounded uS would give 12 ticks
+    TEST_ASSERT_EQUAL_UINT32(3U, angleToTime(1U));
+    TEST_ASSERT_EQUAL_UINT32(11U, fixedTimeToTicks(fixedTime, STM32_TICKS_PER_US));
+}
+
+static void test_fixedTimeToTicks_max_angle_no_overflow(void)
+{
+    // The slowest the crank math supports, over a full cycle
+    setAngleConverterRevolutionTime(MAX_REVOLUTION_TIME);
+
+    const uint32_t fixedTime = angleToFixedTime(720U);
+    TEST_ASSERT_TRUE(((uint64_t)fixedTime * STM32_TICKS_PER_US) <= UINT32_MAX);
+    // The bound is ~3x10^9, so 5 ticks per uS is the limit
+    TEST_ASSERT_TRUE(((uint64_t)fixedTime * 5U) <= UINT32_MAX);
+    TEST_ASSERT_FALSE(((uint64_t)fixedTime * 6U) <= UINT32_MAX);
+
+    const uint32_t ticks = fixedTimeToTicks(fixedTime, STM32_TICKS_PER_US);
+    TEST_ASSERT_EQUAL_UINT32(expectedTicks(fixedTime, STM32_TICKS_PER_US), ticks);
+    TEST_ASSERT_UINT32_WITHIN(720U * STM32_TICKS_PER_US, MAX_REVOLUTION_TIME * 2UL * STM32_TICKS_PER_US, ticks);
+}
+
 static void test_timeToAngle_inverse_roundtrip(void)
 {
     setAngleConverterRevolutionTime(MICROS_PER_MIN/4000);
@@ -63,6 +102,8 @@ void testCrankMath()
       RUN_TEST_P(test_ignitionLimits_within_range);
       RUN_TEST_P(test_injectorLimits_uint16_wrap);
       RUN_TEST_P(test_angleToTimerTicks_matches_uS_conversion);
+      RUN_TEST_P(test_fixedTimeToTicks_keeps_fraction);
+      RUN_TEST_P(test_fixedTimeToTicks_max_angle_no_overflow);
       RUN_TEST_P(test_timeToAngle_inverse_roundtrip);
       RUN_TEST_P(test_setAngleConverterRevolutionTime_revolution_values);
   }
@@ -0,0 +1,164 @@
+#include <unity.h>
+#include "maths.h"
+#include "fixed_point.h"
+#include "../timer.hpp"
+#include "../test_utils.h"
+
+static void test_fixed_point_conversion(void)
+{
+  TEST_ASSERT_EQUAL_UINT16(0x0100U, UQ8_8_t::fromInteger(1U).raw());
+  TEST_ASSERT_EQUAL_UINT16(0xFF00U, UQ8_8_t::fromInteger(255U).raw());
+  TEST_ASSERT_EQUAL_UINT16(3U, UQ8_8_t::fromRaw(0x0380U).toInteger());
+  TEST_ASSERT_EQUAL_UINT16(4U, UQ8_8_t::fromRaw(0x0380U).toIntegerRounded());
+  TEST_ASSERT_EQUAL_UINT16(3U, UQ8_8_t::fromRaw(0x037FU).toIntegerRounded());
+
+  TEST_ASSERT_EQUAL_UINT32(UINT32_C(0x00010000), UQ16_16_t::fromInteger(1U).raw());
+  TEST_ASSERT_EQUAL_UINT32(UINT16_MAX, UQ16_16_t::fromInteger(UINT16_MAX).toInteger());
+  TEST_ASSERT_EQUAL_UINT32(UINT16_MAX, UQ16_16_t::max().toInteger());
+  // Rounding 65535.99998 overflows 16 integer bits, but not the promoted type
+  TEST_ASSERT_EQUAL_UINT32(UINT32_C(0x10000), UQ16_16_t::max().toIntegerRounded());
+
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, Q1_15_t::fromInteger(-1).raw());
+  TEST_ASSERT_EQUAL_INT16(-1, Q1_15_t::min().toInteger());
+  TEST_ASSERT_EQUAL_INT16(0, Q1_15_t::max().toInteger());
+  TEST_ASSERT_EQUAL_INT16(1, Q1_15_t::max().toIntegerRounded());
+}
+
+static void test_fixed_point_add_sub_saturate(void)
+{
+  // Normal range
+  TEST_ASSERT_EQUAL_UINT16(0x0380U, (UQ8_8_t::fromInteger(2U) + UQ8_8_t::fromRaw(0x0180U)).raw());
+  TEST_ASSERT_EQUAL_UINT16(0x0080U, (UQ8_8_t::fromInteger(2U) - UQ8_8_t::fromRaw(0x0180U)).raw());
+  TEST_ASSERT_EQUAL_INT16(-0x2000, (Q1_15_t::fromRaw(0x2000) - Q1_15_t::fromRaw(0x4000)).raw());
+
+  // Saturate
+  TEST_ASSERT_TRUE(UQ8_8_t::max()==(UQ8_8_t::fromInteger(200U) + UQ8_8_t::fromInteger(100U)));
+  TEST_ASSERT_TRUE(UQ8_8_t::min()==(UQ8_8_t::fromInteger(100U) - UQ8_8_t::fromInteger(200U)));
+  TEST_ASSERT_TRUE(UQ16_16_t::max()==(UQ16_16_t::fromInteger(60000U) + UQ16_16_t::fromInteger(6000U)));
+  TEST_ASSERT_TRUE(Q1_15_t::max()==(Q1_15_t::fromRaw(0x6000) + Q1_15_t::fromRaw(0x6000)));
+  TEST_ASSERT_TRUE(Q1_15_t::min()==(Q1_15_t::fromRaw(-0x6000) + Q1_15_t::fromRaw(-0x6000)));
+  TEST_ASSERT_TRUE(Q1_15_t::min()==(Q1_15_t::fromRaw(-0x6000) - Q1_15_t::fromRaw(0x6000)));
+  TEST_ASSERT_TRUE(Q1_15_t::max()==(Q1_15_t::fromRaw(0x6000) - Q1_15_t::fromRaw(-0x6000)));
+}
+
+static void test_fixed_point_mul(void)
+{
+  TEST_ASSERT_EQUAL_UINT16(6U, (UQ8_8_t::fromInteger(2U) * UQ8_8_t::fromInteger(3U)).toInteger());
+  TEST_ASSERT_EQUAL_UINT16(0x0040U, (UQ8_8_t::fromRaw(0x0080U) * UQ8_8_t::fromRaw(0x0080U)).raw());
+  // 1.5 * 1.5 == 2.25
+  TEST_ASSERT_EQUAL_UINT32(UINT32_C(0x00024000), (UQ16_16_t::fromRaw(UINT32_C(0x00018000)) * UQ16_16_t::fromRaw(UINT32_C(0x00018000))).raw());
+  // 0.5 * -0.5 == -0.25
+  TEST_ASSERT_EQUAL_INT16(-0x2000, (Q1_15_t::fromRaw(0x4000) * Q1_15_t::fromRaw(-0x4000)).raw());
+
+  // Saturate
+  TEST_ASSERT_TRUE(UQ8_8_t::max()==(UQ8_8_t::fromInteger(16U) * UQ8_8_t::fromInteger(16U)));
+  TEST_ASSERT_TRUE(UQ16_16_t::max()==(UQ16_16_t::fromInteger(256U) * UQ16_16_t::fromInteger(256U)));
+  // -1 * -1 == 1, which Q1.15 cannot represent
+  TEST_ASSERT_TRUE(Q1_15_t::max()==(Q1_15_t::min() * Q1_15_t::min()));
+}
+
+static void test_fixed_point_mulUnit(void)
+{
+  // mulUnit() must give identical results to the promoted multiply over the entire [0, 1] range
+  for (uint16_t a=0U; a<=UQ8_8_t::RAW_ONE; ++a) {
+    for (uint16_t b=0U; b<=UQ8_8_t::RAW_ONE; ++b) {
+      UQ8_8_t fpA = UQ8_8_t::fromRaw(a);
+      UQ8_8_t fpB = UQ8_8_t::fromRaw(b);
+      if ((fpA * fpB)!=UQ8_8_t::mulUnit(fpA, fpB)) {
+        TEST_FAIL_MESSAGE("mulUnit() mismatch");
+      }
+    }
+  }
+}
+
+static void test_fixed_point_scale(void)
+{
+  TEST_ASSERT_EQUAL_UINT32(150U, UQ8_8_t::fromRaw(0x0080U).scale(UINT32_C(300)));
+  TEST_ASSERT_EQUAL_UINT32(450U, UQ8_8_t::fromRaw(0x0180U).scale(UINT32_C(300)));
+  // 0.5 rounds up
+  TEST_ASSERT_EQUAL_UINT32(2U, UQ8_8_t::fromRaw(0x0080U).scale(UINT32_C(3)));
+  TEST_ASSERT_EQUAL_UINT16(50U, percentToFixed<8U>(50U).scale(UINT32_C(100)));
+  TEST_ASSERT_EQUAL_UINT16(20000U, percentToFixed<5U>(2000U).scale(UINT32_C(1000)));
+}
+
+// The pre fixed point implementation of percentageApprox(), for parity testing
+template <uint8_t bitsPrecision>
+static inline uint32_t legacyPercentageApprox(uint16_t percent, uint32_t value) {
+  uint16_t iPercent = div100((uint16_t)(percent << bitsPrecision));
+  return rshift_round<bitsPrecision>(value * (uint32_t)iPercent);
+}
+
+static void test_fixed_point_percent_parity(void)
+{
+  static constexpr uint32_t values[] = { 0U, 1U, 99U, 563U, 1806U, 2371U, 14000U, 57357U, 200000U };
+  for (uint8_t index=0U; index<_countof(values); ++index) {
+    for (uint16_t percent=0U; percent<128U; ++percent) {
+      TEST_ASSERT_EQUAL_UINT32(legacyPercentageApprox<9U>(percent, values[index]), percentToFixed<9U>(percent).scale(values[index]));
+    }
+    for (uint16_t percent=0U; percent<256U; ++percent) {
+      TEST_ASSERT_EQUAL_UINT32(legacyPercentageApprox<8U>(percent, values[index]), percentToFixed<8U>(percent).scale(values[index]));
+    }
+    for (uint16_t percent=0U; percent<2048U; ++percent) {
+      TEST_ASSERT_EQUAL_UINT32(legacyPercentageApprox<5U>(percent, values[index]), percentToFixed<5U>(percent).scale(values[index]));
+    }
+  }
+}
+
+// These are shared by all fixed point perf tests for consistency
+static constexpr int16_t iters = 4;
+static constexpr uint16_t start_percent = 3;
+static constexpr uint16_t end_percent = 255;
+static constexpr uint16_t percent_step = 1;
+static constexpr uint32_t percentOf = 57357;
+
+static void test_fixed_point_percent_perf(void)
+{
+  auto legacyTest = [] (uint16_t index, uint32_t &checkSum) { checkSum += legacyPercentageApprox<8U>(index, percentOf); };
+  auto fixedTest = [] (uint16_t index, uint32_t &checkSum) { checkSum += percentToFixed<8U>(index).scale(percentOf); };
+  TEST_MESSAGE("Fixed point percent vs legacy ");
+  auto comparison = compare_executiontime<uint16_t, uint32_t>(iters, start_percent, end_percent, percent_step, legacyTest, fixedTest);
+
+  // Identical algorithm, so results must match exactly
+  TEST_ASSERT_EQUAL_UINT32(comparison.timeA.result, comparison.timeB.result);
+#if defined(__AVR__)
+  // Allow a little timing jitter
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(comparison.timeA.durationMicros + (comparison.timeA.durationMicros/20U), comparison.timeB.durationMicros);
+#endif
+
+  auto divideTest = [] (uint16_t index, uint32_t &checkSum) { checkSum += percentage(index, percentOf); };
+  TEST_MESSAGE("Fixed point percent vs percentage() ");
+  auto comparison2 = compare_executiontime<uint16_t, uint32_t>(iters, start_percent, end_percent, percent_step, divideTest, fixedTest);
+  // The checksums will be different due to rounding. This is only
+  // here to force the compiler to run the loops above
+  TEST_ASSERT_INT32_WITHIN(UINT32_MAX/2, comparison2.timeA.result, comparison2.timeB.result);
+#if defined(__AVR__) // Speed up only noticeable on AVR
+  TEST_ASSERT_LESS_THAN(comparison2.timeA.durationMicros, comparison2.timeB.durationMicros);
+#endif
+}
+
+static void test_fixed_point_mulUnit_perf(void)
+{
+  auto promotedTest = [] (uint16_t index, uint32_t &checkSum) { checkSum += (UQ8_8_t::fromRaw(index) * UQ8_8_t::fromRaw(UQ8_8_t::RAW_ONE-index)).raw(); };
+  auto unitTest = [] (uint16_t index, uint32_t &checkSum) { checkSum += UQ8_8_t::mulUnit(UQ8_8_t::fromRaw(index), UQ8_8_t::fromRaw(UQ8_8_t::RAW_ONE-index)).raw(); };
+  TEST_MESSAGE("Fixed point mulUnit vs promoted multiply ");
+  auto comparison = compare_executiontime<uint16_t, uint32_t>(iters, 0U, UQ8_8_t::RAW_ONE, 1U, promotedTest, unitTest);
+
+  TEST_ASSERT_EQUAL_UINT32(comparison.timeA.result, comparison.timeB.result);
+#if defined(__AVR__) // Speed up only noticeable on AVR
+  TEST_ASSERT_LESS_THAN(comparison.timeA.durationMicros, comparison.timeB.durationMicros);
+#endif
+}
+
+void testFixedPoint(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST(test_fixed_point_conversion);
+    RUN_TEST(test_fixed_point_add_sub_saturate);
+    RUN_TEST(test_fixed_point_mul);
+    RUN_TEST(test_fixed_point_mulUnit);
+    RUN_TEST(test_fixed_point_scale);
+    RUN_TEST(test_fixed_point_percent_parity);
+    RUN_TEST(test_fixed_point_percent_perf);
+    RUN_TEST(test_fixed_point_mulUnit_perf);
+  }
+}
@@ -5,9 +5,11 @@ void runAllPageTests(void)
 {
     extern void testPage(void);
     extern void testPageCrc(void);
+    extern void testPageSpan(void);
 
     testPage();
     testPageCrc();
+    testPageSpan();
 }
 
 TEST_HARNESS(runAllPageTests)
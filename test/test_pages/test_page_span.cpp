@@ -0,0 +1,85 @@
+#include <unity.h>
+#include "pages.h"
+#include "../test_utils.h"
+
+static void setPageValues_Incremental(uint8_t pageNum, uint8_t seedValue)
+{
+    for (uint16_t offset=0; offset<getPageSize(pageNum); ++offset)
+    {
+        setPageValue(pageNum, offset, (uint8_t)(seedValue+offset));
+    }
+}
+
+// Spans that start & end at various points: mid entity, across entity
+// boundaries (including table values -> axes) & past the end of the page.
+static constexpr uint16_t spanStarts[] = { 0U, 1U, 15U, 60U, 127U, 255U, 287U };
+static constexpr uint16_t spanLengths[] = { 1U, 7U, 64U, 300U };
+
+static void test_readPage_matches_getPageValue(void)
+{
+    char szMsg[48];
+    for (uint8_t pageNum=MIN_PAGE_NUM; pageNum<MAX_PAGE_NUM; ++pageNum)
+    {
+        setPageValues_Incremental(pageNum, pageNum);
+        for (uint8_t start=0U; start<_countof(spanStarts); ++start)
+        {
+            for (uint8_t length=0U; length<_countof(spanLengths); ++length)
+            {
+                byte buffer[300];
+                memset(buffer, 0xA5, sizeof(buffer));
+                readPage(pageNum, spanStarts[start], buffer, spanLengths[length]);
+                for (uint16_t index=0U; index<spanLengths[length]; ++index)
+                {
+                    snprintf(szMsg, _countof(szMsg)-1, "Page %" PRIu8 ", Offset %" PRIu16, pageNum, (uint16_t)(spanStarts[start]+index));
+                    TEST_ASSERT_EQUAL_UINT8_MESSAGE(getPageValue(pageNum, spanStarts[start]+index), buffer[index], szMsg);
+                }
+            }
+        }
+    }
+}
+
+static void test_writePage_matches_setPageValue(void)
+{
+    char szMsg[48];
+    for (uint8_t pageNum=MIN_PAGE_NUM; pageNum<MAX_PAGE_NUM; ++pageNum)
+    {
+        const uint16_t pageSize = getPageSize(pageNum);
+        for (uint8_t start=0U; start<_countof(spanStarts); ++start)
+        {
+            for (uint8_t length=0U; length<_countof(spanLengths); ++length)
+            {
+                byte buffer[300];
+                for (uint16_t index=0U; index<spanLengths[length]; ++index)
+                {
+                    buffer[index] = (byte)(index+start+length);
+                }
+
+                // Write each byte individually to find the expected result
+                setPageValues_Incremental(pageNum, 0U);
+                bool expectedResult = true;
+                for (uint16_t index=0U; index<spanLengths[length]; ++index)
+                {
+                    expectedResult = setPageValue(pageNum, spanStarts[start]+index, buffer[index]) && expectedResult;
+                }
+                byte expected[384];
+                readPage(pageNum, 0U, expected, pageSize);
+
+                setPageValues_Incremental(pageNum, 0U);
+                snprintf(szMsg, _countof(szMsg)-1, "Page %" PRIu8 ", Offset %" PRIu16, pageNum, spanStarts[start]);
+                TEST_ASSERT_EQUAL_MESSAGE(expectedResult, writePage(pageNum, spanStarts[start], buffer, spanLengths[length]), szMsg);
+                for (uint16_t offset=0U; offset<pageSize; ++offset)
+                {
+                    snprintf(szMsg, _countof(szMsg)-1, "Page %" PRIu8 ", Offset %" PRIu16, pageNum, offset);
+                    TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected[offset], getPageValue(pageNum, offset), szMsg);
+                }
+            }
+        }
+    }
+}
+
+void testPageSpan(void) {
+    SET_UNITY_FILENAME() {
+        RUN_TEST(test_readPage_matches_getPageValue);
+        RUN_TEST(test_writePage_matches_setPageValue);
+    }
+}
@@ -518,6 +518,49 @@ static void test_multiple_activate(void)
     TEST_ASSERT_EQUAL_INT32(19, output);
 }
 
+static void test_integerPID_fixed_rate_compute_ignores_time(void)
+{
+    constexpr uint8_t SAMPLE_TIME = 33;
+    constexpr int32_t START_POINT = -155;
+    constexpr int32_t SET_POINT = 235;
+
+    integerPID timedPid;
+    timedPid.setSetPoint(SET_POINT);
+    timedPid.setTunings(PidTuningParameters(1, 10, 1), NOW, SAMPLE_TIME);
+    timedPid.setOutputLimits(-255, 255);
+    timedPid.activate(START_POINT);
+
+    integerPID fixedRatePid;
+    fixedRatePid.setSetPoint(SET_POINT);
+    fixedRatePid.setTunings(PidTuningParameters(1, 10, 1), NOW, SAMPLE_TIME);
+    fixedRatePid.setOutputLimits(-255, 255);
+    fixedRatePid.activate(START_POINT);
+
+    // Every call computes, with the same result as a timed compute exactly one sample period apart
+    int32_t input = START_POINT;
+    for (uint8_t call = 1U; call <= 5U; ++call)
+    {
+        int32_t timedOutput = 0;
+        int32_t fixedRateOutput = 0;
+        TEST_ASSERT_TRUE(timedPid.compute(NOW+(SAMPLE_TIME*call), input, &timedOutput));
+        TEST_ASSERT_TRUE(fixedRatePid.compute(input, &fixedRateOutput));
+        TEST_ASSERT_EQUAL_INT32(timedOutput, fixedRateOutput);
+        input = input + 20;
+    }
+}
+
+static void test_integerPID_fixed_rate_compute_inactive_returns_false(void)
+{
+    int32_t output = 8;
+
+    integerPID pid;
+    pid.setTunings(PidTuningParameters(10, 0, 0), NOW, 250);
+    pid.setSetPoint(20);
+
+    TEST_ASSERT_FALSE(pid.compute(10, &output));
+    TEST_ASSERT_EQUAL(8, output);
+}
+
 void testIntegerPID(void)
 {
     SET_UNITY_FILENAME() {
@@ -551,5 +594,7 @@ void testIntegerPID(void)
         RUN_TEST_P(test_end_to_end_negative_positive);
         RUN_TEST_P(test_end_to_end_positive_negative);
         RUN_TEST_P(test_multiple_activate);
+        RUN_TEST_P(test_integerPID_fixed_rate_compute_ignores_time);
+        RUN_TEST_P(test_integerPID_fixed_rate_compute_inactive_returns_false);
     }
 }
\ No newline at end of file
@@ -763,6 +763,52 @@ static void test_FlatShiftBlink_EveryHalfSecond(void)
     assert_checkProgrammableIO(context, 13 /* Arbitrary number */, 0, 0);
 }
 
+static void assert_compiled_rule_data(programmableIOTestContext_t &context, uint8_t dataIndex)
+{
+    char szMsg[32];
+    snprintf(szMsg, sizeof(szMsg), "Data index %" PRIu8, dataIndex);
+
+    context.page13.firstDataIn[0] = dataIndex;
+    context.page13.firstTarget[0] = ProgrammableIOGetData(dataIndex);
+    context.page13.operation[0].firstCompType = COMPARATOR_EQUAL;
+    compileProgrammableIO(context.page13);
+    checkProgrammableIO(context.current, context.page13);
+    TEST_ASSERT_BIT_HIGH_MESSAGE(0, currentRuleStatus, szMsg);
+
+    context.page13.operation[0].firstCompType = COMPARATOR_NOT_EQUAL;
+    compileProgrammableIO(context.page13);
+    checkProgrammableIO(context.current, context.page13);
+    TEST_ASSERT_BIT_LOW_MESSAGE(0, currentRuleStatus, szMsg);
+}
+
+static void test_compileProgrammableIO_live_data_parity(void)
+{
+    // The compiled rules read most live data fields directly: they must give
+    // the same values as ProgrammableIOGetData()
+    programmableIOTestContext_t context;
+    context.page13.outputPin[0] = 128; // Cascade rule
+    BIT_SET(pinIsValid, 0);
+
+    // Every byte different, so a field read with the wrong size, sign or byte order shows up.
+    // The decoder is called by the live data, so must stay valid
+    currentStatus = {};
+    decoder_t decoder = currentStatus.decoder;
+    uint8_t *pStatus = (uint8_t*)&currentStatus;
+    for (size_t offset = 0; offset < sizeof(currentStatus); offset++) {
+        pStatus[offset] = (uint8_t)((offset * 37U) + 11U);
+    }
+    currentStatus.decoder = decoder;
+    currentStatus.coolant = 85;
+    currentStatus.IAT = -12;
+    runSecsX10 = 40000U;
+
+    for (uint8_t dataIndex = 0; dataIndex < LOG_ENTRY_SIZE; dataIndex++) {
+        assert_compiled_rule_data(context, dataIndex);
+    }
+    assert_compiled_rule_data(context, 239U);
+    currentStatus = {};
+}
+
 void testProgrammableIOControl(void) 
 {
     SET_UNITY_FILENAME() {
@@ -789,5 +835,6 @@ void testProgrammableIOControl(void)
         RUN_TEST_P(test_ProgrammableIOGetData_two_byte_entry);
         RUN_TEST_P(test_ProgrammableIOGetData_special_indices);
         RUN_TEST_P(test_FlatShiftBlink_EveryHalfSecond);
+        RUN_TEST_P(test_compileProgrammableIO_live_data_parity);
     }
 }
@@ -293,10 +293,6 @@ static void test_calculateInjectorTimeout(void)
   TEST_ASSERT_EQUAL(9500, calculateInjectorTimeout(schedule, 123U, 351U));
   TEST_ASSERT_EQUAL(0, calculateInjectorTimeout(schedule, 351U, 123U));
 
-  schedule._status = RUNNING_WITHNEXT;
-  TEST_ASSERT_EQUAL(9500, calculateInjectorTimeout(schedule, 123U, 351U));
-  TEST_ASSERT_EQUAL(5500, calculateInjectorTimeout(schedule, 351U, 123U));
-
   schedule._status = RUNNING;
   TEST_ASSERT_EQUAL(9500, calculateInjectorTimeout(schedule, 123U, 351U));
   TEST_ASSERT_EQUAL(5500, calculateInjectorTimeout(schedule, 351U, 123U));
@@ -408,8 +404,6 @@ static void assert_calculateAngularTime(uint16_t eventAngle, uint16_t crankAngle
   }
   schedule._status = RUNNING; 
   TEST_ASSERT_EQUAL(expected, _calculateAngularTime(schedule, eventAngle, crankAngle, 360));
-  schedule._status = RUNNING_WITHNEXT; 
-  TEST_ASSERT_EQUAL(expected, _calculateAngularTime(schedule, eventAngle, crankAngle, 360));
 }
 
 static void test_calculateAngularTime_eventcrank_equal(void)
@@ -20,6 +20,7 @@ void runAllScheduleTests(void)
   extern void test_overdwell(void);
   extern void test_ignition_schedule_controller();
   extern void testApplyPwToInjectorChannels(void);
+  extern void testVirtualTime(void);
 
   initialiseAll();
 
@@ -39,6 +40,7 @@ void runAllScheduleTests(void)
   test_overdwell();
   test_ignition_schedule_controller();
   testApplyPwToInjectorChannels();
+  testVirtualTime();
 }
 
 TEST_HARNESS(runAllScheduleTests)
@@ -9,9 +9,10 @@
 extern bool isAnyFuelScheduleRunning(void);
 extern uint16_t lookupInjectorAngle(const statuses &current);
 extern table2D_u8_u16_4 injectorAngleTable;
-extern void setFuelChannelSchedule(FuelSchedule &schedule, uint8_t channel, uint16_t crankAngle, byte injChannelMask, uint16_t injAngle, injectorAngleCalcCache *pCache);
+extern void setFuelChannelSchedule(FuelSchedule &schedule, uint8_t channel, uint16_t crankAngle, byte injChannelMask, uint16_t injAngle, injectorAngleCalcCache *pCache, decoder_t::getToothAngle_t getToothAngle);
 extern table2D_u8_u8_4 PrimingPulseTable;
 extern uint16_t setFuelChannelSchedules(uint16_t crankAngle, byte injChannelMask, uint16_t injAngle);
+extern uint16_t _calculateOpenAngle(FuelSchedule &schedule, uint16_t pwDegrees, uint16_t injAngle);
 extern bool changeToFullSequentialInjection(const config2 &page2, const decoder_status_t &decoderStatus);
 extern bool changeToSemiSequentialInjection(const config2 &page2, const decoder_status_t &decoderStatus);
 
@@ -87,10 +88,10 @@ static void test_setFuelChannelSchedule_ignores_zero_pw(void)
 
   injectorAngleCalcCache cache = {};
   schedule.pw = 0;
-  setFuelChannelSchedule(schedule, UINT8_C(1), 100U, 1U, 180U, &cache);
+  setFuelChannelSchedule(schedule, UINT8_C(1), 100U, 1U, 180U, &cache, nullptr);
 
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0U, schedule._duration);
+  TEST_ASSERT_EQUAL(0U, schedule.activeParams().duration);
   TEST_ASSERT_EQUAL(0U, schedule._compare);
 }
 
@@ -102,10 +103,10 @@ static void test_setFuelChannelSchedule_ignores_zero_timeout(void)
   setup_setFuelChannelSchedule(schedule);
 
   injectorAngleCalcCache cache = {};
-  setFuelChannelSchedule(schedule, UINT8_C(1), 0U, 1U, 0U, &cache);
+  setFuelChannelSchedule(schedule, UINT8_C(1), 0U, 1U, 0U, &cache, nullptr);
 
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0U, schedule._duration);
+  TEST_ASSERT_EQUAL(0U, schedule.activeParams().duration);
   TEST_ASSERT_EQUAL(0U, schedule._compare);
 }
 
@@ -117,10 +118,10 @@ static void test_setFuelChannelSchedule_ignores_disabled_channel(void)
   setup_setFuelChannelSchedule(schedule);
 
   injectorAngleCalcCache cache = {};
-  setFuelChannelSchedule(schedule, UINT8_C(1), 0U, 0U, 180U, &cache);
+  setFuelChannelSchedule(schedule, UINT8_C(1), 0U, 0U, 180U, &cache, nullptr);
 
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0U, schedule._duration);
+  TEST_ASSERT_EQUAL(0U, schedule.activeParams().duration);
   TEST_ASSERT_EQUAL(0U, schedule._compare);
 }
 
@@ -132,13 +133,54 @@ static void test_setFuelChannelSchedule_starts_pending_when_enabled(void)
   setup_setFuelChannelSchedule(schedule);
   
   injectorAngleCalcCache cache = {};
-  setFuelChannelSchedule(schedule, UINT8_C(1), 300U, 1U, 355U, &cache);
+  setFuelChannelSchedule(schedule, UINT8_C(1), 300U, 1U, 355U, &cache, nullptr);
 
   TEST_ASSERT_EQUAL(PENDING, schedule._status);
-  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(1000U), schedule._duration);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(1000U), schedule.activeParams().duration);
   TEST_ASSERT_GREATER_THAN(0U, schedule._compare);
 }
 
+static uint16_t lastToothAngle;
+static toothAngle_t getToothAngle_fixed(int16_t angle, uint16_t maxAngle)
+{
+  TEST_ASSERT_EQUAL_UINT16(CRANK_ANGLE_MAX_INJ, maxAngle);
+  lastToothAngle = (uint16_t)angle;
+  return toothAngle_t{ 12U, 7U };
+}
+
+static toothAngle_t getToothAngle_none(int16_t, uint16_t)
+{
+  return toothAngle_t{ 0U, 0U };
+}
+
+static void test_setFuelChannelSchedule_registers_tooth(void)
+{
+  raw_counter_t counter = {5U};
+  raw_compare_t compare = {0};
+  FuelSchedule schedule(counter, compare);
+  setup_setFuelChannelSchedule(schedule);
+  
+  // Set by the decoder ISR, not now
+  injectorAngleCalcCache cache = {};
+  setFuelChannelSchedule(schedule, UINT8_C(1), 300U, 1U, 355U, &cache, getToothAngle_fixed);
+  TEST_ASSERT_EQUAL(OFF, schedule._status);
+  TEST_ASSERT_EQUAL_UINT16(12U, schedule._armTooth);
+  TEST_ASSERT_EQUAL_UINT16(7U, schedule._armResidual);
+  TEST_ASSERT_EQUAL_UINT16(1000U, schedule._armDuration);
+  TEST_ASSERT_EQUAL_UINT16(_calculateOpenAngle(schedule, timeToAngle(schedule.pw), 355U), lastToothAngle);
+
+  // The decoder can't place the angle: set by time
+  setFuelChannelSchedule(schedule, UINT8_C(1), 300U, 1U, 355U, &cache, getToothAngle_none);
+  TEST_ASSERT_EQUAL_UINT16(0U, schedule._armTooth);
+  TEST_ASSERT_EQUAL(PENDING, schedule._status);
+
+  // A disabled channel isn't set at all
+  setFuelChannelSchedule(schedule, UINT8_C(1), 300U, 1U, 355U, &cache, getToothAngle_fixed);
+  TEST_ASSERT_EQUAL_UINT16(12U, schedule._armTooth);
+  setFuelChannelSchedule(schedule, UINT8_C(1), 300U, 0U, 355U, &cache, getToothAngle_fixed);
+  TEST_ASSERT_EQUAL_UINT16(0U, schedule._armTooth);
+}
+
 static void test_lookupInjectorAngle_clamp_max_inj(void)
 {
   statuses current = {};
@@ -158,7 +200,7 @@ static void assert_isPriming(FuelSchedule &schedule, bool priming)
   if (priming)
   {
     TEST_ASSERT_EQUAL(PENDING, schedule._status);
-    TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(PRIMING_PULSE_WIDTH*500U), schedule._duration);
+    TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(PRIMING_PULSE_WIDTH*500U), schedule.activeParams().duration);
   }
   else
   {
@@ -303,6 +345,7 @@ void test_fuel_controller(void)
     RUN_TEST_P(test_setFuelChannelSchedule_ignores_disabled_channel);
     RUN_TEST_P(test_setFuelChannelSchedule_starts_pending_when_enabled);
     RUN_TEST_P(test_setFuelChannelSchedule_ignores_zero_timeout);
+    RUN_TEST_P(test_setFuelChannelSchedule_registers_tooth);
     RUN_TEST_P(test_lookupInjectorAngle_clamp_max_inj);
     RUN_TEST_P(test_beginInjectorPriming_floodclear);
     RUN_TEST_P(test_beginInjectorPriming);
@@ -41,8 +41,9 @@ static void test_ignition_schedule_RUNNING_to_RUNNINGWITHNEXT_Disallow(void) {
   // Should not have changed
   TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT), schedule._compare);
   TEST_ASSERT_EQUAL(RUNNING, schedule._status);
-  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION), schedule._duration);
-  TEST_ASSERT_EQUAL(0, schedule._nextStartCompare);
+  TEST_ASSERT_FALSE(schedule._hasNext);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION), schedule.activeParams().duration);
+  TEST_ASSERT_EQUAL(0, schedule.nextParams().startCompare);
 
   // Positive test
   setAngleConverterRevolutionTime(revTime/2U);
@@ -51,9 +52,10 @@ static void test_ignition_schedule_RUNNING_to_RUNNINGWITHNEXT_Disallow(void) {
   // Should not have changed
   TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT), schedule._compare);
   // These should have changed
-  TEST_ASSERT_EQUAL(RUNNING_WITHNEXT, schedule._status);
-  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION+DURATION_OFFSET), schedule._duration);
-  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT+TIMEOUT_OFFSET), schedule._nextStartCompare);
+  TEST_ASSERT_EQUAL(RUNNING, schedule._status);
+  TEST_ASSERT_TRUE(schedule._hasNext);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION+DURATION_OFFSET), schedule.nextParams().duration);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT+TIMEOUT_OFFSET), schedule.nextParams().startCompare);
 }
 
 void test_ignition_schedule(void)
@@ -205,6 +205,86 @@ static void test_setIgnitionChannels_mask_enables_and_disables_channels(void)
     }
 }
 
+static void set_all_ignition_schedules_off(void)
+{
+    RUNIF_IGNCHANNEL1( { ignitionSchedule1._status = ScheduleStatus::OFF; }, {});
+    RUNIF_IGNCHANNEL2( { ignitionSchedule2._status = ScheduleStatus::OFF; }, {});
+    RUNIF_IGNCHANNEL3( { ignitionSchedule3._status = ScheduleStatus::OFF; }, {});
+    RUNIF_IGNCHANNEL4( { ignitionSchedule4._status = ScheduleStatus::OFF; }, {});
+    RUNIF_IGNCHANNEL5( { ignitionSchedule5._status = ScheduleStatus::OFF; }, {});
+    RUNIF_IGNCHANNEL6( { ignitionSchedule6._status = ScheduleStatus::OFF; }, {});
+    RUNIF_IGNCHANNEL7( { ignitionSchedule7._status = ScheduleStatus::OFF; }, {});
+    RUNIF_IGNCHANNEL8( { ignitionSchedule8._status = ScheduleStatus::OFF; }, {});
+}
+
+static void test_setIgnitionChannels_ignores_inactive_channels(void)
+{
+    ignition_test_context_t context;
+    context.current.maxIgnOutputs = IGN_CHANNELS;
+    context.page4.sparkMode = IGN_MODE_SEQUENTIAL;
+    CRANK_ANGLE_MAX_IGN = 720U;
+    setup_ignition_channel_angles();
+    context.calculateIgnitionAngles();
+
+    for (uint8_t index=0; index<=IGN_CHANNELS; ++index)
+    {
+        set_all_ignition_schedules_off();
+        context.current.maxIgnOutputs = index;
+        // All channels enabled: only the active outputs should be scheduled
+        context.current.schedulerCutState.ignitionChannels = 0xFF;
+        setIgnitionChannels(context.current, 0U, context.current.dwell);
+
+        RUNIF_IGNCHANNEL1( { TEST_ASSERT_EQUAL_UINT8(index>=1 ? PENDING : OFF, (uint8_t)ignitionSchedule1._status); }, {});
+        RUNIF_IGNCHANNEL2( { TEST_ASSERT_EQUAL_UINT8(index>=2 ? PENDING : OFF, (uint8_t)ignitionSchedule2._status); }, {});
+        RUNIF_IGNCHANNEL3( { TEST_ASSERT_EQUAL_UINT8(index>=3 ? PENDING : OFF, (uint8_t)ignitionSchedule3._status); }, {});
+        RUNIF_IGNCHANNEL4( { TEST_ASSERT_EQUAL_UINT8(index>=4 ? PENDING : OFF, (uint8_t)ignitionSchedule4._status); }, {});
+        RUNIF_IGNCHANNEL5( { TEST_ASSERT_EQUAL_UINT8(index>=5 ? PENDING : OFF, (uint8_t)ignitionSchedule5._status); }, {});
+        RUNIF_IGNCHANNEL6( { TEST_ASSERT_EQUAL_UINT8(index>=6 ? PENDING : OFF, (uint8_t)ignitionSchedule6._status); }, {});
+        RUNIF_IGNCHANNEL7( { TEST_ASSERT_EQUAL_UINT8(index>=7 ? PENDING : OFF, (uint8_t)ignitionSchedule7._status); }, {});
+        RUNIF_IGNCHANNEL8( { TEST_ASSERT_EQUAL_UINT8(index>=8 ? PENDING : OFF, (uint8_t)ignitionSchedule8._status); }, {});
+    }
+}
+
+static void test_setIgnitionChannels_registers_tooth_schedules(void)
+{
+    ignition_test_context_t context;
+    context.current.maxIgnOutputs = 1U;
+    context.current.schedulerCutState.ignitionChannels = 0xFF;
+    context.current.rotationStatus = EngineRotationStatus::Running;
+    setup_ignition_channel_angles();
+    context.calculateIgnitionAngles();
+    set_all_ignition_schedules_off();
+
+    // The decoder placed the charge against a tooth: it's registered, not set
+    ignitionSchedule1.chargeTooth = toothAngle_t{ 5U, 3U };
+    setIgnitionChannels(context.current, 0U, context.current.dwell);
+    TEST_ASSERT_EQUAL_UINT8(OFF, (uint8_t)ignitionSchedule1._status);
+    TEST_ASSERT_EQUAL_UINT16(5U, ignitionSchedule1._armTooth);
+    TEST_ASSERT_EQUAL_UINT16(3U, ignitionSchedule1._armResidual);
+    TEST_ASSERT_EQUAL_UINT16(context.current.dwell, ignitionSchedule1._armDuration);
+
+    // The decoders don't check the teeth while cranking, so it's set by time
+    context.current.rotationStatus = EngineRotationStatus::Cranking;
+    setIgnitionChannels(context.current, 0U, context.current.dwell);
+    TEST_ASSERT_EQUAL_UINT8(PENDING, (uint8_t)ignitionSchedule1._status);
+    TEST_ASSERT_EQUAL_UINT16(0U, ignitionSchedule1._armTooth);
+
+    // A cut channel is neither registered nor set
+    set_all_ignition_schedules_off();
+    context.current.rotationStatus = EngineRotationStatus::Running;
+    setIgnitionChannels(context.current, 0U, context.current.dwell);
+    TEST_ASSERT_EQUAL_UINT16(5U, ignitionSchedule1._armTooth);
+    context.current.schedulerCutState.ignitionChannels = 0x00;
+    setIgnitionChannels(context.current, 0U, context.current.dwell);
+    TEST_ASSERT_EQUAL_UINT8(OFF, (uint8_t)ignitionSchedule1._status);
+    TEST_ASSERT_EQUAL_UINT16(0U, ignitionSchedule1._armTooth);
+
+    // Recalculating the angles removes the tooth, unless the decoder sets it again
+    ignitionSchedule1.chargeTooth = toothAngle_t{ 5U, 3U };
+    context.calculateIgnitionAngles();
+    TEST_ASSERT_EQUAL_UINT16(0U, ignitionSchedule1.chargeTooth.tooth);
+}
+
 static void test_changeIgnitionToFullSequential_isapplied(uint8_t numCylinders)
 {
     statuses current = {};
@@ -571,6 +651,8 @@ void test_ignition_schedule_controller(void)
     RUN_TEST_P(test_calculateIgnitionAngles_rotary_non_4_output_uses_non_rotary);
     RUN_TEST_P(test_calculateIgnitionAngles_sync_state_transitions);
     RUN_TEST_P(test_setIgnitionChannels_mask_enables_and_disables_channels);
+    RUN_TEST_P(test_setIgnitionChannels_ignores_inactive_channels);
+    RUN_TEST_P(test_setIgnitionChannels_registers_tooth_schedules);
     RUN_TEST_P(test_changeIgnitionToFullSequential);
     RUN_TEST_P(test_changeIgnitionToFullSequential_running_schedule);
     RUN_TEST_P(test_changeIgnitionToHalfSync);
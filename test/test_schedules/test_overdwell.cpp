@@ -3,11 +3,15 @@
 #include "scheduler.h"
 #include "src/stdlib/type_traits.h"
 #include "globals.h"
+#include "crankMaths.h"
 
 using raw_counter_t = type_traits::remove_reference<IgnitionSchedule::counter_t>::type;
 using raw_compare_t = type_traits::remove_reference<IgnitionSchedule::compare_t>::type;
 
 extern bool isOverDwellActive(const config4 &page4, const statuses &current);
+// The angle converter state set by setAngleConverterRevolutionTime()
+extern uint32_t microsPerDegree;
+extern uint16_t degreesPerMicro;
 
 static statuses rpmBelowLimit(void)
 {
@@ -65,81 +69,101 @@ static void test_isOverDwellActive_rpmAboveLimit(void) {
   TEST_ASSERT_FALSE(isOverDwellActive(page4, rpmAboveLimit())); 
 }
 
-extern void applyChannelOverDwellProtection(IgnitionSchedule &schedule, uint32_t now, uint32_t dwellLimit_uS);
-
 static uint8_t counter = 0;
 static void counter_callback(void) {
   ++counter;
 }
 
-static void test_applyChannelOverDwellProtection_notRunning(void) {
-  raw_counter_t counterReg = {101};
-  raw_compare_t compareReg = {100};
-  IgnitionSchedule schedule(counterReg, compareReg);
+static constexpr COMPARE_TYPE INITIAL_COUNTER = 101U;
 
+// Start the coil charging, as the timer ISR would at the end of the delay
+static void startCharge(IgnitionSchedule &schedule, uint32_t dwell_uS) {
   counter = 0;
   setCallbacks(schedule, counter_callback, counter_callback);
-
+  schedule.activeParams().duration = uS_TO_TIMER_COMPARE(dwell_uS);
   schedule._status = PENDING;
-  schedule._startTime = 0;
-  applyChannelOverDwellProtection(schedule, 2000, 1000);
-  TEST_ASSERT_EQUAL(0, counter); // Check that the callback was not called when the schedule is not running
+  moveToNextState(schedule);
+  TEST_ASSERT_EQUAL(RUNNING, schedule._status);
+  TEST_ASSERT_EQUAL(1, counter);
 }
 
-static void test_applyChannelOverDwellProtection_running_notimeout(void) {
-  raw_counter_t counterReg = {101};
+static void test_overdwell_off(void) {
+  raw_counter_t counterReg = {INITIAL_COUNTER};
   raw_compare_t compareReg = {100};
   IgnitionSchedule schedule(counterReg, compareReg);
 
-  counter = 0;
-  setCallbacks(schedule, counter_callback, counter_callback);
-
-  schedule._status = RUNNING;
-  schedule._startTime = 2000;
-  applyChannelOverDwellProtection(schedule, 2500, 1000);
-  TEST_ASSERT_EQUAL(0, counter); // Check that the callback was not called when the dwell limit has not elapsed
+  setMaxDwell(0U);
+  startCharge(schedule, 5000U);
+  TEST_ASSERT_FALSE(schedule._isDwellLimited);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(5000U), schedule._compare); // Charge ends as scheduled
 }
 
-static void test_applyChannelOverDwellProtection_running_timeout(void) {
-  raw_counter_t counterReg = {101};
+static void test_overdwell_within_limit(void) {
+  raw_counter_t counterReg = {INITIAL_COUNTER};
   raw_compare_t compareReg = {100};
   IgnitionSchedule schedule(counterReg, compareReg);
 
-  counter = 0;
-  setCallbacks(schedule, counter_callback, counter_callback);
-
-  schedule._status = RUNNING;
-  schedule._startTime = 0;
-  applyChannelOverDwellProtection(schedule, 2000, 1000);
-  TEST_ASSERT_EQUAL(1, counter); // Check that the callback was called when the schedule is running
+  setMaxDwell(5000U);
+  startCharge(schedule, 3000U);
+  TEST_ASSERT_TRUE(schedule._isDwellLimited);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(5000U), schedule._dwellDeadline);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(3000U), schedule._compare); // Charge ends as scheduled
+  setMaxDwell(0U);
 }
 
-static void test_applyChannelOverDwellProtection_running_notimeout_rollover(void) {
-  raw_counter_t counterReg = {101};
+static void test_overdwell_exceeds_limit(void) {
+  raw_counter_t counterReg = {INITIAL_COUNTER};
   raw_compare_t compareReg = {100};
   IgnitionSchedule schedule(counterReg, compareReg);
 
-  counter = 0;
-  setCallbacks(schedule, counter_callback, counter_callback);
+  setMaxDwell(3000U);
+  startCharge(schedule, 5000U);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(3000U), schedule._compare); // Charge is cut at the limit
 
-  schedule._status = RUNNING;
-  schedule._startTime = UINT32_MAX - 500U; // Dwell started just before the micros() wrap
-  applyChannelOverDwellProtection(schedule, 400U, 1000U); // 901 uS elapsed across the wrap
-  TEST_ASSERT_EQUAL(0, counter); // Dwell limit not reached: the coil must not be cut
+  // The timer fires at the limit & ends the charge
+  moveToNextState(schedule);
+  TEST_ASSERT_EQUAL(OFF, schedule._status);
+  TEST_ASSERT_EQUAL(2, counter);
+  setMaxDwell(0U);
 }
 
-static void test_applyChannelOverDwellProtection_running_timeout_rollover(void) {
-  raw_counter_t counterReg = {101};
+static void test_overdwell_exceeds_limit_rollover(void) {
+  constexpr COMPARE_TYPE startCounter = (numeric_limits<COMPARE_TYPE>::max)() - 10U; // Charge starts just before the timer wraps
+  raw_counter_t counterReg = {startCounter};
   raw_compare_t compareReg = {100};
   IgnitionSchedule schedule(counterReg, compareReg);
 
-  counter = 0;
-  setCallbacks(schedule, counter_callback, counter_callback);
+  setMaxDwell(3000U);
+  startCharge(schedule, 5000U);
+  TEST_ASSERT_EQUAL((COMPARE_TYPE)(startCounter + uS_TO_TIMER_COMPARE(3000U)), schedule._compare);
+  setMaxDwell(0U);
+}
 
-  schedule._status = RUNNING;
-  schedule._startTime = UINT32_MAX - 500U; // Dwell started just before the micros() wrap
-  applyChannelOverDwellProtection(schedule, 600U, 1000U); // 1101 uS elapsed across the wrap
-  TEST_ASSERT_EQUAL(1, counter); // Dwell limit exceeded: the coil must be cut
+static void test_overdwell_adjustCrankAngle_limited(void) {
+  raw_counter_t counterReg = {INITIAL_COUNTER};
+  raw_compare_t compareReg = {100};
+  IgnitionSchedule schedule(counterReg, compareReg);
+  statuses current = {};
+
+  setMaxDwell(3000U);
+  startCharge(schedule, 2000U);
+
+  // Retarding the spark a long way would extend the charge past the limit
+  const uint32_t oldMicrosPerDegree = microsPerDegree;
+  const uint16_t oldDegreesPerMicro = degreesPerMicro;
+  setAngleConverterRevolutionTime(60000UL);
+  schedule.dischargeAngle = 180;
+  counterReg = INITIAL_COUNTER + uS_TO_TIMER_COMPARE(1000U);
+  adjustCrankAngle(current, schedule, 0);
+  TEST_ASSERT_EQUAL(schedule._dwellDeadline, schedule._compare);
+
+  // A small move is within the limit
+  schedule.dischargeAngle = 3;
+  adjustCrankAngle(current, schedule, 0);
+  TEST_ASSERT_EQUAL(counterReg + uS_TO_TIMER_COMPARE(angleToTime(3U)), schedule._compare);
+  setMaxDwell(0U);
+  microsPerDegree = oldMicrosPerDegree;
+  degreesPerMicro = oldDegreesPerMicro;
 }
 
 void test_overdwell(void)
@@ -147,10 +171,10 @@ void test_overdwell(void)
   SET_UNITY_FILENAME() {
     RUN_TEST_P(test_isOverDwellActive_rpmAboveLimit);
     RUN_TEST_P(test_isOverDwellActive_rpmBelowLimit);
-    RUN_TEST_P(test_applyChannelOverDwellProtection_notRunning);
-    RUN_TEST_P(test_applyChannelOverDwellProtection_running_notimeout);
-    RUN_TEST_P(test_applyChannelOverDwellProtection_running_timeout);
-    RUN_TEST_P(test_applyChannelOverDwellProtection_running_notimeout_rollover);
-    RUN_TEST_P(test_applyChannelOverDwellProtection_running_timeout_rollover);
+    RUN_TEST_P(test_overdwell_off);
+    RUN_TEST_P(test_overdwell_within_limit);
+    RUN_TEST_P(test_overdwell_exceeds_limit);
+    RUN_TEST_P(test_overdwell_exceeds_limit_rollover);
+    RUN_TEST_P(test_overdwell_adjustCrankAngle_limited);
   }
-}
\ No newline at end of file
+}
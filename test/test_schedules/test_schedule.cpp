@@ -16,10 +16,10 @@ static void test_timeout_TooLarge(void) {
   Schedule schedule(counter, compare);
 
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0, schedule._duration);
+  TEST_ASSERT_EQUAL(0, schedule.activeParams().duration);
   setSchedule(schedule, MAX_TIMER_PERIOD, DURATION, true);
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0, schedule._duration);
+  TEST_ASSERT_EQUAL(0, schedule.activeParams().duration);
 }
 
 static void test_timeout_TooSmall(void) {
@@ -28,10 +28,10 @@ static void test_timeout_TooSmall(void) {
   Schedule schedule(counter, compare);
 
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0, schedule._duration);
+  TEST_ASSERT_EQUAL(0, schedule.activeParams().duration);
   setSchedule(schedule, 0U, DURATION, true);
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0, schedule._duration);
+  TEST_ASSERT_EQUAL(0, schedule.activeParams().duration);
 }
 
 static void test_duration_TooLarge(void) {
@@ -42,10 +42,10 @@ static void test_duration_TooLarge(void) {
     Schedule schedule(counter, compare);
 
     TEST_ASSERT_EQUAL(OFF, schedule._status);
-    TEST_ASSERT_EQUAL(0, schedule._duration);
+    TEST_ASSERT_EQUAL(0, schedule.activeParams().duration);
     setSchedule(schedule, TIMEOUT, (uint16_t)MAX_TIMER_PERIOD+1U, true);
     TEST_ASSERT_EQUAL(PENDING, schedule._status);
-    TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(MAX_TIMER_PERIOD - 1U), schedule._duration);
+    TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(MAX_TIMER_PERIOD - 1U), schedule.activeParams().duration);
   }
   else
   {
@@ -59,10 +59,10 @@ static void test_duration_TooSmall(void) {
   Schedule schedule(counter, compare);
 
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0, schedule._duration);
+  TEST_ASSERT_EQUAL(0, schedule.activeParams().duration);
   setSchedule(schedule, TIMEOUT, 0U, true);
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0, schedule._duration);
+  TEST_ASSERT_EQUAL(0, schedule.activeParams().duration);
 }
 
 static void test_schedule_OFF_to_PENDING(void) {
@@ -71,13 +71,13 @@ static void test_schedule_OFF_to_PENDING(void) {
   Schedule schedule(counter, compare);
 
   TEST_ASSERT_EQUAL(OFF, schedule._status);
-  TEST_ASSERT_EQUAL(0, schedule._duration);
-  TEST_ASSERT_EQUAL(0, schedule._nextStartCompare);
+  TEST_ASSERT_EQUAL(0, schedule.activeParams().duration);
+  TEST_ASSERT_EQUAL(0, schedule.nextParams().startCompare);
   TEST_ASSERT_EQUAL(0, schedule._compare);
   TEST_ASSERT_EQUAL(INITIAL_COUNTER, schedule._counter);
   setSchedule(schedule, TIMEOUT, DURATION, true);
   TEST_ASSERT_EQUAL(PENDING, schedule._status);
-  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION), schedule._duration);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION), schedule.activeParams().duration);
   TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT), schedule._compare);
 }
 
@@ -89,7 +89,7 @@ static void test_schedule_PENDING_to_PENDING(void) {
   // setSchedule(schedule, TIMEOUT, DURATION, true);
   setSchedule(schedule, TIMEOUT+1000, DURATION+500, true);
   TEST_ASSERT_EQUAL(PENDING, schedule._status);
-  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION+500), schedule._duration);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION+500), schedule.activeParams().duration);
   TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT+1000), schedule._compare);
 }
 
@@ -109,10 +109,12 @@ static void test_schedule_RUNNING_to_RUNNINGWITHNEXT(void) {
   setSchedule(schedule, TIMEOUT+TIMEOUT_OFFSET, DURATION+DURATION_OFFSET, true);
   // Should not have changed
   TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT), schedule._compare);
+  TEST_ASSERT_EQUAL(RUNNING, schedule._status);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION), schedule.activeParams().duration);
   // These should have changed
-  TEST_ASSERT_EQUAL(RUNNING_WITHNEXT, schedule._status);
-  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION+DURATION_OFFSET), schedule._duration);
-  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT+TIMEOUT_OFFSET), schedule._nextStartCompare);
+  TEST_ASSERT_TRUE(schedule._hasNext);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION+DURATION_OFFSET), schedule.nextParams().duration);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT+TIMEOUT_OFFSET), schedule.nextParams().startCompare);
 }
 
 static void test_schedule_RUNNINGWITHNEXT_to_RUNNINGWITHNEXT(void) 
@@ -128,14 +130,17 @@ static void test_schedule_RUNNINGWITHNEXT_to_RUNNINGWITHNEXT(void)
   setSchedule(schedule, TIMEOUT, DURATION, true);
   TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT), schedule._compare);
 
-  schedule._status = RUNNING_WITHNEXT;
+  schedule._status = RUNNING;
+  setSchedule(schedule, TIMEOUT, DURATION, true);
+  TEST_ASSERT_TRUE(schedule._hasNext);
   setSchedule(schedule, TIMEOUT+TIMEOUT_OFFSET, DURATION+DURATION_OFFSET, true);
   // Should not have changed
   TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT), schedule._compare);
-  TEST_ASSERT_EQUAL(RUNNING_WITHNEXT, schedule._status);
+  TEST_ASSERT_EQUAL(RUNNING, schedule._status);
+  TEST_ASSERT_TRUE(schedule._hasNext);
   // These should have changed
-  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION+DURATION_OFFSET), schedule._duration);
-  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT+TIMEOUT_OFFSET), schedule._nextStartCompare);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION+DURATION_OFFSET), schedule.nextParams().duration);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT+TIMEOUT_OFFSET), schedule.nextParams().startCompare);
 }
 
 static void test_schedule_RUNNING_to_RUNNINGWITHNEXT_Disallow(void) {
@@ -151,8 +156,36 @@ static void test_schedule_RUNNING_to_RUNNINGWITHNEXT_Disallow(void) {
   // Should not have changed
   TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT), schedule._compare);
   TEST_ASSERT_EQUAL(RUNNING, schedule._status);
-  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION), schedule._duration);
-  TEST_ASSERT_EQUAL(0, schedule._nextStartCompare);
+  TEST_ASSERT_FALSE(schedule._hasNext);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION), schedule.activeParams().duration);
+  TEST_ASSERT_EQUAL(0, schedule.nextParams().startCompare);
+}
+
+static void test_schedule_queued_handover(void) {
+  static constexpr uint32_t DURATION_OFFSET = 33;
+  static constexpr uint32_t TIMEOUT_OFFSET = 77;
+
+  raw_counter_t counter = { INITIAL_COUNTER };
+  raw_compare_t compare = {0};
+  FuelSchedule schedule(counter, compare);
+
+  setSchedule(schedule, TIMEOUT, DURATION, true);
+  moveToNextState(schedule); // Start the action
+  TEST_ASSERT_EQUAL(RUNNING, schedule._status);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(DURATION), schedule._compare);
+
+  setSchedule(schedule, TIMEOUT+TIMEOUT_OFFSET, DURATION+DURATION_OFFSET, true);
+  moveToNextState(schedule); // End the action: the ISR takes over the queued event
+  TEST_ASSERT_EQUAL(PENDING, schedule._status);
+  TEST_ASSERT_FALSE(schedule._hasNext);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT+TIMEOUT_OFFSET), schedule._compare);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION+DURATION_OFFSET), schedule.activeParams().duration);
+
+  // A late update to the pending event is applied
+  setSchedule(schedule, TIMEOUT, DURATION, true);
+  TEST_ASSERT_EQUAL(PENDING, schedule._status);
+  TEST_ASSERT_EQUAL(INITIAL_COUNTER + uS_TO_TIMER_COMPARE(TIMEOUT), schedule._compare);
+  TEST_ASSERT_EQUAL(uS_TO_TIMER_COMPARE(DURATION), schedule.activeParams().duration);
 }
 
 void test_schedule(void)
@@ -167,5 +200,6 @@ void test_schedule(void)
     RUN_TEST_P(test_schedule_RUNNING_to_RUNNINGWITHNEXT);
     RUN_TEST_P(test_schedule_RUNNINGWITHNEXT_to_RUNNINGWITHNEXT);
     RUN_TEST_P(test_schedule_RUNNING_to_RUNNINGWITHNEXT_Disallow);
+    RUN_TEST_P(test_schedule_queued_handover);
   }
 }
@@ -26,7 +26,7 @@ static void test_defaultPendingToRunning(void) {
     startCount = 0;
     endCount = 0;
 
-    schedule._duration = uS_TO_TIMER_COMPARE(2048); 
+    schedule.activeParams().duration = uS_TO_TIMER_COMPARE(2048); 
 #if defined(CORE_AVR)        
     raw_counter_t counterPreAction = schedule._counter;
 #endif
@@ -35,7 +35,7 @@ static void test_defaultPendingToRunning(void) {
 
     TEST_ASSERT_EQUAL(RUNNING, schedule._status);
 #if defined(CORE_AVR)        
-    TEST_ASSERT_UINT32_WITHIN(TIMER_VARIANCE, counterPreAction+schedule._duration, schedule._compare);
+    TEST_ASSERT_UINT32_WITHIN(TIMER_VARIANCE, counterPreAction+schedule.activeParams().duration, schedule._compare);
 #endif
     TEST_ASSERT_EQUAL(1, startCount);
     TEST_ASSERT_EQUAL(0, endCount);
@@ -57,7 +57,8 @@ static void test_defaultRunningToOff(void) {
     TEST_ASSERT_EQUAL(0, startCount);
     TEST_ASSERT_EQUAL(1, endCount);
 
-    schedule._status = RUNNING_WITHNEXT;
+    schedule._status = RUNNING;
+    schedule._hasNext = true;
     startCount = 0;
     endCount = 0;
     
@@ -77,14 +78,16 @@ static void test_defaultRunningToPending(void) {
     schedule._status = RUNNING;
     startCount = 0;
     endCount = 0;
-    schedule._nextStartCompare = schedule._counter + uS_TO_TIMER_COMPARE(2048); 
+    schedule.nextParams().startCompare = schedule._counter + uS_TO_TIMER_COMPARE(2048); 
+    schedule._hasNext = true;
+    uint8_t nextSlot = schedule._activeParams ^ 1U;
 
     defaultRunningToPending(&schedule);
 
     TEST_ASSERT_EQUAL(PENDING, schedule._status);
-#if defined(CORE_AVR)        
-    TEST_ASSERT_UINT32_WITHIN(TIMER_VARIANCE, schedule._nextStartCompare, schedule._compare);
-#endif
+    TEST_ASSERT_FALSE(schedule._hasNext);
+    TEST_ASSERT_EQUAL(nextSlot, schedule._activeParams);
+    TEST_ASSERT_EQUAL(schedule.activeParams().startCompare, schedule._compare);
     TEST_ASSERT_EQUAL(0, startCount);
     TEST_ASSERT_EQUAL(1, endCount);
 }
@@ -164,7 +167,8 @@ static void test_movetoNextState_runningToPending(void) {
     Schedule schedule(counter, compare);
     setCallbacks(schedule, startCallback, endCallback);
 
-    schedule._status = RUNNING_WITHNEXT;
+    schedule._status = RUNNING;
+    schedule._hasNext = true;
     pendingToRunningCount = 0;
     pPendingToRunningSchedule = NULL;
     runningToOffCount = 0;
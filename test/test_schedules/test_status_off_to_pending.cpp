@@ -13,7 +13,7 @@ void test_status_off_to_pending(Schedule &schedule)
 {
     setSchedule(schedule, TIMEOUT, DURATION, true);
     TEST_ASSERT_EQUAL(PENDING, schedule._status);
-    while(schedule._status != OFF) /*Wait*/ ;
+    while(schedule._status != OFF) { waitForTimerEvent(); }
 }
 
 void test_status_off_to_pending_inj(FuelSchedule &schedule)
@@ -12,9 +12,9 @@
 static void test_status_pending_to_running(Schedule &schedule)
 {
     setSchedule(schedule, TIMEOUT, DURATION, true);
-    while(schedule._status == PENDING) /*Wait*/ ;
+    while(schedule._status == PENDING) { waitForTimerEvent(); }
     TEST_ASSERT_EQUAL(RUNNING, schedule._status);
-    while(schedule._status != OFF) /*Wait*/ ;
+    while(schedule._status != OFF) { waitForTimerEvent(); }
 }
 
 static void test_status_pending_to_running_inj(FuelSchedule &schedule)
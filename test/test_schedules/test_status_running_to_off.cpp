@@ -12,7 +12,7 @@
 static void test_status_running_to_off(Schedule &schedule)
 {
     setSchedule(schedule, TIMEOUT, DURATION, true);
-    while( (schedule._status == PENDING) || (schedule._status == RUNNING) ) /*Wait*/ ;
+    while( (schedule._status == PENDING) || (schedule._status == RUNNING) ) { waitForTimerEvent(); }
     TEST_ASSERT_EQUAL(OFF, schedule._status);
 }
 
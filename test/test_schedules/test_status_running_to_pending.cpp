@@ -12,12 +12,13 @@
 static void test_status_running_to_pending(Schedule &schedule)
 {
     setSchedule(schedule, TIMEOUT, DURATION, true);
-    while(schedule._status == PENDING) /*Wait*/ ;
+    while(schedule._status == PENDING) { waitForTimerEvent(); }
     setSchedule(schedule, 2*TIMEOUT, DURATION, true);
-    TEST_ASSERT_EQUAL(RUNNING_WITHNEXT, schedule._status);
-    while(isRunning(schedule)) /*Wait*/ ;
+    TEST_ASSERT_EQUAL(RUNNING, schedule._status);
+    TEST_ASSERT_TRUE(schedule._hasNext);
+    while(isRunning(schedule)) { waitForTimerEvent(); }
     TEST_ASSERT_EQUAL(PENDING, schedule._status);
-    while(schedule._status != OFF) /*Wait*/ ;
+    while(schedule._status != OFF) { waitForTimerEvent(); }
 }
 
 static void test_status_running_to_pending_inj(FuelSchedule &schedule)
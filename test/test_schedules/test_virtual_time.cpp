@@ -0,0 +1,71 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "scheduler_ignition_controller.h"
+
+#if defined(NATIVE_VIRTUAL_TIME)
+
+static uint32_t start_time, end_time;
+static uint32_t sparkCount;
+static void startCallback(void) { start_time = micros(); }
+static void endCallback(void) { end_time = micros(); ++sparkCount; }
+
+static void test_virtual_time_delay(void)
+{
+    uint32_t start = micros();
+    delay(5U);
+    TEST_ASSERT_EQUAL_UINT32(5000U, micros()-start);
+    delayMicroseconds(3U);
+    TEST_ASSERT_EQUAL_UINT32(5003U, micros()-start);
+}
+
+static void test_virtual_time_exact_schedule(void)
+{
+    ignitionSchedule1.reset();
+    startIgnitionSchedulers();
+    setCallbacks(ignitionSchedule1, startCallback, endCallback);
+
+    uint32_t start = micros();
+    setSchedule(ignitionSchedule1, 1234U, 567U, true);
+    while (ignitionSchedule1._status!=OFF) { waitForTimerEvent(); }
+
+    // 1uS resolution: no jitter
+    TEST_ASSERT_EQUAL_UINT32(1234U, start_time-start);
+    TEST_ASSERT_EQUAL_UINT32(567U, end_time-start_time);
+    stopIgnitionSchedulers();
+}
+
+static void test_virtual_time_long_run(void)
+{
+    // Run across the 32-bit micros() wrap
+    advanceVirtualTime((uint32_t)(UINT32_MAX - micros()) - 500000UL);
+
+    ignitionSchedule1.reset();
+    startIgnitionSchedulers();
+    setCallbacks(ignitionSchedule1, startCallback, endCallback);
+    sparkCount = 0U;
+
+    // 6000RPM single cylinder for 2 minutes: 3ms dwell every 10ms
+    constexpr uint32_t CYCLES = 12000U;
+    for (uint32_t cycle=0U; cycle<CYCLES; ++cycle)
+    {
+        setSchedule(ignitionSchedule1, 7000U, 3000U, true);
+        advanceVirtualTime(10000U);
+        TEST_ASSERT_EQUAL_UINT32(3000U, end_time-start_time);
+    }
+    TEST_ASSERT_EQUAL_UINT32(CYCLES, sparkCount);
+    stopIgnitionSchedulers();
+}
+
+#endif
+
+void testVirtualTime(void)
+{
+#if defined(NATIVE_VIRTUAL_TIME)
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_virtual_time_delay);
+    RUN_TEST_P(test_virtual_time_exact_schedule);
+    RUN_TEST_P(test_virtual_time_long_run);
+  }
+#endif
+}
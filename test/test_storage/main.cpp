@@ -7,11 +7,15 @@ void runAllStorageTests(void)
     extern void testStorageApi(void);
     extern void test_storage(void);
     extern void test_update(void);
+    extern void testFlashLog(void);
+    extern void testPageSlots(void);
 
     test_layout();
     testStorageApi();
     test_storage();
     test_update();
+    testFlashLog();
+    testPageSlots();
 }
 
 TEST_HARNESS(runAllStorageTests)
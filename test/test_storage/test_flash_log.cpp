@@ -0,0 +1,203 @@
+#include <string.h>
+#include "../test_utils.h"
+#include "src/FlashLog/FlashLog.h"
+
+static constexpr uint16_t SECTOR_SIZE = 256U;
+static constexpr uint8_t SECTORS_PER_REGION = 4U;
+static constexpr uint8_t REGION_COUNT = 3U;
+static constexpr uint16_t FLASH_SIZE = SECTOR_SIZE*SECTORS_PER_REGION*REGION_COUNT;
+static constexpr uint16_t IMAGE_SIZE = 256U;
+
+// RAM backed NOR flash: erases to 0xFF, programming can only clear bits
+static uint8_t flash[FLASH_SIZE];
+static uint16_t eraseCounts[FLASH_SIZE/SECTOR_SIZE];
+static uint32_t programmedBytes;
+static uint32_t programBudget; // Bytes that can be programmed before "power loss"
+
+static bool fakeRead(uint32_t address, uint8_t *pBuffer, uint16_t length)
+{
+    memcpy(pBuffer, flash+address, length);
+    return true;
+}
+
+static bool fakeProgram(uint32_t address, const uint8_t *pBuffer, uint16_t length)
+{
+    for (uint16_t index=0U; index<length; ++index)
+    {
+        if (programBudget==0U) { return false; }
+        --programBudget;
+        ++programmedBytes;
+        flash[address+index] &= pBuffer[index];
+    }
+    return true;
+}
+
+static bool fakeErase(uint32_t address)
+{
+    uint32_t sector = address/SECTOR_SIZE;
+    memset(flash+(sector*SECTOR_SIZE), 0xFF, SECTOR_SIZE);
+    ++eraseCounts[sector];
+    return true;
+}
+
+static const flash_log_device_t fakeDevice = { fakeRead, fakeProgram, fakeErase, 0U, SECTOR_SIZE, SECTORS_PER_REGION, REGION_COUNT };
+
+static void resetFlash(void)
+{
+    memset(flash, 0xFF, sizeof(flash));
+    memset(eraseCounts, 0, sizeof(eraseCounts));
+    programmedBytes = 0U;
+    programBudget = UINT32_MAX;
+}
+
+static void test_flashlog_format_blank(void)
+{
+    resetFlash();
+    FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+    TEST_ASSERT_TRUE(log.begin());
+    TEST_ASSERT_EQUAL_UINT16(IMAGE_SIZE, log.length());
+    TEST_ASSERT_EQUAL_UINT8(0U, log.activeRegion());
+    TEST_ASSERT_EQUAL_UINT32(1U, log.generation());
+    TEST_ASSERT_EQUAL_UINT8(0xFFU, log.read(0U));
+    TEST_ASSERT_EQUAL_UINT8(0xFFU, log.read(IMAGE_SIZE-1U));
+}
+
+static void test_flashlog_commit_survives_remount(void)
+{
+    resetFlash();
+    {
+        FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+        (void)log.write(10U, 0x55U);
+        (void)log.write(11U, 0x66U);
+        (void)log.write(200U, 0x77U);
+        TEST_ASSERT_TRUE(log.isDirty());
+        TEST_ASSERT_TRUE(log.commit());
+        TEST_ASSERT_FALSE(log.isDirty());
+    }
+    FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+    TEST_ASSERT_EQUAL_UINT8(0x55U, log.read(10U));
+    TEST_ASSERT_EQUAL_UINT8(0x66U, log.read(11U));
+    TEST_ASSERT_EQUAL_UINT8(0x77U, log.read(200U));
+    TEST_ASSERT_EQUAL_UINT8(0xFFU, log.read(12U));
+}
+
+static void test_flashlog_uncommitted_lost(void)
+{
+    resetFlash();
+    {
+        FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+        (void)log.write(10U, 0x55U);
+        TEST_ASSERT_TRUE(log.commit());
+        (void)log.write(10U, 0x01U);
+        TEST_ASSERT_EQUAL_UINT8(0x01U, log.read(10U));
+    }
+    FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+    TEST_ASSERT_EQUAL_UINT8(0x55U, log.read(10U));
+}
+
+static void test_flashlog_unchanged_write_not_dirty(void)
+{
+    resetFlash();
+    FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+    (void)log.write(10U, 0x55U);
+    TEST_ASSERT_TRUE(log.commit());
+    uint32_t programmed = programmedBytes;
+    (void)log.update(10U, 0x55U);
+    TEST_ASSERT_FALSE(log.isDirty());
+    TEST_ASSERT_TRUE(log.commit());
+    TEST_ASSERT_EQUAL_UINT32(programmed, programmedBytes);
+}
+
+static void test_flashlog_torn_commit_is_atomic(void)
+{
+    resetFlash();
+    {
+        FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+        for (uint16_t address=0U; address<IMAGE_SIZE; ++address) { (void)log.write(address, 0x11U); }
+        TEST_ASSERT_TRUE(log.commit());
+
+        // A multi record transaction, interrupted by power loss part way through the 2nd record
+        for (uint16_t address=0U; address<(FLASH_LOG_MAX_RECORD_DATA*3U); ++address) { (void)log.write(address, 0x22U); }
+        programBudget = FLASH_LOG_MAX_RECORD_DATA + (FLASH_LOG_MAX_RECORD_DATA/2U);
+        TEST_ASSERT_FALSE(log.commit());
+    }
+    programBudget = UINT32_MAX;
+    uint32_t erases = eraseCounts[0]+eraseCounts[4]+eraseCounts[8];
+
+    FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+    for (uint16_t address=0U; address<IMAGE_SIZE; ++address)
+    {
+        TEST_ASSERT_EQUAL_UINT8(0x11U, log.read(address));
+    }
+    // The torn record forces a compaction into a new region
+    TEST_ASSERT_EQUAL_UINT8(1U, log.activeRegion());
+    TEST_ASSERT_EQUAL_UINT32(erases+1U, eraseCounts[0]+eraseCounts[4]+eraseCounts[8]);
+
+    // ...which is still usable
+    (void)log.write(5U, 0x33U);
+    TEST_ASSERT_TRUE(log.commit());
+    FlashLogAsEEPROM<IMAGE_SIZE> log2(fakeDevice);
+    TEST_ASSERT_EQUAL_UINT8(0x33U, log2.read(5U));
+    TEST_ASSERT_EQUAL_UINT8(0x11U, log2.read(6U));
+}
+
+static void test_flashlog_compaction_wear_levels(void)
+{
+    resetFlash();
+    {
+        FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+        for (uint16_t loop=0U; loop<600U; ++loop)
+        {
+            (void)log.write(loop%IMAGE_SIZE, (uint8_t)loop);
+            (void)log.write(IMAGE_SIZE-1U, (uint8_t)(loop/3U));
+            TEST_ASSERT_TRUE(log.commit());
+        }
+        TEST_ASSERT_GREATER_THAN_UINT32(REGION_COUNT*2U, log.generation());
+    }
+
+    FlashLogAsEEPROM<IMAGE_SIZE> log(fakeDevice);
+    for (uint16_t loop=600U-IMAGE_SIZE; loop<600U; ++loop)
+    {
+        if ((loop%IMAGE_SIZE)!=(IMAGE_SIZE-1U))
+        {
+            TEST_ASSERT_EQUAL_UINT8((uint8_t)loop, log.read(loop%IMAGE_SIZE));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)(599U/3U), log.read(IMAGE_SIZE-1U));
+
+    // Every region is erased equally (give or take one compaction)
+    uint16_t minErases = UINT16_MAX;
+    uint16_t maxErases = 0U;
+    for (uint8_t sector=0U; sector<_countof(eraseCounts); ++sector)
+    {
+        minErases = eraseCounts[sector]<minErases ? eraseCounts[sector] : minErases;
+        maxErases = eraseCounts[sector]>maxErases ? eraseCounts[sector] : maxErases;
+    }
+    TEST_ASSERT_GREATER_THAN_UINT16(0U, minErases);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(minErases+1U, maxErases);
+}
+
+static void test_flashlog_region_too_small(void)
+{
+    resetFlash();
+    FlashLogAsEEPROM<SECTOR_SIZE*SECTORS_PER_REGION> log(fakeDevice);
+    TEST_ASSERT_FALSE(log.begin());
+    // Still works as RAM, but nothing is saved
+    (void)log.write(0U, 0x12U);
+    TEST_ASSERT_EQUAL_UINT8(0x12U, log.read(0U));
+    TEST_ASSERT_FALSE(log.commit());
+    TEST_ASSERT_EQUAL_UINT32(0U, programmedBytes);
+}
+
+void testFlashLog(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST(test_flashlog_format_blank);
+        RUN_TEST(test_flashlog_commit_survives_remount);
+        RUN_TEST(test_flashlog_uncommitted_lost);
+        RUN_TEST(test_flashlog_unchanged_write_not_dirty);
+        RUN_TEST(test_flashlog_torn_commit_is_atomic);
+        RUN_TEST(test_flashlog_compaction_wear_levels);
+        RUN_TEST(test_flashlog_region_too_small);
+    }
+}
@@ -0,0 +1,168 @@
+#include <string.h>
+#include "../test_utils.h"
+#include "storage.h"
+#include "pages.h"
+#include "globals.h"
+
+extern uint16_t getEntityStartAddress(page_iterator_t entity);
+
+// A RAM backed storage device
+static byte ramStorage[8192];
+static uint16_t ramStorageLength;
+static uint16_t ramStorageBlockSize;
+static uint16_t ramStorageWrites;
+
+static byte ramRead(uint16_t address)
+{
+    return ramStorage[address];
+}
+
+static void ramWrite(uint16_t address, byte value)
+{
+    ramStorage[address] = value;
+    ++ramStorageWrites;
+}
+
+static uint16_t ramLength(void)
+{
+    return ramStorageLength;
+}
+
+static uint16_t ramGetMaxWriteBlockSize(const statuses&)
+{
+    return ramStorageBlockSize;
+}
+
+static void setRamStorage(uint16_t length, uint16_t blockSize)
+{
+    ramStorageLength = length;
+    ramStorageBlockSize = blockSize;
+    ramStorageWrites = 0U;
+    setStorageAPI({ .read = ramRead, .write = ramWrite, .length = ramLength, .getMaxWriteBlockSize = ramGetMaxWriteBlockSize });
+}
+
+static byte& page2Byte(uint16_t offset)
+{
+    return ((byte*)&configPage2)[offset];
+}
+
+// Format the storage & load the (empty) tune
+static void setupBlankStorage(uint16_t length)
+{
+    memset(ramStorage, 0xFF, sizeof(ramStorage));
+    setRamStorage(length, 8192U);
+    loadAllPages();
+}
+
+static void test_page_slots_burn_survives_reload(void)
+{
+    setupBlankStorage(sizeof(ramStorage));
+    page2Byte(5) = 0x12U;
+    savePage(veSetPage);
+    TEST_ASSERT_FALSE(isEepromWritePending());
+
+    page2Byte(5) = 0x34U;
+    savePage(veSetPage);
+    TEST_ASSERT_FALSE(isEepromWritePending());
+
+    page2Byte(5) = 0U;
+    loadAllPages();
+    TEST_ASSERT_EQUAL_UINT8(0x34U, page2Byte(5));
+}
+
+static void test_page_slots_torn_burn_keeps_previous(void)
+{
+    setupBlankStorage(sizeof(ramStorage));
+    memset(&configPage2, 0x11, sizeof(configPage2));
+    savePage(veSetPage);
+
+    // Start a burn, but "lose power" before the page is fully written
+    memset(&configPage2, 0x22, sizeof(configPage2));
+    setRamStorage(sizeof(ramStorage), 16U);
+    savePage(veSetPage);
+    TEST_ASSERT_TRUE(isEepromWritePending());
+
+    loadAllPages();
+    for (uint16_t offset=0U; offset<sizeof(configPage2); ++offset)
+    {
+        TEST_ASSERT_EQUAL_UINT8(0x11U, page2Byte(offset));
+    }
+}
+
+static void test_page_slots_unchanged_page_not_written(void)
+{
+    setupBlankStorage(sizeof(ramStorage));
+    page2Byte(5) = 0x56U;
+    savePage(veSetPage);
+    TEST_ASSERT_GREATER_THAN_UINT16(0U, ramStorageWrites);
+
+    ramStorageWrites = 0U;
+    savePage(veSetPage);
+    TEST_ASSERT_EQUAL_UINT16(0U, ramStorageWrites);
+    TEST_ASSERT_FALSE(isEepromWritePending());
+}
+
+static void test_page_slots_legacy_tune(void)
+{
+    // A tune saved without slots loads from the standard location
+    setupBlankStorage(4096U);
+    page2Byte(5) = 0x78U;
+    savePage(veSetPage);
+
+    setRamStorage(sizeof(ramStorage), 8192U);
+    page2Byte(5) = 0U;
+    loadAllPages();
+    TEST_ASSERT_EQUAL_UINT8(0x78U, page2Byte(5));
+
+    // The next burn creates a valid slot
+    page2Byte(6) = 0x9AU;
+    savePage(veSetPage);
+    page2Byte(5) = 0U;
+    page2Byte(6) = 0U;
+    loadAllPages();
+    TEST_ASSERT_EQUAL_UINT8(0x78U, page2Byte(5));
+    TEST_ASSERT_EQUAL_UINT8(0x9AU, page2Byte(6));
+}
+
+static void test_page_slots_standard_locations_replace_slot_b(void)
+{
+    // Slot B active
+    setupBlankStorage(sizeof(ramStorage));
+    page2Byte(5) = 0x11U;
+    savePage(veSetPage);
+    page2Byte(5) = 0x22U;
+    savePage(veSetPage);
+
+    // E.g. a tune update that moves data in storage directly
+    beginStandardPageLocations();
+    const uint16_t address = getEntityStartAddress(page_begin(veSetPage))+5U;
+    TEST_ASSERT_EQUAL_UINT8(0x22U, ramStorage[address]);
+    ramStorage[address] = 0x33U;
+    loadAllPages();
+    TEST_ASSERT_EQUAL_UINT8(0x33U, page2Byte(5));
+    endStandardPageLocations();
+    TEST_ASSERT_FALSE(isEepromWritePending());
+
+    page2Byte(5) = 0U;
+    loadAllPages();
+    TEST_ASSERT_EQUAL_UINT8(0x33U, page2Byte(5));
+
+    // Slots are back in use: the next burn goes to slot B & wins
+    page2Byte(5) = 0x44U;
+    savePage(veSetPage);
+    TEST_ASSERT_EQUAL_UINT8(0x33U, ramStorage[address]);
+    page2Byte(5) = 0U;
+    loadAllPages();
+    TEST_ASSERT_EQUAL_UINT8(0x44U, page2Byte(5));
+}
+
+void testPageSlots(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST(test_page_slots_burn_survives_reload);
+        RUN_TEST(test_page_slots_torn_burn_keeps_previous);
+        RUN_TEST(test_page_slots_unchanged_page_not_written);
+        RUN_TEST(test_page_slots_legacy_tune);
+        RUN_TEST(test_page_slots_standard_locations_replace_slot_b);
+    }
+}
@@ -19,6 +19,32 @@ static void test_saveAllPages(void)
     TEST_ASSERT_TRUE(isEepromWritePending());
 }
 
+static uint8_t commitCount;
+static void countCommit(void)
+{
+    ++commitCount;
+}
+
+static void test_savePage_commits_complete_page(void)
+{
+    storage_api_t api = getOneByteStorageApi(8192, 16, BUFFER_MARKER);
+    api.commit = countCommit;
+    setStorageAPI(api);
+    commitCount = 0U;
+
+    // Partial page: not committed
+    savePage(veSetPage);
+    TEST_ASSERT_TRUE(isEepromWritePending());
+    TEST_ASSERT_EQUAL_UINT8(0U, commitCount);
+
+    api = getOneByteStorageApi(8192, 8192, BUFFER_MARKER);
+    api.commit = countCommit;
+    setStorageAPI(api);
+    savePage(veSetPage);
+    TEST_ASSERT_FALSE(isEepromWritePending());
+    TEST_ASSERT_EQUAL_UINT8(1U, commitCount);
+}
+
 static void assert_entity(page_iterator_t iter, char expectedContent)
 {
     for (uint16_t offset=0; offset<iter.entity.size; ++offset)
@@ -103,6 +129,7 @@ static void test_saveAllCalibrationTables(void)
 void test_storage(void) {
     SET_UNITY_FILENAME() {     
         RUN_TEST_P(test_saveAllPages);
+        RUN_TEST_P(test_savePage_commits_complete_page);
         RUN_TEST_P(test_loadAllPages);
         RUN_TEST_P(test_loadAllCalibrationTables);
         RUN_TEST_P(test_saveAllCalibrationTables);
@@ -6,6 +6,8 @@
 #include "sensors.h"
 #include "updates.h"
 #include "pages.h"
+#include "globals.h"
+#include <string.h>
 
 extern void updateTableU16toU8(table2D_u16_u8_32 &targetTable, uint16_t u16EEpromBinAddress);
 extern void upgradeV25toV26(void);
@@ -95,6 +97,67 @@ static void test_upgradeV25toV26_negative(void)
     TEST_ASSERT_EQUAL(0, oneByteEeprom.writeCount);
 }
 
+// =========================== doUpdates ======================================
+
+// A RAM backed EEPROM, counting the writes to each address
+static byte updateStorage[4096];
+static uint8_t updateWriteCounts[4096];
+
+static byte updateStorageRead(uint16_t address) { return updateStorage[address]; }
+static void updateStorageWrite(uint16_t address, byte value)
+{
+    updateStorage[address] = value;
+    if (updateWriteCounts[address]<UINT8_MAX) { ++updateWriteCounts[address]; }
+}
+static uint16_t updateStorageLength(void) { return sizeof(updateStorage); }
+static uint16_t updateStorageBlockSize(const statuses&) { return sizeof(updateStorage); }
+
+static void fill_table_values(table3d_t *pTable, TableType key, table3d_value_t value)
+{
+    auto row_it = rows_begin(pTable, key);
+    while (!row_it.at_end())
+    {
+        auto row = *row_it;
+        while (!row.at_end()) { *row = value; ++row; }
+        ++row_it;
+    }
+}
+
+static void test_doUpdates_chains_tune_updates(void)
+{
+    // Create a V17 tune image
+    memset(updateStorage, 0, sizeof(updateStorage));
+    setStorageAPI({ .read = updateStorageRead, .write = updateStorageWrite, .length = updateStorageLength, .getMaxWriteBlockSize = updateStorageBlockSize });
+    fill_table_values(&vvtTable, vvtTable.type_key, 10);
+    configPage10.vvtCLholdDuty = 5U;
+    memset(configPage13.ignTrim, 3, sizeof(configPage13.ignTrim));
+    saveAllPages();
+    saveEEPROMVersion(17U);
+
+    // Boot the new firmware
+    memset(updateWriteCounts, 0, sizeof(updateWriteCounts));
+    loadAllPages();
+    doUpdates();
+
+    // The updated tune is in storage
+    TEST_ASSERT_EQUAL_UINT8(27U, loadEEPROMVersion());
+    fill_table_values(&vvtTable, vvtTable.type_key, 0);
+    configPage10.vvtCLholdDuty = 0U;
+    memset(configPage13.ignTrim, 1, sizeof(configPage13.ignTrim));
+    loadAllPages();
+    TEST_ASSERT_EQUAL(20, vvtTable.values.value_at(0));
+    TEST_ASSERT_EQUAL_UINT8(10U, configPage10.vvtCLholdDuty);
+    TEST_ASSERT_EACH_EQUAL_INT8(0, configPage13.ignTrim, _countof(configPage13.ignTrim));
+
+    // 10 versions, but the tune is only saved before & after the V25 calibration update (which
+    // reads storage directly) and at the end. Each save writes the version.
+    TEST_ASSERT_EQUAL_UINT8(3U, updateWriteCounts[0]);
+    for (uint16_t address=1U; address<sizeof(updateWriteCounts); ++address)
+    {
+        TEST_ASSERT_LESS_OR_EQUAL_UINT8(2U, updateWriteCounts[address]);
+    }
+}
+
 // =========================== multiplyTableLoad ==============================
 
 static void test_multiplyTableLoad_doubles_y_axis(void)
@@ -227,6 +290,7 @@ void test_update(void) {
         RUN_TEST(test_updateTableU16toU8); 
         RUN_TEST(test_upgradeV25toV26_positive);  
         RUN_TEST(test_upgradeV25toV26_negative); 
+        RUN_TEST(test_doUpdates_chains_tune_updates);
         RUN_TEST(test_multiplyTableLoad_doubles_y_axis);
         RUN_TEST(test_multiplyTableLoad_by_one_is_identity);
         RUN_TEST(test_multiplyDivideTableLoad_round_trip);
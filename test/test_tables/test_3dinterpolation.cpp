@@ -240,6 +240,43 @@ static void test_tableLookup_NoInterp(void)
   TEST_ASSERT_EQUAL(11U, tempVE);
 }
 
+// 3x3 tables. Lookups are in the bottom left bin: 2000-2500 RPM, 80-100 kPa
+static constexpr table3d_axis_t wideXAxis[] = { 3000U/100U, 2500U/100U, 2000U/100U };
+static constexpr table3d_axis_t wideYAxis[] = { 120U/2U, 100U/2U, 80U/2U };
+
+template <typename TValue>
+static TValue lookupBin(TValue tl, TValue tr, TValue bl, TValue br, uint16_t x, uint16_t y)
+{
+  // Values are in memory order. I.e. top row (Y max) first, X min to X max
+  const TValue values[] = { tr, tr, tr, 
+                            tl, tr, tr, 
+                            bl, br, br };
+  table3DValueCache<TValue> cache;
+  return get3DTableValue<100U, 2U>(&cache, 3U, values, wideXAxis, wideYAxis, { x, y });
+}
+
+static void test_tableLookup_16bit(void)
+{
+  // 0.1% resolution VE
+  TEST_ASSERT_EQUAL_UINT16(1004U, lookupBin<table3d_value16_t>(1005U, 1010U, 1000U, 1001U, 2250U, 90U));
+  TEST_ASSERT_EQUAL_UINT16(1005U, lookupBin<table3d_value16_t>(1005U, 1010U, 1000U, 1001U, 2000U, 100U));
+  TEST_ASSERT_EQUAL_UINT16(1001U, lookupBin<table3d_value16_t>(1005U, 1010U, 1000U, 1001U, 2500U, 80U));
+
+  // Values that would overflow 16-bit accumulation
+  TEST_ASSERT_EQUAL_UINT16(55000U, lookupBin<table3d_value16_t>(60000U, 60000U, 60000U, 40000U, 2250U, 90U));
+}
+
+static void test_tableLookup_signed16bit(void)
+{
+  // 0.1 degree resolution advance, no offset
+  TEST_ASSERT_EQUAL_INT16(-125, lookupBin<table3d_svalue16_t>(-100, -50, -200, -150, 2250U, 90U));
+  TEST_ASSERT_EQUAL_INT16(-200, lookupBin<table3d_svalue16_t>(-100, -50, -200, -150, 1000U, 20U));
+
+  // Crossing zero
+  TEST_ASSERT_EQUAL_INT16(-5, lookupBin<table3d_svalue16_t>(-20, 40, -20, 40, 2125U, 90U));
+  TEST_ASSERT_EQUAL_INT16(10, lookupBin<table3d_svalue16_t>(-20, 40, -20, 40, 2250U, 90U));
+}
+
 void testTables()
 {
   SET_UNITY_FILENAME() {
@@ -258,5 +295,7 @@ void testTables()
   RUN_TEST(test_bilinear_interpolation);
   RUN_TEST(test_all_incrementing);
   RUN_TEST(test_tableLookup_NoInterp);
+  RUN_TEST(test_tableLookup_16bit);
+  RUN_TEST(test_tableLookup_signed16bit);
   }  
 }
\ No newline at end of file
@@ -9,11 +9,15 @@ void runAllTests(void)
     extern void testOneMsInterval(void);
     extern void testTestMode(void);
     extern void testFlex(void);
+    extern void testFixedRateTask(void);
+    extern void testSoftPwm(void);
 
     testInit();
     testTacho();
     testOneMsInterval();
     testFlex();
+    testFixedRateTask();
+    testSoftPwm();
 }
 
 TEST_HARNESS(runAllTests)
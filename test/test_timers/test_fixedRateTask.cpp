@@ -0,0 +1,118 @@
+#include "../test_utils.h"
+#include "polling.hpp"
+#include "static_for.hpp"
+
+static uint8_t taskRunCount;
+static void countTaskRun(void)
+{
+  ++taskRunCount;
+}
+
+static void test_fixedRateTask_notDue(void)
+{
+  taskRunCount = 0U;
+  fixedRateTask_t task = { countTaskRun, 100U, 1000U, true };
+
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 999U));
+  TEST_ASSERT_EQUAL_UINT8(0U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT16(1000U, task.nextDueMs);
+}
+
+static void test_fixedRateTask_keepsPhase(void)
+{
+  taskRunCount = 0U;
+  fixedRateTask_t task = { countTaskRun, 100U, 1000U, true };
+
+  // Running late (but within one period) must not shift the next deadline
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 1037U));
+  TEST_ASSERT_EQUAL_UINT8(1U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT16(1100U, task.nextDueMs);
+
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 1099U));
+  TEST_ASSERT_EQUAL_UINT8(1U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 1100U));
+  TEST_ASSERT_EQUAL_UINT8(2U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT16(1200U, task.nextDueMs);
+}
+
+static void test_fixedRateTask_missedDeadlines(void)
+{
+  taskRunCount = 0U;
+  fixedRateTask_t task = { countTaskRun, 100U, 1000U, true };
+
+  // 2.5 periods late: 2 deadlines missed completely, task runs once & re-syncs
+  TEST_ASSERT_EQUAL_UINT8(2U, executeFixedRateTask(task, 1250U));
+  TEST_ASSERT_EQUAL_UINT8(1U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT16(1350U, task.nextDueMs);
+}
+
+static void test_fixedRateTask_rollover(void)
+{
+  taskRunCount = 0U;
+  fixedRateTask_t task = { countTaskRun, 100U, 65500U, true };
+
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 65499U));
+  TEST_ASSERT_EQUAL_UINT8(0U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 10U));
+  TEST_ASSERT_EQUAL_UINT8(1U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT16(64U, task.nextDueMs);
+}
+
+static void test_fixedRateTask_firstCallSeedsDeadline(void)
+{
+  taskRunCount = 0U;
+  fixedRateTask_t task = { countTaskRun, 100U, 0U, false };
+
+  // The time before the task started isn't a missed deadline
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 1250U));
+  TEST_ASSERT_EQUAL_UINT8(1U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT16(1350U, task.nextDueMs);
+
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 1349U));
+  TEST_ASSERT_EQUAL_UINT8(1U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 1350U));
+  TEST_ASSERT_EQUAL_UINT8(2U, taskRunCount);
+}
+
+static void test_fixedRateTask_firstCallAfter32768ms(void)
+{
+  taskRunCount = 0U;
+  fixedRateTask_t task = { countTaskRun, 100U, 0U, false };
+
+  // More than half the 16-bit range from the initial deadline: mustn't look like a future deadline
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 40000U));
+  TEST_ASSERT_EQUAL_UINT8(1U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT16(40100U, task.nextDueMs);
+
+  TEST_ASSERT_EQUAL_UINT8(0U, executeFixedRateTask(task, 40100U));
+  TEST_ASSERT_EQUAL_UINT8(2U, taskRunCount);
+}
+
+static void test_fixedRateTask_array_saturatesMisses(void)
+{
+  taskRunCount = 0U;
+  fixedRateTask_t tasks[] = {
+    { countTaskRun, 1U, 0U, true },
+    { countTaskRun, 100U, 0U, true },
+  };
+  uint8_t missed = 250U;
+
+  static_for<0, _countof(tasks)>::repeat_n(executeFixedRateArrayTask, tasks, (uint16_t)150U, &missed);
+  TEST_ASSERT_EQUAL_UINT8(2U, taskRunCount);
+  TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, missed);
+  TEST_ASSERT_EQUAL_UINT16(151U, tasks[0].nextDueMs);
+  TEST_ASSERT_EQUAL_UINT16(250U, tasks[1].nextDueMs);
+}
+
+void testFixedRateTask(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST(test_fixedRateTask_notDue);
+    RUN_TEST(test_fixedRateTask_keepsPhase);
+    RUN_TEST(test_fixedRateTask_missedDeadlines);
+    RUN_TEST(test_fixedRateTask_rollover);
+    RUN_TEST(test_fixedRateTask_firstCallSeedsDeadline);
+    RUN_TEST(test_fixedRateTask_firstCallAfter32768ms);
+    RUN_TEST(test_fixedRateTask_array_saturatesMisses);
+  }
+}
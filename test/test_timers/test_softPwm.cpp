@@ -0,0 +1,234 @@
+#include "../test_utils.h"
+#include "softPwm.h"
+
+struct pwm_edge_t {
+  uint8_t channel;
+  bool isActive;
+  uint16_t time;
+};
+
+static constexpr uint8_t MAX_EDGES = 64U;
+static pwm_edge_t edges[MAX_EDGES];
+static uint8_t edgeCount;
+static uint16_t simTime;
+static uint16_t duties[SOFT_PWM_MAX_CHANNELS];
+
+static void recordEdge(uint8_t channel, bool isActive)
+{
+  if (edgeCount<MAX_EDGES)
+  {
+    edges[edgeCount] = { channel, isActive, simTime };
+    ++edgeCount;
+  }
+}
+
+template <uint8_t channel>
+static void onActive(void) { recordEdge(channel, true); }
+template <uint8_t channel>
+static void onInactive(void) { recordEdge(channel, false); }
+template <uint8_t channel>
+static uint16_t getDuty(void) { return duties[channel]; }
+
+template <uint8_t channel>
+static void configureTestChannel(softPwmEngine_t &engine, uint16_t period, uint16_t duty)
+{
+  duties[channel] = duty;
+  softPwmConfigure(engine, channel, { onActive<channel>, onInactive<channel>, getDuty<channel> }, period);
+}
+
+static void resetEdges(void)
+{
+  edgeCount = 0U;
+}
+
+// Run the engine as the compare ISR would, until the given time
+static void simulateUntil(softPwmEngine_t &engine, uint16_t start, uint16_t end)
+{
+  simTime = start;
+  uint16_t compare = start;
+  while ((int16_t)(end - compare) >= 0)
+  {
+    simTime = compare;
+    if (!softPwmService(engine, simTime, compare)) { break; }
+  }
+  simTime = end;
+}
+
+static void assertEdge(uint8_t index, uint8_t channel, bool isActive, uint16_t time)
+{
+  TEST_ASSERT_LESS_THAN_UINT8(edgeCount, index);
+  TEST_ASSERT_EQUAL_UINT8(channel, edges[index].channel);
+  TEST_ASSERT_EQUAL(isActive, edges[index].isActive);
+  TEST_ASSERT_EQUAL_UINT16(time, edges[index].time);
+}
+
+static void test_softPwm_single_channel(void)
+{
+  softPwmEngine_t engine;
+  softPwmInit(engine);
+  configureTestChannel<0>(engine, 100U, 25U);
+  resetEdges();
+
+  TEST_ASSERT_TRUE(softPwmEnable(engine, 0U, 1000U));
+  TEST_ASSERT_FALSE(softPwmEnable(engine, 0U, 1000U));
+  simulateUntil(engine, 1000U, 1199U);
+
+  TEST_ASSERT_EQUAL_UINT8(4U, edgeCount);
+  assertEdge(0U, 0U, true, 1000U);
+  assertEdge(1U, 0U, false, 1025U);
+  assertEdge(2U, 0U, true, 1100U);
+  assertEdge(3U, 0U, false, 1125U);
+}
+
+static void test_softPwm_duty_latched_per_period(void)
+{
+  softPwmEngine_t engine;
+  softPwmInit(engine);
+  configureTestChannel<0>(engine, 100U, 40U);
+  resetEdges();
+
+  softPwmEnable(engine, 0U, 0U);
+  simulateUntil(engine, 0U, 10U);
+  // Changing the duty mid pulse must not truncate the current pulse
+  duties[0] = 10U;
+  simulateUntil(engine, 10U, 199U);
+
+  TEST_ASSERT_EQUAL_UINT8(4U, edgeCount);
+  assertEdge(0U, 0U, true, 0U);
+  assertEdge(1U, 0U, false, 40U);
+  assertEdge(2U, 0U, true, 100U);
+  assertEdge(3U, 0U, false, 110U);
+}
+
+static void test_softPwm_zero_and_full_duty(void)
+{
+  softPwmEngine_t engine;
+  softPwmInit(engine);
+  configureTestChannel<0>(engine, 100U, 0U);
+  configureTestChannel<1>(engine, 100U, 150U); // Over 100% is clamped
+  resetEdges();
+
+  softPwmEnable(engine, 0U, 0U);
+  softPwmEnable(engine, 1U, 0U);
+  simulateUntil(engine, 0U, 250U);
+
+  // One refresh of the output level per period, no toggling
+  for (uint8_t index=0U; index<edgeCount; ++index)
+  {
+    TEST_ASSERT_EQUAL(edges[index].channel==1U, edges[index].isActive);
+    TEST_ASSERT_EQUAL_UINT16(0U, edges[index].time % 100U);
+  }
+  TEST_ASSERT_EQUAL_UINT8(6U, edgeCount);
+}
+
+static void test_softPwm_multi_channel_ordering(void)
+{
+  softPwmEngine_t engine;
+  softPwmInit(engine);
+  configureTestChannel<0>(engine, 100U, 30U);
+  configureTestChannel<1>(engine, 60U, 45U);
+  configureTestChannel<2>(engine, 250U, 5U);
+  resetEdges();
+
+  softPwmEnable(engine, 0U, 0U);
+  softPwmEnable(engine, 1U, 10U);
+  softPwmEnable(engine, 2U, 20U);
+  simulateUntil(engine, 0U, 1000U);
+
+  // Edges are serviced in time order, and every edge is on schedule
+  // (give or take the minimum lead time)
+  uint16_t expectedNext[3] = { 0U, 10U, 20U };
+  bool expectedActive[3] = { true, true, true };
+  static constexpr uint16_t periods[3] = { 100U, 60U, 250U };
+  TEST_ASSERT_GREATER_THAN_UINT8(40U, edgeCount);
+  for (uint8_t index=0U; index<edgeCount; ++index)
+  {
+    if (index>0U) { TEST_ASSERT_TRUE(edges[index].time>=edges[index-1U].time); }
+    const pwm_edge_t &edge = edges[index];
+    TEST_ASSERT_EQUAL(expectedActive[edge.channel], edge.isActive);
+    TEST_ASSERT_UINT16_WITHIN(SOFT_PWM_MIN_LEAD_TICKS, expectedNext[edge.channel], edge.time);
+    TEST_ASSERT_TRUE(edge.time<=expectedNext[edge.channel]);
+    expectedNext[edge.channel] += edge.isActive ? duties[edge.channel] : (uint16_t)(periods[edge.channel]-duties[edge.channel]);
+    expectedActive[edge.channel] = !edge.isActive;
+  }
+}
+
+static void test_softPwm_timer_rollover(void)
+{
+  softPwmEngine_t engine;
+  softPwmInit(engine);
+  configureTestChannel<0>(engine, 100U, 50U);
+  configureTestChannel<1>(engine, 100U, 75U);
+  resetEdges();
+
+  softPwmEnable(engine, 0U, 65500U);
+  softPwmEnable(engine, 1U, 65530U);
+  simulateUntil(engine, 65500U, 70U);
+
+  TEST_ASSERT_EQUAL_UINT8(5U, edgeCount);
+  assertEdge(0U, 0U, true, 65500U);
+  assertEdge(1U, 1U, true, 65530U);
+  assertEdge(2U, 0U, false, 65550U);
+  assertEdge(3U, 0U, true, 64U);  // 65500+100 wraps to 64
+  assertEdge(4U, 1U, false, 69U); // 65530+75 wraps to 69
+}
+
+static void test_softPwm_bounded_service(void)
+{
+  softPwmEngine_t engine;
+  softPwmInit(engine);
+  configureTestChannel<0>(engine, 100U, 1U);
+  configureTestChannel<1>(engine, 100U, 1U);
+  configureTestChannel<2>(engine, 100U, 1U);
+  resetEdges();
+
+  softPwmEnable(engine, 0U, 0U);
+  softPwmEnable(engine, 1U, 0U);
+  softPwmEnable(engine, 2U, 0U);
+
+  // Massively late: every channel has many overdue edges, but one
+  // service call may only handle 2 per channel
+  uint16_t compare = 0U;
+  simTime = 1000U;
+  TEST_ASSERT_TRUE(softPwmService(engine, simTime, compare));
+  TEST_ASSERT_EQUAL_UINT8(6U, edgeCount);
+  TEST_ASSERT_EQUAL_UINT16(1000U + SOFT_PWM_MIN_LEAD_TICKS, compare);
+}
+
+static void test_softPwm_disable(void)
+{
+  softPwmEngine_t engine;
+  softPwmInit(engine);
+  configureTestChannel<0>(engine, 100U, 50U);
+  configureTestChannel<1>(engine, 200U, 50U);
+  resetEdges();
+
+  softPwmEnable(engine, 0U, 0U);
+  softPwmEnable(engine, 1U, 0U);
+  simulateUntil(engine, 0U, 10U);
+  softPwmDisable(engine, 0U);
+  simulateUntil(engine, 10U, 300U);
+
+  for (uint8_t index=2U; index<edgeCount; ++index)
+  {
+    TEST_ASSERT_EQUAL_UINT8(1U, edges[index].channel);
+  }
+
+  softPwmDisable(engine, 1U);
+  uint16_t compare = 1234U;
+  TEST_ASSERT_FALSE(softPwmService(engine, 400U, compare));
+  TEST_ASSERT_EQUAL_UINT16(1234U, compare);
+}
+
+void testSoftPwm(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST(test_softPwm_single_channel);
+    RUN_TEST(test_softPwm_duty_latched_per_period);
+    RUN_TEST(test_softPwm_zero_and_full_duty);
+    RUN_TEST(test_softPwm_multi_channel_ordering);
+    RUN_TEST(test_softPwm_timer_rollover);
+    RUN_TEST(test_softPwm_bounded_service);
+    RUN_TEST(test_softPwm_disable);
+  }
+}
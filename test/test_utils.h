@@ -7,6 +7,9 @@
 #include "table2d.h"
 #include "maths.h"
 #include "file_name_guard_t.h"
+#if defined(NATIVE_VIRTUAL_TIME)
+#include "../lib/ArduinoFake/SoftwareTimer.h"
+#endif
 
 template<size_t MAX_LEN, size_t N>
 constexpr void STR_LEN_CHECK(char const (&)[N]) 
@@ -58,6 +61,17 @@ for ( struct { unity_filename_guard_t a; uint8_t b; } guard = { .a = unity_filen
 
 // ============================ end SET_UNITY_FILENAME ============================ 
 
+/** @brief Call from a busy wait loop that is waiting on a timer interrupt
+ * 
+ * In virtual time, time only moves when it is advanced: so jump to the next timer event.
+ */
+static inline void waitForTimerEvent(void)
+{
+#if defined(NATIVE_VIRTUAL_TIME)
+  (void)runNextTimerEvent();
+#endif
+}
+
 // Store test data in flash, if feasible.
 #if defined(PROGMEM)
 #define TEST_DATA_P static constexpr PROGMEM
@@ -373,6 +373,29 @@ static void test_vvtControl_closed_loop_nohold_noangle_error(void)
   TEST_ASSERT_TRUE(!testVvt2Enabled || (currentStatus.vvt2AngleError==currentStatus.vvt2AngleError));
 }
 
+static void test_vvtControl_closed_loop_computes_every_call(void)
+{
+  setup_vvt_closedloop_tune();
+  configPage6.vvtCLUseHold = false;
+  initialiseAuxPWM();
+
+  setup_vvt_onconditions();
+  currentStatus.vvt1Angle = configPage10.vvtCLMinAng + 1;
+  currentStatus.vvt1TargetAngle = currentStatus.vvt1Angle + 5U;
+  mirror_vvt2_conditions();
+
+  // vvtControl() is a fixed rate task, so the PID computes on every call no matter how little time has passed.
+  // A zero duty is only replaced when the PID computes
+  for (uint8_t call = 0U; call < 3U; ++call)
+  {
+    currentStatus.vvt1Duty = 0U;
+    currentStatus.vvt2Duty = 0U;
+    vvtControl();
+    TEST_ASSERT_NOT_EQUAL_UINT8(0U, currentStatus.vvt1Duty);
+    assert_vvt2_duty(currentStatus.vvt1Duty);
+  }
+}
+
 void testVvtControl(void)
 {
   SET_UNITY_FILENAME()
@@ -401,6 +424,7 @@ void testVvtControl(void)
                 RUN_TEST_P(test_vvtControl_closed_loop_hold_sets_hold_duty);
                 RUN_TEST_P(test_vvtControl_closed_loop_angle_error_sets_error);
                 RUN_TEST_P(test_vvtControl_closed_loop_nohold_noangle_error);
+                RUN_TEST_P(test_vvtControl_closed_loop_computes_every_call);
             }
         }
     }
@@ -3,6 +3,7 @@
 #include "auxiliaries.h"
 #include "units.h"
 #include "src/pins/boardOutputPin.h"
+#include "softPwm.h"
 
 // External declarations for testing VVT PWM interrupt handler
 extern long vvt1_pwm_value;
@@ -16,6 +17,7 @@ extern volatile bool vvt2_max_pwm;
 extern uint16_t vvt_pwm_max_count;
 extern boardOutputPin_t vvt1_pin;
 extern boardOutputPin_t vvt2_pin;
+extern bool isVvtPwmActiveLow(void);
 
 // ========================= Setup and Helpers =========================
 
@@ -621,6 +623,24 @@ static void test_vvt_vvt1_only_to_vvt2_only(void)
 
 // ========================= Main Test Runner =========================
 
+// ========================= Test: Hardware PWM matches the interrupt =========================
+
+static void test_vvt_hardware_pwm_matches_interrupt(void)
+{
+    setup_vvt_interrupt_base();
+    vvt1_pwm_value = 250;
+
+    // One period of the interrupt: the duty, then the rest of the period
+    vvtInterrupt();
+    uint32_t highTicks = getVvt1PinState() ? 250U : 0U;
+    vvtInterrupt();
+    highTicks += getVvt1PinState() ? 750U : 0U;
+
+    // Hardware PWM is high for the same part of the period
+    constexpr uint8_t RESOLUTION = 15U;
+    TEST_ASSERT_EQUAL_UINT32((highTicks << RESOLUTION) / 1000U, getAuxPwmHardwareDuty(250U, 1000U, RESOLUTION, isVvtPwmActiveLow()));
+}
+
 void testVvtInterrupt(void)
 {
   SET_UNITY_FILENAME()
@@ -649,5 +669,6 @@ void testVvtInterrupt(void)
     RUN_TEST_P(test_vvt_state_machine_vvt2_shorter);
     RUN_TEST_P(test_vvt_state_machine_vvt1_shorter);
     RUN_TEST_P(test_vvt_vvt1_only_to_vvt2_only);
+    RUN_TEST_P(test_vvt_hardware_pwm_matches_interrupt);
   }
 }
\ No newline at end of file